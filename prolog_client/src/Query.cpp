@@ -20,6 +20,8 @@
 
 #include <boost/lexical_cast.hpp>
 
+#include <ros/duration.h>
+
 #include <prolog_msgs/CloseQuery.h>
 #include <prolog_msgs/GetAllSolutions.h>
 #include <prolog_msgs/GetNextSolution.h>
@@ -27,6 +29,7 @@
 #include <prolog_msgs/OpenQuery.h>
 
 #include <prolog_common/Bindings.h>
+#include <prolog_common/TermArena.h>
 
 #include <prolog_serialization/JSONDeserializer.h>
 #include <prolog_serialization/JSONSerializer.h>
@@ -193,9 +196,13 @@ Solution Query::Impl::getNextSolution(bool close) {
   request.id = identifier_;
   request.close = close;
   
-  if (!client_.impl_->getNextSolutionClient_.call(request, response))
-    throw ServiceCallFailed(client_.impl_->getNextSolutionClient_.
-      getService());
+  do {
+    if (!client_.impl_->getNextSolutionClient_.call(request, response))
+      throw ServiceCallFailed(client_.impl_->getNextSolutionClient_.
+        getService());
+  }
+  while ((response.status == prolog_msgs::GetNextSolution::Response::
+    STATUS_PENDING) && ros::Duration(0.01).sleep());
   
   if (response.status != prolog_msgs::GetNextSolution::Response::STATUS_OK) {
     if (response.status == prolog_msgs::GetNextSolution::Response::
@@ -244,9 +251,13 @@ std::list<Solution> Query::Impl::getAllSolutions() {
   
   request.id = identifier_;
   
-  if (!client_.impl_->getAllSolutionsClient_.call(request, response))
-    throw ServiceCallFailed(client_.impl_->getAllSolutionsClient_.
-      getService());
+  do {
+    if (!client_.impl_->getAllSolutionsClient_.call(request, response))
+      throw ServiceCallFailed(client_.impl_->getAllSolutionsClient_.
+        getService());
+  }
+  while ((response.status == prolog_msgs::GetAllSolutions::Response::
+    STATUS_PENDING) && ros::Duration(0.01).sleep());
   
   if (response.status != prolog_msgs::GetAllSolutions::Response::STATUS_OK) {
     if (response.status == prolog_msgs::GetAllSolutions::Response::
@@ -267,14 +278,16 @@ std::list<Solution> Query::Impl::getAllSolutions() {
   
   if (response.status != prolog_msgs::GetAllSolutions::Response::
       STATUS_NO_SOLUTIONS) {
+    serialization::JSONDeserializer deserializer;
+    TermArena arena;
+    
     for (size_t index = 0; index < response.solutions.size(); ++index) {
       std::istringstream stream(response.solutions[index]);
-      serialization::JSONDeserializer deserializer;
     
       Solution solution;
       
       try {
-        solution = deserializer.deserializeBindings(stream);
+        solution = deserializer.deserializeBindings(stream, arena);
       }
       catch (const ros::Exception& exception) {
         throw DeserializationFailed(exception.what());
@@ -299,8 +312,13 @@ bool Query::Impl::hasSolution() {
   
   request.id = identifier_;
   
-  if (!client_.impl_->hasSolutionClient_.call(request, response))
-    throw ServiceCallFailed(client_.impl_->hasSolutionClient_.getService());
+  do {
+    if (!client_.impl_->hasSolutionClient_.call(request, response))
+      throw ServiceCallFailed(client_.impl_->hasSolutionClient_.
+        getService());
+  }
+  while ((response.status == prolog_msgs::HasSolution::Response::
+    STATUS_PENDING) && ros::Duration(0.01).sleep());
   
   if (response.status != prolog_msgs::HasSolution::Response::STATUS_OK) {
     if (response.status == prolog_msgs::HasSolution::Response::
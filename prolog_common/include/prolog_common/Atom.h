@@ -23,10 +23,15 @@
 #ifndef ROS_PROLOG_ATOM_H
 #define ROS_PROLOG_ATOM_H
 
+#include <prolog_common/Symbol.h>
 #include <prolog_common/Term.h>
 
 namespace prolog {
   /** \brief Prolog atom
+    * 
+    * The name of an atom is interned in the Prolog symbol table and
+    * never released. Free-form text should therefore be held in a
+    * prolog::String.
     */
   class Atom :
     public Term {
@@ -39,6 +44,11 @@ namespace prolog {
     /** \brief Constructor (overloaded version taking a string name)
       */
     Atom(const std::string& name);
+    
+    /** \brief Constructor (overloaded version taking an interned
+      *   symbol)
+      */
+    Atom(const Symbol& symbol);
       
     /** \brief Copy constructor
       */
@@ -50,25 +60,15 @@ namespace prolog {
     
     /** \brief Destructor
       */
-    virtual ~Atom();
+    ~Atom();
     
     /** \brief Retrieve the name of this Prolog atom
       */
-    std::string getName() const;
+    const std::string& getName() const;
     
-  protected:
-    friend class Term;
-    
-    /** \brief Prolog atom (implementation)
+    /** \brief Retrieve the interned symbol of this Prolog atom
       */
-    class Impl :
-      public Term::Impl {
-    public:
-      Impl(const std::string& name);
-      virtual ~Impl();
-      
-      std::string name_;
-    };
+    Symbol getSymbol() const;
   };
 };
 
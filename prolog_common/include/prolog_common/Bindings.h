@@ -23,31 +23,120 @@
 #ifndef ROS_PROLOG_BINDINGS_H
 #define ROS_PROLOG_BINDINGS_H
 
+#include <functional>
 #include <string>
+#include <utility>
+#include <vector>
 
-#include <boost/unordered_map.hpp>
+#include <boost/iterator/iterator_facade.hpp>
 #include <boost/shared_ptr.hpp>
 
+#include <prolog_common/BindingsSchema.h>
+#include <prolog_common/Symbol.h>
 #include <prolog_common/Term.h>
+#include <prolog_common/TermArena.h>
 
 namespace prolog {
   /** \brief Prolog bindings
+    * 
+    * The Prolog bindings map the interned symbols of variable names
+    * to their bound terms. The terms are stored in a flat array of
+    * slots which is indexed through a Prolog bindings schema, usually
+    * shared among all solutions of a query. Bindings may be built into
+    * a Prolog term
+    * arena, in which case they keep the arena alive and all their
+    * terms are released in one shot.
+    * 
+    * Prolog bindings compare structurally, irrespective of the order
+    * and the arena backing of their terms.
+    * 
+    * Bindings constructed from a materializer are lazy: their terms are
+    * only built when they are first accessed, and terms which are never
+    * accessed are never built. Since materialization mutates the shared
+    * implementation, lazy bindings must not be accessed concurrently.
     */
   class Bindings {
+  protected:
+    class Impl;
+    
   public:
-    /** \brief Definition of the Prolog bindings iterator type
+    /** \brief Prolog bindings materializer
+      * 
+      * The materializer is the abstract source of the terms of lazy
+      * Prolog bindings. It is kept alive by all bindings sharing it.
       */
-    typedef boost::unordered_map<std::string, Term>::iterator Iterator;
+    class Materializer {
+    public:
+      /** \brief Destructor
+        */
+      virtual ~Materializer();
+      
+      /** \brief True, if a slot of the bindings schema is bound by
+        *   this Prolog bindings materializer
+        */
+      virtual bool isBound(size_t slot) const = 0;
+      
+      /** \brief Materialize the term bound to a slot of the bindings
+        *   schema
+        */
+      virtual Term materialize(size_t slot) const = 0;
+    };
     
-    /** \brief Definition of the Prolog bindings const-iterator type
+    /** \brief Prolog bindings const-iterator
+      * 
+      * The const-iterator visits the bound slots of the bindings in slot
+      * order and dereferences to a pair of the symbol and the term.
       */
-    typedef boost::unordered_map<std::string, Term>::const_iterator
-      ConstIterator;
+    class ConstIterator :
+      public boost::iterator_facade<ConstIterator, const std::pair<Symbol,
+        Term>, boost::forward_traversal_tag, std::pair<const Symbol&,
+        const Term&> > {
+    public:
+      /** \brief Default constructor
+        */
+      ConstIterator();
+      
+    protected:
+      friend class boost::iterator_core_access;
+      friend class Bindings;
+      
+      ConstIterator(const Impl* impl, size_t slot);
+      
+      void increment();
+      bool equal(const ConstIterator& iterator) const;
+      std::pair<const Symbol&, const Term&> dereference() const;
+      
+      const Impl* impl_;
+      size_t slot_;
+    };
     
     /** \brief Default constructor
       */
     Bindings();
     
+    /** \brief Constructor (overloaded version taking a Prolog term arena
+      *   which backs the terms of these bindings)
+      */
+    Bindings(const TermArena& arena);
+    
+    /** \brief Constructor (overloaded version taking a Prolog bindings
+      *   schema)
+      */
+    Bindings(const BindingsSchema& schema);
+    
+    /** \brief Constructor (overloaded version taking a Prolog bindings
+      *   schema and a Prolog term arena which backs the terms of these
+      *   bindings)
+      */
+    Bindings(const BindingsSchema& schema, const TermArena& arena);
+    
+    /** \brief Constructor (overloaded version taking a Prolog bindings
+      *   schema and a materializer which lazily provides the terms of
+      *   these bindings)
+      */
+    Bindings(const BindingsSchema& schema, const boost::shared_ptr<const
+      Materializer>& materializer);
+    
     /** \brief Copy constructor
       */
     Bindings(const Bindings& src);
@@ -60,35 +149,82 @@ namespace prolog {
       */
     Term getTerm(const std::string& name) const;
     
+    /** \brief Retrieve a term of these Prolog bindings (overloaded
+      *   version taking an interned symbol)
+      */
+    Term getTerm(const Symbol& name) const;
+    
+    /** \brief Retrieve a term of these Prolog bindings (overloaded
+      *   version taking a slot of the bindings schema)
+      */
+    Term getTerm(size_t slot) const;
+    
+    /** \brief Retrieve the schema of these Prolog bindings
+      */
+    const BindingsSchema& getSchema() const;
+    
+    /** \brief Retrieve the number of terms of these Prolog bindings
+      */
+    size_t getNumTerms() const;
+    
     /** \brief True, if these Prolog bindings contain a given term
       */
     bool contain(const std::string& name) const;
     
+    /** \brief True, if these Prolog bindings contain a given term
+      *   (overloaded version taking an interned symbol)
+      */
+    bool contain(const Symbol& name) const;
+    
+    /** \brief True, if the terms of these Prolog bindings are backed
+      *   by a Prolog term arena
+      */
+    bool isArenaBacked() const;
+    
+    /** \brief True, if some terms of these Prolog bindings are yet to be
+      *   materialized
+      */
+    bool areLazy() const;
+    
     /** \brief True, if these Prolog bindings are empty
       */
     bool areEmpty() const;
     
-    /** \brief Retrieve the begin iterator of these Prolog bindings
-      */ 
-    boost::unordered_map<std::string, Term>::iterator begin();
+    /** \brief Retrieve the structural hash value of these Prolog
+      *   bindings
+      */
+    size_t getHash() const;
     
     /** \brief Retrieve the begin const-iterator of these Prolog bindings
       */ 
-    boost::unordered_map<std::string, Term>::const_iterator begin() const;
+    ConstIterator begin() const;
 
-    /** \brief Retrieve the end iterator of these Prolog bindings
-      */ 
-    boost::unordered_map<std::string, Term>::iterator end();
-    
     /** \brief Retrieve the end const-iterator of these Prolog bindings
       */ 
-    boost::unordered_map<std::string, Term>::const_iterator end() const;
+    ConstIterator end() const;
 
     /** \brief Add a term to these Prolog bindings
       */
     void addTerm(const std::string& name, const Term& term);
     
+    /** \brief Add a term to these Prolog bindings (overloaded version
+      *   taking an interned symbol)
+      */
+    void addTerm(const Symbol& name, const Term& term);
+    
+    /** \brief Set the term of a slot of these Prolog bindings
+      */
+    void setTerm(size_t slot, const Term& term);
+    
+    /** \brief Set the term of a slot of these Prolog bindings
+      *   (overloaded version moving from the term)
+      */
+    void setTerm(size_t slot, Term&& term);
+    
     /** \brief Clear these Prolog bindings
+      * 
+      * The terms of these bindings are removed, but their schema is
+      * retained.
       */
     void clear();
     
@@ -96,21 +232,58 @@ namespace prolog {
       */
     Term operator[](const std::string& name) const;
     
-  private:
+    /** \brief Binary operator for comparing these Prolog bindings with
+      *   other Prolog bindings for structural equality
+      */
+    bool operator==(const Bindings& bindings) const;
+    
+    /** \brief Binary operator for comparing these Prolog bindings with
+      *   other Prolog bindings for structural inequality
+      */
+    bool operator!=(const Bindings& bindings) const;
+    
+  protected:
     /** \brief Prolog bindings (implementation)
       */
     class Impl {
     public:
-      Impl();
+      Impl(const BindingsSchema& schema = BindingsSchema());
+      Impl(const BindingsSchema& schema, const TermArena& arena);
+      Impl(const BindingsSchema& schema, const boost::shared_ptr<const
+        Materializer>& materializer);
       ~Impl();
       
-      boost::unordered_map<std::string, Term> terms_;
+      bool isBound(size_t slot) const;
+      const Term& getTerm(size_t slot) const;
+      
+      BindingsSchema schema_;
+      mutable std::vector<Term> terms_;
+      size_t numTerms_;
+      boost::shared_ptr<TermArena> arena_;
+      
+      boost::shared_ptr<const Materializer> materializer_;
+      mutable std::vector<bool> pending_;
+      mutable size_t numPending_;
     };
     
     /** \brief The Prolog bindings' implementation
       */
     boost::shared_ptr<Impl> impl_;
   };
+  
+  /** \brief Compute the hash value of Prolog bindings
+    */
+  size_t hash_value(const Bindings& bindings);
+};
+
+namespace std {
+  /** \brief Hash function specialization for Prolog bindings
+    */
+  template <> struct hash<prolog::Bindings> {
+    size_t operator()(const prolog::Bindings& bindings) const {
+      return bindings.getHash();
+    }
+  };
 };
 
 #endif
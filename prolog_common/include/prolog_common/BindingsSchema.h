@@ -0,0 +1,116 @@
+/******************************************************************************
+ * Copyright (C) 2016 by Ralf Kaestner                                        *
+ * ralf.kaestner@gmail.com                                                    *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the               *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+/** \file BindingsSchema.h
+  * \brief Header file providing the BindingsSchema class interface
+  */
+
+#ifndef ROS_PROLOG_BINDINGS_SCHEMA_H
+#define ROS_PROLOG_BINDINGS_SCHEMA_H
+
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/unordered_map.hpp>
+
+#include <prolog_common/Symbol.h>
+
+namespace prolog {
+  /** \brief Prolog bindings schema
+    * 
+    * A Prolog bindings schema assigns a slot index to each variable
+    * name of a query. All solutions of one query share the same schema
+    * and store their terms in a flat array of slots, such that no
+    * per-solution hashing or name allocation is required.
+    * 
+    * Copies of a schema share their implementation, which is cloned
+    * before a symbol is added to a shared schema.
+    */
+  class BindingsSchema {
+  public:
+    /** \brief Default constructor
+      */
+    BindingsSchema();
+    
+    /** \brief Constructor (overloaded version taking a vector of
+      *   symbols which are assigned consecutive slots)
+      */
+    BindingsSchema(const std::vector<Symbol>& symbols);
+    
+    /** \brief Copy constructor
+      */
+    BindingsSchema(const BindingsSchema& src);
+    
+    /** \brief Destructor
+      */
+    ~BindingsSchema();
+    
+    /** \brief Retrieve the number of slots of this Prolog bindings
+      *   schema
+      */
+    size_t getNumSlots() const;
+    
+    /** \brief Retrieve the symbol assigned to a slot of this Prolog
+      *   bindings schema
+      */
+    const Symbol& getSymbol(size_t slot) const;
+    
+    /** \brief Retrieve the slot assigned to a symbol by this Prolog
+      *   bindings schema
+      * 
+      * \return False, if the symbol has not been assigned a slot.
+      */
+    bool lookupSlot(const Symbol& symbol, size_t& slot) const;
+    
+    /** \brief Add a symbol to this Prolog bindings schema
+      * 
+      * \return The slot assigned to the symbol. If the symbol has been
+      *   added before, its existing slot is returned.
+      */
+    size_t addSymbol(const Symbol& symbol);
+    
+    /** \brief Binary operator for comparing this Prolog bindings schema
+      *   with another Prolog bindings schema for equality
+      */
+    bool operator==(const BindingsSchema& schema) const;
+    
+    /** \brief Binary operator for comparing this Prolog bindings schema
+      *   with another Prolog bindings schema for inequality
+      */
+    bool operator!=(const BindingsSchema& schema) const;
+    
+  protected:
+    /** \brief Prolog bindings schema (implementation)
+      */
+    class Impl {
+    public:
+      Impl();
+      Impl(const std::vector<Symbol>& symbols);
+      ~Impl();
+      
+      std::vector<Symbol> symbols_;
+      boost::unordered_map<Symbol, size_t> slots_;
+    };
+    
+    /** \brief The Prolog bindings schema's implementation
+      */
+    boost::shared_ptr<Impl> impl_;
+  };
+};
+
+#endif
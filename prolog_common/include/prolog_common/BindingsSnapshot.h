@@ -0,0 +1,192 @@
+/******************************************************************************
+ * Copyright (C) 2016 by Ralf Kaestner                                        *
+ * ralf.kaestner@gmail.com                                                    *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the               *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+/** \file BindingsSnapshot.h
+  * \brief Header file providing the BindingsSnapshot class interface
+  */
+
+#ifndef ROS_PROLOG_BINDINGS_SNAPSHOT_H
+#define ROS_PROLOG_BINDINGS_SNAPSHOT_H
+
+#include <cstdint>
+#include <string>
+
+#include <boost/shared_ptr.hpp>
+
+#include <ros/exception.h>
+
+#include <prolog_common/Bindings.h>
+#include <prolog_common/BindingsSchema.h>
+#include <prolog_common/BindingsWriter.h>
+#include <prolog_common/Term.h>
+
+namespace prolog {
+  /** \brief Prolog bindings snapshot
+    * 
+    * The bindings snapshot captures the terms of a solution in a compact
+    * binary buffer. A Prolog engine writes the terms of each slot of
+    * the bindings schema in prefix order, without building any Prolog
+    * terms. The snapshot is decoded into Prolog bindings later, and
+    * decoding does not require an engine, so it may run on any thread.
+    * 
+    * The buffer encodes each term as a one-byte tag followed by its
+    * payload, with lengths and counts as 32-bit and numbers in their
+    * native representation. Snapshots are therefore not portable across
+    * hosts and are not meant to be sent over the wire. Instead, a snapshot
+    * may be replayed into another Prolog bindings writer, such as a
+    * serializing writer.
+    */
+  class BindingsSnapshot :
+    public BindingsWriter {
+  public:
+    /** \brief Exception thrown in case of a failure to decode a Prolog
+      *   bindings snapshot
+      */ 
+    class DecodingError :
+      public ros::Exception {
+    public:
+      DecodingError(const std::string& description);
+    };
+    
+    /** \brief Default constructor
+      */
+    BindingsSnapshot();
+    
+    /** \brief Constructor (overloaded version taking the Prolog bindings
+      *   schema of the snapshot)
+      */
+    BindingsSnapshot(const BindingsSchema& schema);
+    
+    /** \brief Copy constructor
+      */
+    BindingsSnapshot(const BindingsSnapshot& src);
+    
+    /** \brief Destructor
+      */
+    ~BindingsSnapshot();
+    
+    /** \brief Retrieve the Prolog bindings schema of this snapshot
+      */
+    const BindingsSchema& getSchema() const;
+    
+    /** \brief Retrieve the size of the buffer of this Prolog bindings
+      *   snapshot in bytes
+      */
+    size_t getSize() const;
+    
+    /** \brief True, if this Prolog bindings snapshot is valid
+      */
+    bool isValid() const;
+    
+    /** \brief Begin writing Prolog bindings of the specified schema to
+      *   this snapshot
+      * 
+      * The snapshot is reset to an empty buffer which is not shared
+      * with any copies of this snapshot.
+      */
+    void beginBindings(const BindingsSchema& schema);
+    
+    /** \brief Put an unbound slot to this Prolog bindings snapshot
+      */
+    void putUnbound();
+    
+    /** \brief Put an atom to this Prolog bindings snapshot
+      */
+    void putAtom(const char* name, size_t length);
+    
+    /** \brief Put an integer number to this Prolog bindings snapshot
+      */
+    void putInteger(int64_t value);
+    
+    /** \brief Put a floating point number to this Prolog bindings
+      *   snapshot
+      */
+    void putFloat(double value);
+    
+    /** \brief Put a string to this Prolog bindings snapshot
+      */
+    void putString(const char* value, size_t length);
+    
+    /** \brief Put a variable to this Prolog bindings snapshot
+      */
+    void putVariable(const char* name, size_t length);
+    
+    /** \brief Put a compound to this Prolog bindings snapshot
+      * 
+      * The compound's arguments must be put next.
+      */
+    void putCompound(const char* functor, size_t length, size_t arity);
+    
+    /** \brief Put a list to this Prolog bindings snapshot
+      * 
+      * The list's elements must be put next, followed by its tail if
+      * the list is partial.
+      */
+    void putList(size_t numElements, bool partial = false);
+    
+    /** \brief Decode this Prolog bindings snapshot
+      */
+    Bindings decode() const;
+    
+    /** \brief Replay this Prolog bindings snapshot into the specified
+      *   Prolog bindings writer
+      */
+    void replay(BindingsWriter& writer) const;
+    
+  protected:
+    /** \brief Prolog bindings snapshot (implementation)
+      */
+    class Impl {
+    public:
+      Impl(const BindingsSchema& schema);
+      ~Impl();
+      
+      void putTag(char tag);
+      void putLength(size_t length);
+      void putChars(const char* chars, size_t length);
+      
+      char getTag(size_t& offset) const;
+      size_t getLength(size_t& offset) const;
+      std::string getChars(size_t& offset) const;
+      
+      Term decode(size_t& offset) const;
+      Term decodeAtomic(char tag, size_t& offset) const;
+      void replay(size_t& offset, BindingsWriter& writer) const;
+      void replayAtomic(char tag, size_t& offset, BindingsWriter& writer)
+        const;
+      
+      BindingsSchema schema_;
+      std::string buffer_;
+      
+      /** \brief Compound term or list being decoded
+        */
+      struct Frame {
+        char tag_;
+        size_t numSubterms_;
+        size_t offset_;
+        std::string functor_;
+      };
+    };
+    
+    /** \brief The Prolog bindings snapshot's implementation
+      */
+    boost::shared_ptr<Impl> impl_;
+  };
+};
+
+#endif
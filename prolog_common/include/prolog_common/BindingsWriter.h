@@ -0,0 +1,98 @@
+/******************************************************************************
+ * Copyright (C) 2016 by Ralf Kaestner                                        *
+ * ralf.kaestner@gmail.com                                                    *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the               *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+/** \file BindingsWriter.h
+  * \brief Header file providing the BindingsWriter class interface
+  */
+
+#ifndef ROS_PROLOG_BINDINGS_WRITER_H
+#define ROS_PROLOG_BINDINGS_WRITER_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include <prolog_common/BindingsSchema.h>
+
+namespace prolog {
+  /** \brief Prolog bindings writer
+    * 
+    * A Prolog bindings writer receives the terms of a solution as a
+    * stream of events, without any Prolog terms being built. Writing
+    * begins with the Prolog bindings schema, followed by the terms of
+    * each slot of the schema in prefix order, and ends once all slots
+    * have been written. Slots without a term are written as unbound.
+    */
+  class BindingsWriter {
+  public:
+    /** \brief Default constructor
+      */
+    BindingsWriter();
+    
+    /** \brief Destructor
+      */
+    virtual ~BindingsWriter();
+    
+    /** \brief Begin writing Prolog bindings of the specified schema
+      */
+    virtual void beginBindings(const BindingsSchema& schema) = 0;
+    
+    /** \brief End writing Prolog bindings
+      */
+    virtual void endBindings();
+    
+    /** \brief Put an unbound slot
+      */
+    virtual void putUnbound() = 0;
+    
+    /** \brief Put an atom
+      */
+    virtual void putAtom(const char* name, size_t length) = 0;
+    
+    /** \brief Put an integer number
+      */
+    virtual void putInteger(int64_t value) = 0;
+    
+    /** \brief Put a floating point number
+      */
+    virtual void putFloat(double value) = 0;
+    
+    /** \brief Put a string
+      */
+    virtual void putString(const char* value, size_t length) = 0;
+    
+    /** \brief Put a variable
+      */
+    virtual void putVariable(const char* name, size_t length) = 0;
+    
+    /** \brief Put a compound
+      * 
+      * The compound's arguments must be put next.
+      */
+    virtual void putCompound(const char* functor, size_t length,
+      size_t arity) = 0;
+    
+    /** \brief Put a list
+      * 
+      * The list's elements must be put next, followed by its tail if
+      * the list is partial.
+      */
+    virtual void putList(size_t numElements, bool partial = false) = 0;
+  };
+};
+
+#endif
@@ -56,6 +56,13 @@ namespace prolog {
       arguments = std::vector<Term>(), const std::list<Term>&
       goals = std::list<Term>());
     
+    /** \brief Constructor (overloaded version for constructing a
+      *   Prolog fact or rule using a predicate and by moving from a
+      *   vector of argument terms and a list of goal terms)
+      */
+    Clause(const std::string& predicate, std::vector<Term>&& arguments,
+      std::list<Term>&& goals = std::list<Term>());
+    
     /** \brief Constructor (overloaded version for constructing a
       *   Prolog fact or rule using a predicate, an initializer list
       *   of argument terms, and an initializer list of goal terms)
@@ -23,10 +23,12 @@
 #ifndef ROS_PROLOG_COMPOUND_H
 #define ROS_PROLOG_COMPOUND_H
 
+#include <atomic>
 #include <string>
 #include <vector>
 
 #include <prolog_common/Term.h>
+#include <prolog_common/TermArena.h>
 
 namespace prolog {
   /** \brief Prolog compound
@@ -34,9 +36,27 @@ namespace prolog {
   class Compound :
     public Term {
   public:
+    /** \brief Definition of the Prolog compound argument container type
+      */
+    typedef std::vector<Term, TermAllocator<Term> > Arguments;
+    
+    /** \brief Definition of the Prolog compound argument iterator type
+      */
+    typedef Arguments::iterator Iterator;
+    
+    /** \brief Definition of the Prolog compound argument const-iterator
+      *   type
+      */
+    typedef Arguments::const_iterator ConstIterator;
+    
     /** \brief Constructor
       */
     Compound(const std::string& functor, const std::vector<Term>& arguments);
+    
+    /** \brief Constructor (overloaded version moving from a vector of
+      *   argument terms)
+      */
+    Compound(const std::string& functor, std::vector<Term>&& arguments);
       
     /** \brief Copy constructor
       */
@@ -48,15 +68,24 @@ namespace prolog {
     
     /** \brief Destructor
       */
-    virtual ~Compound();
+    ~Compound();
     
     /** \brief Retrieve the functor of this Prolog compound term
       */
-    std::string getFunctor() const;
+    const std::string& getFunctor() const;
+    
+    /** \brief Retrieve the identifier of the interned functor
+      *   name/arity pair of this Prolog compound term
+      */
+    size_t getFunctorIdentifier() const;
     
     /** \brief Retrieve the arguments of this Prolog compound term
       */
-    std::vector<Term> getArguments() const;
+    const Arguments& getArguments() const;
+    
+    /** \brief Retrieve an argument of this Prolog compound term by index
+      */
+    const Term& getArgument(size_t index) const;
     
     /** \brief Retrieve the arity of this Prolog compound term
       */
@@ -64,26 +93,35 @@ namespace prolog {
     
     /** \brief Retrieve the argument begin iterator of this Prolog
       *   compound term
+      * 
+      * Since the arguments may be modified through the returned iterator,
+      * a compound term which is shared with other terms or allocated by a
+      * term arena is first copied.
       */ 
-    std::vector<Term>::iterator begin();
+    Iterator begin();
     
     /** \brief Retrieve the argument begin const-iterator of this Prolog
       *   compound term
       */ 
-    std::vector<Term>::const_iterator begin() const;
+    ConstIterator begin() const;
 
     /** \brief Retrieve the argument end iterator of this Prolog compound
       *   term
+      * 
+      * Since the arguments may be modified through the returned iterator,
+      * a compound term which is shared with other terms or allocated by a
+      * term arena is first copied.
       */ 
-    std::vector<Term>::iterator end();
+    Iterator end();
     
     /** \brief Retrieve the argument end const-iterator of this Prolog
       *   compound term
       */ 
-    std::vector<Term>::const_iterator end() const;
+    ConstIterator end() const;
     
   protected:
     friend class Term;
+    friend class TermArena;
     
     /** \brief Prolog compound (implementation)
       */
@@ -91,11 +129,22 @@ namespace prolog {
       public Term::Impl {
     public:
       Impl(const std::string& functor, const std::vector<Term>& arguments);
+      Impl(const std::string& functor, std::vector<Term>&& arguments);
+      Impl(size_t functor, const TermAllocator<Term>& allocator);
+      Impl(const Impl& src);
       virtual ~Impl();
       
-      std::string functor_;
-      std::vector<Term> arguments_;
+      bool isArenaAllocated() const;
+      
+      size_t functor_;
+      Arguments arguments_;
+      mutable std::atomic<size_t> hash_;
     };
+    
+    /** \brief Retrieve the implementation of this Prolog compound term
+      *   for modification
+      */
+    Impl& getMutableImpl();
   };
 };
 
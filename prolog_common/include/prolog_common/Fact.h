@@ -41,6 +41,11 @@ namespace prolog {
     Fact(const std::string& predicate, const std::vector<Term>& arguments =
       std::vector<Term>());
       
+    /** \brief Constructor (overloaded version moving from a vector of
+      *   arguments)
+      */
+    Fact(const std::string& predicate, std::vector<Term>&& arguments);
+    
     /** \brief Copy constructor
       */
     Fact(const Fact& src);
@@ -55,11 +60,11 @@ namespace prolog {
     
     /** \brief Retrieve the predicate of this Prolog fact
       */
-    std::string getPredicate() const;
+    const std::string& getPredicate() const;
     
     /** \brief Retrieve the arguments of this Prolog fact
       */
-    std::vector<Term> getArguments() const;
+    const std::vector<Term>& getArguments() const;
     
     /** \brief Retrieve the arity of this Prolog fact
       */
@@ -74,6 +79,7 @@ namespace prolog {
       public Clause::Impl {
     public:
       Impl(const std::string& predicate, const std::vector<Term>& arguments);
+      Impl(const std::string& predicate, std::vector<Term>&& arguments);
       virtual ~Impl();
       
       std::string predicate_;
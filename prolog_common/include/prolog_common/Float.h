@@ -45,26 +45,11 @@ namespace prolog {
     
     /** \brief Destructor
       */
-    virtual ~Float();
+    ~Float();
     
     /** \brief Retrieve the value of this Prolog float
       */
     double getValue() const;
-    
-  protected:
-    friend class Number;
-    friend class Term;
-    
-    /** \brief Prolog float (implementation)
-      */
-    class Impl :
-      public Number::Impl {
-    public:
-      Impl(double value);
-      virtual ~Impl();
-      
-      double value_;
-    };
   };
 };
 
@@ -0,0 +1,114 @@
+/******************************************************************************
+ * Copyright (C) 2016 by Ralf Kaestner                                        *
+ * ralf.kaestner@gmail.com                                                    *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the               *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+/** \file GoalBuilder.h
+  * \brief Header file providing the GoalBuilder class interface
+  */
+
+#ifndef ROS_PROLOG_GOAL_BUILDER_H
+#define ROS_PROLOG_GOAL_BUILDER_H
+
+#include <string>
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+
+#include <prolog_common/Term.h>
+#include <prolog_common/TermArena.h>
+
+namespace prolog {
+  /** \brief Prolog goal builder
+    * 
+    * A Prolog goal builder materializes a goal expression into a Prolog
+    * term. The parts of the goal are put to the builder in post-order,
+    * and each compound consumes its arguments from the top of a stack
+    * of terms. Conjunctions and disjunctions are built with the same
+    * functors as the compounds returned by Term::operator&() and
+    * Term::operator|().
+    */
+  class GoalBuilder {
+  public:
+    /** \brief Default constructor
+      */
+    GoalBuilder();
+    
+    /** \brief Constructor (overloaded version building the goal into a
+      *   Prolog term arena)
+      */
+    GoalBuilder(TermArena& arena);
+    
+    /** \brief Copy constructor
+      */
+    GoalBuilder(const GoalBuilder& src);
+    
+    /** \brief Destructor
+      */
+    ~GoalBuilder();
+    
+    /** \brief Retrieve the goal built by this Prolog goal builder
+      */
+    Term getGoal() const;
+    
+    /** \brief Put a Prolog term to this Prolog goal builder
+      */
+    void putTerm(const Term& term);
+    
+    /** \brief Put a Prolog compound to this Prolog goal builder, taking
+      *   its arguments from the previously put terms
+      * 
+      * A compound with zero arity is built as an atom.
+      */
+    void putCompound(const std::string& functor, size_t arity);
+    
+    /** \brief Put a Prolog conjunction to this Prolog goal builder,
+      *   taking its conjuncts from the previously put terms
+      */
+    void putConjunction(size_t numConjuncts);
+    
+    /** \brief Put a Prolog disjunction to this Prolog goal builder,
+      *   taking its disjuncts from the previously put terms
+      */
+    void putDisjunction(size_t numDisjuncts);
+    
+    /** \brief Clear this Prolog goal builder
+      */
+    void clear();
+    
+  protected:
+    /** \brief Prolog goal builder (implementation)
+      */
+    class Impl {
+    public:
+      Impl(TermArena* arena);
+      ~Impl();
+      
+      Term createCompound(const std::string& functor, std::vector<Term>::
+        iterator begin, std::vector<Term>::iterator end);
+      void putOperator(const std::string& functor, size_t numOperands);
+      
+      TermArena* arena_;
+      std::vector<Term> terms_;
+    };
+    
+    /** \brief The Prolog goal builder's implementation
+      */
+    boost::shared_ptr<Impl> impl_;
+  };
+};
+
+#endif
@@ -0,0 +1,281 @@
+/******************************************************************************
+ * Copyright (C) 2016 by Ralf Kaestner                                        *
+ * ralf.kaestner@gmail.com                                                    *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the               *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+/** \file GoalExpression.h
+  * \brief Header file providing the GoalExpression class interface
+  */
+
+#ifndef ROS_PROLOG_GOAL_EXPRESSION_H
+#define ROS_PROLOG_GOAL_EXPRESSION_H
+
+#include <tuple>
+
+#include <boost/type_traits.hpp>
+#include <boost/utility/enable_if.hpp>
+
+#include <prolog_common/GoalBuilder.h>
+#include <prolog_common/Term.h>
+
+namespace prolog {
+  /** \brief Prolog goal expression
+    * 
+    * A goal expression is an expression template which captures a
+    * Prolog goal built from conjunctions, disjunctions and compounds
+    * as a stack-only type. Unlike the Prolog compound terms constructed
+    * eagerly by Term::operator&() and Term::operator|(), no Prolog terms
+    * are created before the expression is materialized. Materialization
+    * visits the expression in a single pass and emits its parts in
+    * post-order to a goal builder, which may construct a Prolog term or,
+    * e.g., a term of the underlying Prolog engine.
+    * 
+    * Chained conjunctions and disjunctions are materialized into right-
+    * nested compounds, i.e., in the way Prolog reads the goal a, b, c.
+    * Goal expressions reference their functor names, which must thus
+    * outlive them.
+    */
+  template <class E> class GoalExpression {
+  public:
+    /** \brief Operator for converting this Prolog goal expression to a
+      *   Prolog term
+      */
+    operator Term() const;
+    
+    /** \brief Materialize this Prolog goal expression into a Prolog
+      *   term
+      */
+    Term toTerm() const;
+    
+    /** \brief Materialize this Prolog goal expression into a Prolog
+      *   term which is built into a Prolog term arena
+      */
+    Term toTerm(TermArena& arena) const;
+    
+    /** \brief Materialize this Prolog goal expression through a goal
+      *   builder
+      */
+    template <class B> void build(B& builder) const;
+    
+    /** \brief Materialize the conjuncts of this Prolog goal expression
+      *   through a goal builder and return their number
+      */
+    template <class B> size_t buildConjuncts(B& builder) const;
+    
+    /** \brief Materialize the disjuncts of this Prolog goal expression
+      *   through a goal builder and return their number
+      */
+    template <class B> size_t buildDisjuncts(B& builder) const;
+  };
+  
+  /** \brief Prolog goal expression holding a Prolog term
+    */
+  class GoalTerm :
+    public GoalExpression<GoalTerm> {
+  public:
+    /** \brief Constructor
+      */
+    GoalTerm(const Term& term);
+    
+    /** \brief Materialize this Prolog goal expression through a goal
+      *   builder
+      */
+    template <class B> void build(B& builder) const;
+    
+  protected:
+    /** \brief The Prolog term of this goal expression
+      */
+    Term term_;
+  };
+  
+  /** \brief Prolog goal expression argument traits
+    * 
+    * The argument traits statically map the type of an argument of a
+    * compound goal expression to the goal expression type holding it.
+    */
+  template <typename T, typename Enable = void> struct GoalArgument {
+    typedef GoalTerm Type;
+    static Type create(const T& argument);
+  };
+  
+  /** \brief Prolog goal expression argument traits (specialization for
+    *   goal expression arguments)
+    */
+  template <typename T> struct GoalArgument<T, typename boost::enable_if<
+      boost::is_base_of<GoalExpression<T>, T> >::type> {
+    typedef T Type;
+    static const Type& create(const T& argument);
+  };
+  
+  /** \brief Prolog compound goal expression
+    */
+  template <typename... Args> class GoalCompound :
+    public GoalExpression<GoalCompound<Args...> > {
+  public:
+    /** \brief Constructor
+      */
+    GoalCompound(const char* functor, const Args&... arguments);
+    
+    /** \brief Materialize this Prolog goal expression through a goal
+      *   builder
+      */
+    template <class B> void build(B& builder) const;
+    
+  protected:
+    /** \brief Compile-time sequence of indices
+      */
+    template <size_t... I> struct Indices {
+    };
+    
+    /** \brief Compile-time generator of a sequence of indices
+      */
+    template <size_t N, size_t... I> struct MakeIndices :
+      MakeIndices<N-1, N-1, I...> {
+    };
+    
+    template <size_t... I> struct MakeIndices<0, I...> {
+      typedef Indices<I...> Type;
+    };
+    
+    /** \brief Materialize the arguments of this Prolog goal expression
+      *   through a goal builder
+      */
+    template <class B, size_t... I> void buildArguments(B& builder,
+      Indices<I...>) const;
+    
+    /** \brief The functor of this goal expression
+      */
+    const char* functor_;
+    
+    /** \brief The arguments of this goal expression
+      */
+    std::tuple<Args...> arguments_;
+  };
+  
+  /** \brief Prolog conjunctive goal expression
+    */
+  template <class L, class R> class GoalConjunction :
+    public GoalExpression<GoalConjunction<L, R> > {
+  public:
+    /** \brief Constructor
+      */
+    GoalConjunction(const L& left, const R& right);
+    
+    /** \brief Materialize this Prolog goal expression through a goal
+      *   builder
+      */
+    template <class B> void build(B& builder) const;
+    
+    /** \brief Materialize the conjuncts of this Prolog goal expression
+      *   through a goal builder and return their number
+      */
+    template <class B> size_t buildConjuncts(B& builder) const;
+    
+  protected:
+    /** \brief The left operand of this goal expression
+      */
+    L left_;
+    
+    /** \brief The right operand of this goal expression
+      */
+    R right_;
+  };
+  
+  /** \brief Prolog disjunctive goal expression
+    */
+  template <class L, class R> class GoalDisjunction :
+    public GoalExpression<GoalDisjunction<L, R> > {
+  public:
+    /** \brief Constructor
+      */
+    GoalDisjunction(const L& left, const R& right);
+    
+    /** \brief Materialize this Prolog goal expression through a goal
+      *   builder
+      */
+    template <class B> void build(B& builder) const;
+    
+    /** \brief Materialize the disjuncts of this Prolog goal expression
+      *   through a goal builder and return their number
+      */
+    template <class B> size_t buildDisjuncts(B& builder) const;
+    
+  protected:
+    /** \brief The left operand of this goal expression
+      */
+    L left_;
+    
+    /** \brief The right operand of this goal expression
+      */
+    R right_;
+  };
+  
+  /** \brief Create a Prolog goal expression holding a Prolog term
+    */
+  GoalTerm goal(const Term& term);
+  
+  /** \brief Create a Prolog compound goal expression
+    * 
+    * Arguments which are not goal expressions are converted to Prolog
+    * terms.
+    */
+  template <typename... Args> GoalCompound<typename GoalArgument<Args>::
+    Type...> goal(const char* functor, const Args&... arguments);
+  
+  /** \brief Binary operator for constructing a Prolog conjunctive goal
+    *   expression
+    */
+  template <class L, class R> GoalConjunction<L, R> operator&(const
+    GoalExpression<L>& left, const GoalExpression<R>& right);
+  
+  /** \brief Binary operator for constructing a Prolog conjunctive goal
+    *   expression (overloaded version taking a Prolog term as right
+    *   operand)
+    */
+  template <class L> GoalConjunction<L, GoalTerm> operator&(const
+    GoalExpression<L>& left, const Term& right);
+  
+  /** \brief Binary operator for constructing a Prolog conjunctive goal
+    *   expression (overloaded version taking a Prolog term as left
+    *   operand)
+    */
+  template <class R> GoalConjunction<GoalTerm, R> operator&(const Term&
+    left, const GoalExpression<R>& right);
+  
+  /** \brief Binary operator for constructing a Prolog disjunctive goal
+    *   expression
+    */
+  template <class L, class R> GoalDisjunction<L, R> operator|(const
+    GoalExpression<L>& left, const GoalExpression<R>& right);
+  
+  /** \brief Binary operator for constructing a Prolog disjunctive goal
+    *   expression (overloaded version taking a Prolog term as right
+    *   operand)
+    */
+  template <class L> GoalDisjunction<L, GoalTerm> operator|(const
+    GoalExpression<L>& left, const Term& right);
+  
+  /** \brief Binary operator for constructing a Prolog disjunctive goal
+    *   expression (overloaded version taking a Prolog term as left
+    *   operand)
+    */
+  template <class R> GoalDisjunction<GoalTerm, R> operator|(const Term&
+    left, const GoalExpression<R>& right);
+};
+
+#include <prolog_common/GoalExpression.tpp>
+
+#endif
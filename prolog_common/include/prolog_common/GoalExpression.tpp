@@ -0,0 +1,186 @@
+/******************************************************************************
+ * Copyright (C) 2016 by Ralf Kaestner                                        *
+ * ralf.kaestner@gmail.com                                                    *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the               *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+namespace prolog {
+
+/*****************************************************************************/
+/* Constructors and Destructor                                               */
+/*****************************************************************************/
+
+template <typename... Args> GoalCompound<Args...>::GoalCompound(const char*
+    functor, const Args&... arguments) :
+  functor_(functor),
+  arguments_(arguments...) {
+}
+
+template <class L, class R> GoalConjunction<L, R>::GoalConjunction(const L&
+    left, const R& right) :
+  left_(left),
+  right_(right) {
+}
+
+template <class L, class R> GoalDisjunction<L, R>::GoalDisjunction(const L&
+    left, const R& right) :
+  left_(left),
+  right_(right) {
+}
+
+/*****************************************************************************/
+/* Methods                                                                   */
+/*****************************************************************************/
+
+template <class E> Term GoalExpression<E>::toTerm() const {
+  GoalBuilder builder;
+  
+  static_cast<const E&>(*this).build(builder);
+  
+  return builder.getGoal();
+}
+
+template <class E> Term GoalExpression<E>::toTerm(TermArena& arena) const {
+  GoalBuilder builder(arena);
+  
+  static_cast<const E&>(*this).build(builder);
+  
+  return builder.getGoal();
+}
+
+template <class E> template <class B> void GoalExpression<E>::build(B&
+    builder) const {
+  static_cast<const E&>(*this).build(builder);
+}
+
+template <class E> template <class B> size_t GoalExpression<E>::
+    buildConjuncts(B& builder) const {
+  static_cast<const E&>(*this).build(builder);
+  
+  return 1;
+}
+
+template <class E> template <class B> size_t GoalExpression<E>::
+    buildDisjuncts(B& builder) const {
+  static_cast<const E&>(*this).build(builder);
+  
+  return 1;
+}
+
+template <class B> void GoalTerm::build(B& builder) const {
+  builder.putTerm(term_);
+}
+
+template <typename T, typename Enable> typename GoalArgument<T, Enable>::
+    Type GoalArgument<T, Enable>::create(const T& argument) {
+  return GoalTerm(Term(argument));
+}
+
+template <typename T> const typename GoalArgument<T, typename
+    boost::enable_if<boost::is_base_of<GoalExpression<T>, T> >::type>::Type&
+    GoalArgument<T, typename boost::enable_if<boost::is_base_of<
+    GoalExpression<T>, T> >::type>::create(const T& argument) {
+  return argument;
+}
+
+template <typename... Args> template <class B> void GoalCompound<Args...>::
+    build(B& builder) const {
+  buildArguments(builder, typename MakeIndices<sizeof...(Args)>::Type());
+  
+  builder.putCompound(functor_, sizeof...(Args));
+}
+
+template <typename... Args> template <class B, size_t... I> void
+    GoalCompound<Args...>::buildArguments(B& builder, Indices<I...>) const {
+  int expansion[] = {0, (std::get<I>(arguments_).build(builder), 0)...};
+  
+  (void)expansion;
+}
+
+template <class L, class R> template <class B> void GoalConjunction<L, R>::
+    build(B& builder) const {
+  builder.putConjunction(buildConjuncts(builder));
+}
+
+template <class L, class R> template <class B> size_t GoalConjunction<L, R>::
+    buildConjuncts(B& builder) const {
+  size_t numConjuncts = left_.buildConjuncts(builder);
+  
+  return numConjuncts+right_.buildConjuncts(builder);
+}
+
+template <class L, class R> template <class B> void GoalDisjunction<L, R>::
+    build(B& builder) const {
+  builder.putDisjunction(buildDisjuncts(builder));
+}
+
+template <class L, class R> template <class B> size_t GoalDisjunction<L, R>::
+    buildDisjuncts(B& builder) const {
+  size_t numDisjuncts = left_.buildDisjuncts(builder);
+  
+  return numDisjuncts+right_.buildDisjuncts(builder);
+}
+
+template <typename... Args> GoalCompound<typename GoalArgument<Args>::
+    Type...> goal(const char* functor, const Args&... arguments) {
+  return GoalCompound<typename GoalArgument<Args>::Type...>(functor,
+    GoalArgument<Args>::create(arguments)...);
+}
+
+/*****************************************************************************/
+/* Operators                                                                 */
+/*****************************************************************************/
+
+template <class E> GoalExpression<E>::operator Term() const {
+  return toTerm();
+}
+
+template <class L, class R> GoalConjunction<L, R> operator&(const
+    GoalExpression<L>& left, const GoalExpression<R>& right) {
+  return GoalConjunction<L, R>(static_cast<const L&>(left),
+    static_cast<const R&>(right));
+}
+
+template <class L> GoalConjunction<L, GoalTerm> operator&(const
+    GoalExpression<L>& left, const Term& right) {
+  return GoalConjunction<L, GoalTerm>(static_cast<const L&>(left),
+    GoalTerm(right));
+}
+
+template <class R> GoalConjunction<GoalTerm, R> operator&(const Term& left,
+    const GoalExpression<R>& right) {
+  return GoalConjunction<GoalTerm, R>(GoalTerm(left),
+    static_cast<const R&>(right));
+}
+
+template <class L, class R> GoalDisjunction<L, R> operator|(const
+    GoalExpression<L>& left, const GoalExpression<R>& right) {
+  return GoalDisjunction<L, R>(static_cast<const L&>(left),
+    static_cast<const R&>(right));
+}
+
+template <class L> GoalDisjunction<L, GoalTerm> operator|(const
+    GoalExpression<L>& left, const Term& right) {
+  return GoalDisjunction<L, GoalTerm>(static_cast<const L&>(left),
+    GoalTerm(right));
+}
+
+template <class R> GoalDisjunction<GoalTerm, R> operator|(const Term& left,
+    const GoalExpression<R>& right) {
+  return GoalDisjunction<GoalTerm, R>(GoalTerm(left),
+    static_cast<const R&>(right));
+}
+
+}
@@ -45,26 +45,11 @@ namespace prolog {
     
     /** \brief Destructor
       */
-    virtual ~Integer();
+    ~Integer();
     
     /** \brief Retrieve the value of this Prolog integer
       */
     int64_t getValue() const;
-    
-  protected:
-    friend class Number;
-    friend class Term;
-    
-    /** \brief Prolog integer (implementation)
-      */
-    class Impl :
-      public Number::Impl {
-    public:
-      Impl(int64_t value);
-      virtual ~Impl();
-      
-      int64_t value_;
-    };
   };
 };
 
@@ -23,20 +23,103 @@
 #ifndef ROS_PROLOG_LIST_H
 #define ROS_PROLOG_LIST_H
 
+#include <initializer_list>
 #include <list>
+#include <vector>
+
+#include <boost/iterator/iterator_facade.hpp>
+#include <boost/range/iterator_range.hpp>
 
 #include <prolog_common/Term.h>
+#include <prolog_common/TermArena.h>
 
 namespace prolog {
   /** \brief Prolog list
+    * 
+    * A Prolog list stores its leading elements contiguously and may share
+    * the storage of its remaining elements with another list, such that
+    * prepending to and concatenating lists does not copy the shared tail.
+    * Lists are copied on write. A partial list, i.e., a list of the form
+    * [H|T] with an unbound tail T, carries the tail variable.
     */
   class List :
     public Term {
+  protected:
+    class Impl;
+    
   public:
+    /** \brief Definition of the Prolog list element container type
+      */
+    typedef std::vector<Term, TermAllocator<Term> > Elements;
+    
+    /** \brief Prolog list const-iterator
+      * 
+      * The const-iterator walks the contiguous elements of a list and
+      * continues into the elements of any list it shares its tail with.
+      */
+    class ConstIterator :
+      public boost::iterator_facade<ConstIterator, const Term,
+        boost::forward_traversal_tag> {
+    public:
+      ConstIterator();
+      
+    protected:
+      friend class boost::iterator_core_access;
+      friend class List;
+      
+      ConstIterator(const Impl* impl);
+      
+      void increment();
+      bool equal(const ConstIterator& iterator) const;
+      const Term& dereference() const;
+      
+      const Impl* impl_;
+      size_t index_;
+    };
+    
+    /** \brief Definition of the Prolog list element const-range type
+      */
+    typedef boost::iterator_range<ConstIterator> ConstRange;
+    
     /** \brief Default constructor
       */
     List(const std::list<Term>& elements = std::list<Term>());
-      
+    
+    /** \brief Constructor (overloaded version moving from a list of
+      *   element terms)
+      */
+    List(std::list<Term>&& elements);
+    
+    /** \brief Constructor (overloaded version taking a vector of
+      *   element terms)
+      */
+    List(const std::vector<Term>& elements);
+    
+    /** \brief Constructor (overloaded version moving from a vector of
+      *   element terms)
+      */
+    List(std::vector<Term>&& elements);
+    
+    /** \brief Constructor (overloaded version taking an initializer
+      *   list of element terms)
+      */
+    List(const std::initializer_list<Term>& elements);
+    
+    /** \brief Constructor (overloaded version constructing the list
+      *   [Head|Tail])
+      * 
+      * If the tail is a Prolog list, its elements are shared with the
+      * constructed list. If the tail is a Prolog variable, the
+      * constructed list is partial. An invalid tail denotes the empty
+      * list.
+      */
+    List(const Term& head, const Term& tail);
+    
+    /** \brief Constructor (overloaded version constructing the list
+      *   [Element1, ..., ElementN|Tail])
+      */
+    List(const std::vector<Term>& elements, const Term& tail);
+    
     /** \brief Copy constructor
       */
     List(const List& src);
@@ -47,40 +130,60 @@ namespace prolog {
     
     /** \brief Destructor
       */
-    virtual ~List();
+    ~List();
     
     /** \brief Retrieve the number of elements of this Prolog list
       */
     size_t getNumElements() const;
     
-    /** \brief Retrieve the elements of this Prolog list
+    /** \brief Retrieve the range of elements of this Prolog list
+      * 
+      * The range walks the elements of the list without copying them.
       */
-    std::list<Term> getElements() const;
+    ConstRange getElements() const;
+    
+    /** \brief Retrieve the tail of this Prolog list
+      * 
+      * \return The unbound tail variable of a partial list, or an
+      *   invalid term for a proper list.
+      */
+    const Term& getTail() const;
+    
+    /** \brief Set the tail of this Prolog list
+      */
+    void setTail(const Term& tail);
     
     /** \brief True, if this Prolog list is empty
       */
     bool isEmpty() const;
     
-    /** \brief Retrieve the begin iterator of this Prolog list
-      */ 
-    std::list<Term>::iterator begin();
+    /** \brief True, if this Prolog list is partial, i.e., if its tail
+      *   is an unbound variable
+      */
+    bool isPartial() const;
     
     /** \brief Retrieve the begin const-iterator of this Prolog list
       */ 
-    std::list<Term>::const_iterator begin() const;
-
-    /** \brief Retrieve the end iterator of this Prolog list
-      */ 
-    std::list<Term>::iterator end();
+    ConstIterator begin() const;
     
     /** \brief Retrieve the end const-iterator of this Prolog list
       */ 
-    std::list<Term>::const_iterator end() const;
+    ConstIterator end() const;
+    
+    /** \brief Reserve storage for a number of elements of this Prolog
+      *   list
+      */
+    void reserve(size_t numElements);
     
     /** \brief Append an element to this Prolog list
       */
     void append(const Term& element);
     
+    /** \brief Append an element to this Prolog list (overloaded version
+      *   moving from the element)
+      */
+    void append(Term&& element);
+    
     /** \brief Append the elements of another Prolog list to this
       *   Prolog list
       */
@@ -105,11 +208,14 @@ namespace prolog {
     
     /** \brief Binary operator for appending the elements of another Prolog
       *   list to this Prolog list
+      * 
+      * The elements of the other list are shared with the resulting list.
       */
     List operator+(const List& list) const;
     
   protected:
     friend class Term;
+    friend class TermArena;
     
     /** \brief Prolog list (implementation)
       */
@@ -117,10 +223,32 @@ namespace prolog {
       public Term::Impl {
     public:
       Impl(const std::list<Term>& elements);
+      Impl(std::list<Term>&& elements);
+      Impl(const std::vector<Term>& elements);
+      Impl(std::vector<Term>&& elements);
+      Impl(const TermAllocator<Term>& allocator, size_t capacity = 0);
+      Impl(const Impl& src);
       virtual ~Impl();
       
-      std::list<Term> elements_;
+      bool isArenaAllocated() const;
+      const Impl& getLast() const;
+      
+      Elements elements_;
+      boost::shared_ptr<Impl> next_;
+      Term tail_;
+      size_t size_;
     };
+    
+    /** \brief Retrieve the implementation of this Prolog list for
+      *   modification, copying it if shared
+      */
+    Impl& getMutableImpl();
+    
+    /** \brief Retrieve the implementation of this Prolog list for
+      *   modification, copying it if shared and detaching it from the
+      *   storage it shares with other lists
+      */
+    Impl& getDetachedImpl();
   };
 };
 
@@ -48,7 +48,7 @@ namespace prolog {
     
     /** \brief Destructor
       */
-    virtual ~Number();
+    ~Number();
     
     /** \brief True, if this Prolog number is a float
       */
@@ -57,18 +57,6 @@ namespace prolog {
     /** \brief True, if this Prolog number is an integer
       */
     bool isInteger() const;
-    
-  protected:
-    friend class Term;
-    
-    /** \brief Prolog number (implementation)
-      */
-    class Impl :
-      public Term::Impl {
-    public:
-      Impl();
-      virtual ~Impl();
-    };
   };
 };
 
@@ -36,6 +36,11 @@ namespace prolog {
       */
     Program(const std::list<Clause>& clauses = std::list<Clause>());
       
+    /** \brief Constructor (overloaded version moving from a list of
+      *   clauses)
+      */
+    Program(std::list<Clause>&& clauses);
+    
     /** \brief Copy constructor
       */
     Program(const Program& src);
@@ -50,7 +55,7 @@ namespace prolog {
     
     /** \brief Retrieve the clauses of this Prolog program
       */
-    std::list<Clause> getClauses() const;
+    const std::list<Clause>& getClauses() const;
     
     /** \brief True, if this Prolog program is empty
       */
@@ -76,6 +81,11 @@ namespace prolog {
       */
     void append(const Clause& clause);
     
+    /** \brief Append a clause to this Prolog program (overloaded version
+      *   moving from the clause)
+      */
+    void append(Clause&& clause);
+    
     /** \brief Append the elements of another Prolog program to this
       *   Prolog program
       */
@@ -109,6 +119,7 @@ namespace prolog {
     class Impl {
     public:
       Impl(const std::list<Clause>& clauses);
+      Impl(std::list<Clause>&& clauses);
       virtual ~Impl();
       
       std::list<Clause> clauses_;
@@ -23,6 +23,7 @@
 #ifndef ROS_PROLOG_QUERY_H
 #define ROS_PROLOG_QUERY_H
 
+#include <functional>
 #include <initializer_list>
 #include <string>
 #include <vector>
@@ -52,6 +53,11 @@ namespace prolog {
     Query(const std::string& predicate, const std::initializer_list<Term>&
       arguments);
     
+    /** \brief Constructor (overloaded version taking a predicate and 
+      *   moving from a vector of arguments)
+      */
+    Query(const std::string& predicate, std::vector<Term>&& arguments);
+    
     /** \brief Constructor (overloaded version taking a module, a predicate,
       *   and a vector of arguments)
       */
@@ -64,6 +70,12 @@ namespace prolog {
     Query(const std::string& module, const std::string& predicate, const
       std::initializer_list<Term>& arguments);
     
+    /** \brief Constructor (overloaded version taking a module, a predicate,
+      *   and moving from a vector of arguments)
+      */
+    Query(const std::string& module, const std::string& predicate,
+      std::vector<Term>&& arguments);
+    
     /** \brief Copy constructor
       */
     Query(const Query& src);
@@ -74,15 +86,15 @@ namespace prolog {
     
     /** \brief Retrieve the module of this Prolog query
       */
-    std::string getModule() const;
+    const std::string& getModule() const;
     
     /** \brief Retrieve the predicate of this Prolog query
       */
-    std::string getPredicate() const;
+    const std::string& getPredicate() const;
     
     /** \brief Retrieve the arguments of this Prolog query
       */
-    std::vector<Term> getArguments() const;
+    const std::vector<Term>& getArguments() const;
     
     /** \brief Retrieve the arity of this Prolog query
       */
@@ -99,6 +111,10 @@ namespace prolog {
       */
     bool isValid() const;
     
+    /** \brief Retrieve the structural hash value of this Prolog query
+      */
+    size_t getHash() const;
+    
     /** \brief Retrieve the argument begin iterator of this Prolog query
       */ 
     std::vector<Term>::iterator begin();
@@ -117,6 +133,16 @@ namespace prolog {
       */ 
     std::vector<Term>::const_iterator end() const;
     
+    /** \brief Binary operator for comparing this Prolog query with
+      *   another Prolog query for structural equality
+      */
+    bool operator==(const Query& query) const;
+    
+    /** \brief Binary operator for comparing this Prolog query with
+      *   another Prolog query for structural inequality
+      */
+    bool operator!=(const Query& query) const;
+    
   protected:
     /** \brief Prolog query (implementation)
       */
@@ -125,6 +151,8 @@ namespace prolog {
       Impl(const std::string& module = std::string(), const std::string&
         predicate = std::string(), const std::vector<Term>& arguments =
         std::vector<Term>());
+      Impl(const std::string& module, const std::string& predicate,
+        std::vector<Term>&& arguments);
       virtual ~Impl();
       
       std::string module_;
@@ -136,6 +164,20 @@ namespace prolog {
       */
     boost::shared_ptr<Impl> impl_;
   };
+  
+  /** \brief Compute the hash value of a Prolog query
+    */
+  size_t hash_value(const Query& query);
+};
+
+namespace std {
+  /** \brief Hash function specialization for Prolog queries
+    */
+  template <> struct hash<prolog::Query> {
+    size_t operator()(const prolog::Query& query) const {
+      return query.getHash();
+    }
+  };
 };
 
 #endif
@@ -41,6 +41,12 @@ namespace prolog {
     Rule(const std::string& predicate, const std::vector<Term>& arguments,
       const std::list<Term>& goals);
       
+    /** \brief Constructor (overloaded version moving from a vector of
+      *   arguments and a list of goals)
+      */
+    Rule(const std::string& predicate, std::vector<Term>&& arguments,
+      std::list<Term>&& goals);
+    
     /** \brief Copy constructor
       */
     Rule(const Rule& src);
@@ -55,15 +61,15 @@ namespace prolog {
     
     /** \brief Retrieve the predicate of this Prolog rule
       */
-    std::string getPredicate() const;
+    const std::string& getPredicate() const;
     
     /** \brief Retrieve the arguments of this Prolog rule
       */
-    std::vector<Term> getArguments() const;
+    const std::vector<Term>& getArguments() const;
     
     /** \brief Retrieve the goals of this Prolog rule
       */
-    std::list<Term> getGoals() const;
+    const std::list<Term>& getGoals() const;
     
     /** \brief Retrieve the arity of this Prolog rule
       */
@@ -77,6 +83,11 @@ namespace prolog {
       */
     void append(const Term& goal);
     
+    /** \brief Append a goal to this Prolog rule (overloaded version
+      *   moving from the goal)
+      */
+    void append(Term&& goal);
+    
     /** \brief Unary operator for adding a goal term to this Prolog rule
       */
     Rule& operator&=(const Term& goal);
@@ -91,6 +102,8 @@ namespace prolog {
     public:
       Impl(const std::string& predicate, const std::vector<Term>& arguments,
         const std::list<Term>& goals);
+      Impl(const std::string& predicate, std::vector<Term>&& arguments,
+        std::list<Term>&& goals);
       virtual ~Impl();
       
       std::string predicate_;
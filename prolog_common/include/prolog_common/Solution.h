@@ -24,6 +24,7 @@
 #define ROS_PROLOG_SOLUTION_H
 
 #include <string>
+#include <vector>
 
 #include <boost/type_traits.hpp>
 
@@ -72,7 +73,7 @@ namespace prolog {
     
     /** \brief Retrieve the bindings of this Prolog solution
       */
-    Bindings getBindings() const;
+    const Bindings& getBindings() const;
     
     /** \brief Retrieve a value of this Prolog solution by name
       */
@@ -91,6 +92,8 @@ namespace prolog {
     void clear();
     
   protected:
+    template <typename T> friend class SolutionAccessor;
+    
     /** \brief Prolog solution (implementation)
       */
     class Impl {
@@ -130,6 +133,18 @@ namespace prolog {
       typename boost::disable_if<boost::is_base_of<std::string, C<T> > >::
       type* = 0);
     
+    /** \brief Reserve storage for the elements of a list value
+      *   (overloaded version for vectors)
+      */
+    template <typename T> static void reserveElements(std::vector<T>&
+      value, size_t numElements);
+    
+    /** \brief Reserve storage for the elements of a list value
+      *   (overloaded version for containers without reservable storage)
+      */
+    template <class C> static void reserveElements(C& value, size_t
+      numElements);
+    
     /** \brief The Prolog solution's implementation
       */
     boost::shared_ptr<Impl> impl_;
@@ -20,6 +20,7 @@
 #include <prolog_common/Float.h>
 #include <prolog_common/Integer.h>
 #include <prolog_common/List.h>
+#include <prolog_common/String.h>
 
 namespace prolog {
 
@@ -55,6 +56,11 @@ template <typename T> void Solution::termToValue(const std::string&
     
     return;
   }
+  else if (term.isString()) {
+    value = String(term).getValue();
+    
+    return;
+  }
 
   throw ConversionError(name);
 }
@@ -62,14 +68,10 @@ template <typename T> void Solution::termToValue(const std::string&
 template <typename T> void Solution::termToValue(const std::string&
     name, const Term& term, T &value, typename boost::enable_if<boost::
     is_integral<T> >::type*) {
-  if (term.isNumber()) {
-    Number number(term);
+  if (term.getType() == Term::IntegerType) {
+    value = Integer(term).getValue();
     
-    if (number.isInteger()) {
-      value = Integer(number).getValue();
-      
-      return;
-    }
+    return;
   }
 
   throw ConversionError(name);
@@ -78,14 +80,10 @@ template <typename T> void Solution::termToValue(const std::string&
 template <typename T> void Solution::termToValue(const std::string&
     name, const Term& term, T& value, typename boost::enable_if<boost::
     is_floating_point<T> >::type*) {
-  if (term.isNumber()) {
-    Number number(term);
+  if (term.getType() == Term::FloatType) {
+    value = Float(term).getValue();
     
-    if (number.isFloat()) {
-      value = Float(number).getValue();
-      
-      return;
-    }
+    return;
   }
 
   throw ConversionError(name);
@@ -98,7 +96,8 @@ template <template <typename...> class C, typename T> void Solution::
   if (term.isList()) {
     List list(term);
     
-    for (std::list<Term>::const_iterator it = list.begin();
+    reserveElements(value, list.getNumElements());
+    for (List::ConstIterator it = list.begin();
         it != list.end(); ++it) {
       T element;
       
@@ -113,4 +112,13 @@ template <template <typename...> class C, typename T> void Solution::
   throw ConversionError(name);
 }
 
+template <typename T> void Solution::reserveElements(std::vector<T>& value,
+    size_t numElements) {
+  value.reserve(value.size()+numElements);
+}
+
+template <class C> void Solution::reserveElements(C& value, size_t
+    numElements) {
+}
+
 }
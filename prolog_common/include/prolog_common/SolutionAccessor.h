@@ -0,0 +1,120 @@
+/******************************************************************************
+ * Copyright (C) 2016 by Ralf Kaestner                                        *
+ * ralf.kaestner@gmail.com                                                    *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the               *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+/** \file SolutionAccessor.h
+  * \brief Header file providing the SolutionAccessor class interface
+  */
+
+#ifndef ROS_PROLOG_SOLUTION_ACCESSOR_H
+#define ROS_PROLOG_SOLUTION_ACCESSOR_H
+
+#include <string>
+#include <vector>
+
+#include <prolog_common/BindingsSchema.h>
+#include <prolog_common/Solution.h>
+#include <prolog_common/Symbol.h>
+
+namespace prolog {
+  /** \brief Prolog solution accessor
+    * 
+    * A Prolog solution accessor reads the value of one variable from
+    * many Prolog solutions. The variable name is interned once upon
+    * construction, and its slot is cached for the bindings schema of
+    * the last accessed solution. Since all solutions of one query share
+    * their schema, repeated accesses require neither string hashing nor
+    * slot lookups.
+    * 
+    * The slot cache is not synchronized, so a solution accessor must
+    * not be used concurrently by multiple threads.
+    */
+  template <typename T> class SolutionAccessor {
+  public:
+    /** \brief Constructor (overloaded version taking a variable name)
+      */
+    SolutionAccessor(const std::string& name);
+    
+    /** \brief Constructor (overloaded version taking an interned
+      *   variable name)
+      */
+    SolutionAccessor(const Symbol& name);
+    
+    /** \brief Constructor (overloaded version taking a bindings schema
+      *   and the slot of the variable)
+      */
+    SolutionAccessor(const BindingsSchema& schema, size_t slot);
+    
+    /** \brief Copy constructor
+      */
+    SolutionAccessor(const SolutionAccessor<T>& src);
+    
+    /** \brief Destructor
+      */
+    ~SolutionAccessor();
+    
+    /** \brief Retrieve the variable name of this Prolog solution accessor
+      */
+    const Symbol& getName() const;
+    
+    /** \brief Retrieve the value of the variable from a Prolog solution
+      */
+    T getValue(const Solution& solution) const;
+    
+    /** \brief Retrieve the values of the variable from a range of Prolog
+      *   solutions
+      * 
+      * The values are extracted into a vector which is sized once to
+      * the number of solutions.
+      */
+    template <typename I> void getValues(I begin, I end, std::vector<T>&
+      values) const;
+    
+    /** \brief Retrieve the values of the variable from a container of
+      *   Prolog solutions
+      */
+    template <class C> std::vector<T> getValues(const C& solutions) const;
+    
+    /** \brief Operator for retrieving the value of the variable from
+      *   a Prolog solution
+      */
+    T operator()(const Solution& solution) const;
+    
+  protected:
+    /** \brief Retrieve the slot of the variable in the bindings schema
+      *   of a Prolog solution
+      */
+    bool lookupSlot(const Bindings& bindings, size_t& slot) const;
+    
+    /** \brief The variable name of this Prolog solution accessor
+      */
+    Symbol name_;
+    
+    /** \brief The bindings schema for which the slot has been cached
+      */
+    mutable BindingsSchema schema_;
+    
+    /** \brief The cached slot of the variable in the bindings schema
+      *   (invalid if the schema does not contain the variable)
+      */
+    mutable size_t slot_;
+  };
+};
+
+#include <prolog_common/SolutionAccessor.tpp>
+
+#endif
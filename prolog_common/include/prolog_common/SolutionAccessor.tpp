@@ -0,0 +1,130 @@
+/******************************************************************************
+ * Copyright (C) 2016 by Ralf Kaestner                                        *
+ * ralf.kaestner@gmail.com                                                    *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the               *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+#include <iterator>
+#include <limits>
+
+namespace prolog {
+
+/*****************************************************************************/
+/* Constructors and Destructor                                               */
+/*****************************************************************************/
+
+template <typename T> SolutionAccessor<T>::SolutionAccessor(const
+    std::string& name) :
+  name_(name),
+  slot_(std::numeric_limits<size_t>::max()) {
+}
+
+template <typename T> SolutionAccessor<T>::SolutionAccessor(const Symbol&
+    name) :
+  name_(name),
+  slot_(std::numeric_limits<size_t>::max()) {
+}
+
+template <typename T> SolutionAccessor<T>::SolutionAccessor(const
+    BindingsSchema& schema, size_t slot) :
+  name_(schema.getSymbol(slot)),
+  schema_(schema),
+  slot_(slot) {
+}
+
+template <typename T> SolutionAccessor<T>::SolutionAccessor(const
+    SolutionAccessor<T>& src) :
+  name_(src.name_),
+  schema_(src.schema_),
+  slot_(src.slot_) {
+}
+
+template <typename T> SolutionAccessor<T>::~SolutionAccessor() {
+}
+
+/*****************************************************************************/
+/* Accessors                                                                 */
+/*****************************************************************************/
+
+template <typename T> const Symbol& SolutionAccessor<T>::getName() const {
+  return name_;
+}
+
+template <typename T> T SolutionAccessor<T>::getValue(const Solution&
+    solution) const {
+  const Bindings& bindings = solution.getBindings();
+  size_t slot;
+  
+  if (lookupSlot(bindings, slot)) {
+    Term term = bindings.getTerm(slot);
+    
+    if (term.isValid()) {
+      T value;
+      
+      Solution::termToValue(name_.getName(), term, value);
+      
+      return value;
+    }
+  }
+  
+  throw Solution::NoSuchTerm(name_.getName());
+}
+
+template <typename T> template <typename I> void SolutionAccessor<T>::
+    getValues(I begin, I end, std::vector<T>& values) const {
+  values.resize(std::distance(begin, end));
+  
+  size_t index = 0;
+  for (I it = begin; it != end; ++it, ++index)
+    values[index] = getValue(*it);
+}
+
+template <typename T> template <class C> std::vector<T> SolutionAccessor<T>::
+    getValues(const C& solutions) const {
+  std::vector<T> values;
+  
+  getValues(solutions.begin(), solutions.end(), values);
+  
+  return values;
+}
+
+/*****************************************************************************/
+/* Methods                                                                   */
+/*****************************************************************************/
+
+template <typename T> bool SolutionAccessor<T>::lookupSlot(const Bindings&
+    bindings, size_t& slot) const {
+  if (schema_ != bindings.getSchema()) {
+    schema_ = bindings.getSchema();
+    
+    if (!schema_.lookupSlot(name_, slot_))
+      slot_ = std::numeric_limits<size_t>::max();
+  }
+  
+  slot = slot_;
+  
+  return (slot_ != std::numeric_limits<size_t>::max());
+}
+
+/*****************************************************************************/
+/* Operators                                                                 */
+/*****************************************************************************/
+
+template <typename T> T SolutionAccessor<T>::operator()(const Solution&
+    solution) const {
+  return getValue(solution);
+}
+
+}
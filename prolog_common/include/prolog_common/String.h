@@ -0,0 +1,85 @@
+/******************************************************************************
+ * Copyright (C) 2016 by Ralf Kaestner                                        *
+ * ralf.kaestner@gmail.com                                                    *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the               *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+/** \file String.h
+  * \brief Header file providing the String class interface
+  */
+
+#ifndef ROS_PROLOG_STRING_H
+#define ROS_PROLOG_STRING_H
+
+#include <prolog_common/Term.h>
+
+namespace prolog {
+  /** \brief Prolog string
+    * 
+    * A Prolog string holds a text value out-of-line. Unlike atoms, the
+    * text of a string is not interned, neither by the Prolog symbol
+    * table nor by the atom table of the underlying Prolog engine. Use
+    * strings for free-form and frequently changing text.
+    */
+  class String :
+    public Term {
+  public:
+    /** \brief Default constructor
+      */
+    String(const char* value = "");
+    
+    /** \brief Constructor (overloaded version taking a string value)
+      */
+    String(const std::string& value);
+    
+    /** \brief Constructor (overloaded version moving from a string
+      *   value)
+      */
+    String(std::string&& value);
+    
+    /** \brief Copy constructor
+      */
+    String(const String& src);
+    
+    /** \brief Copy constructor (overloaded version taking a term)
+      */
+    String(const Term& src);
+    
+    /** \brief Destructor
+      */
+    ~String();
+    
+    /** \brief Retrieve the value of this Prolog string
+      */
+    const std::string& getValue() const;
+    
+  protected:
+    friend class Term;
+    
+    /** \brief Prolog string (implementation)
+      */
+    class Impl :
+      public Term::Impl {
+    public:
+      Impl(const std::string& value);
+      Impl(std::string&& value);
+      virtual ~Impl();
+      
+      std::string value_;
+    };
+  };
+};
+
+#endif
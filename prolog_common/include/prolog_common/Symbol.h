@@ -0,0 +1,99 @@
+/******************************************************************************
+ * Copyright (C) 2016 by Ralf Kaestner                                        *
+ * ralf.kaestner@gmail.com                                                    *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the               *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+/** \file Symbol.h
+  * \brief Header file providing the Symbol class interface
+  */
+
+#ifndef ROS_PROLOG_SYMBOL_H
+#define ROS_PROLOG_SYMBOL_H
+
+#include <iostream>
+#include <string>
+
+#include <stdint.h>
+
+namespace prolog {
+  /** \brief Prolog symbol
+    * 
+    * A Prolog symbol is a lightweight handle to an atom name which has
+    * been interned in the process-wide symbol table. Symbols compare
+    * and hash by identifier.
+    */
+  class Symbol {
+  public:
+    /** \brief Default constructor
+      */
+    Symbol();
+      
+    /** \brief Constructor (overloaded version taking a name which will
+      *   be interned)
+      */
+    explicit Symbol(const std::string& name);
+    
+    /** \brief Copy constructor
+      */
+    Symbol(const Symbol& src);
+    
+    /** \brief Destructor
+      */
+    ~Symbol();
+    
+    /** \brief Retrieve the identifier of this Prolog symbol
+      */
+    size_t getIdentifier() const;
+    
+    /** \brief Retrieve the name of this Prolog symbol
+      */
+    const std::string& getName() const;
+    
+    /** \brief True, if this Prolog symbol is valid
+      */
+    bool isValid() const;
+    
+    /** \brief Create a Prolog symbol from the identifier of an interned
+      *   atom
+      */
+    static Symbol fromIdentifier(size_t identifier);
+    
+    /** \brief Binary operator for comparing this Prolog symbol with
+      *   another Prolog symbol for equality
+      */
+    bool operator==(const Symbol& symbol) const;
+    
+    /** \brief Binary operator for comparing this Prolog symbol with
+      *   another Prolog symbol for inequality
+      */
+    bool operator!=(const Symbol& symbol) const;
+    
+  private:
+    /** \brief The identifier of this Prolog symbol
+      */
+    uint32_t identifier_;
+  };
+  
+  /** \brief Compute the hash value of a Prolog symbol
+    */
+  size_t hash_value(const Symbol& symbol);
+  
+  /** \brief Operator for writing a Prolog symbol to a stream
+    */
+  std::ostream& operator<<(std::ostream& stream, const Symbol& symbol);
+};
+
+#endif
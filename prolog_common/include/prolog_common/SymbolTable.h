@@ -0,0 +1,111 @@
+/******************************************************************************
+ * Copyright (C) 2016 by Ralf Kaestner                                        *
+ * ralf.kaestner@gmail.com                                                    *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the               *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+/** \file SymbolTable.h
+  * \brief Header file providing the SymbolTable class interface
+  */
+
+#ifndef ROS_PROLOG_SYMBOL_TABLE_H
+#define ROS_PROLOG_SYMBOL_TABLE_H
+
+#include <string>
+
+#include <ros/exception.h>
+
+namespace prolog {
+  /** \brief Prolog symbol table
+    * 
+    * The symbol table interns atom names and functor name/arity pairs
+    * into small integer identifiers. It is process-wide and thread-safe.
+    * Interned symbols are never released, such that resolving an
+    * identifier does not require any locking.
+    * 
+    * \note The number of atoms and functors which can be interned is
+    *   bounded by the capacity of the symbol table. Since every distinct
+    *   atom name occupies an entry for the lifetime of the process,
+    *   free-form text such as messages or user input should be
+    *   represented as a prolog::String rather than as an atom.
+    */
+  class SymbolTable {
+  public:
+    /** \brief Exception thrown in case the capacity of the Prolog symbol
+      *   table has been exceeded
+      */ 
+    class CapacityExceeded :
+      public ros::Exception {
+    public:
+      CapacityExceeded(const std::string& what);
+    };
+      
+    /** \brief Intern an atom name and retrieve its identifier
+      */
+    static size_t internAtom(const std::string& name);
+    
+    /** \brief Look up the identifier of an atom name without interning it
+      * 
+      * \return True, if the atom name has been interned before.
+      */
+    static bool lookupAtom(const std::string& name, size_t& atom);
+    
+    /** \brief Retrieve the name of an interned atom
+      */
+    static const std::string& getAtomName(size_t atom);
+    
+    /** \brief Intern a functor name/arity pair and retrieve its
+      *   identifier
+      */
+    static size_t internFunctor(size_t atom, size_t arity);
+    
+    /** \brief Intern a functor name/arity pair and retrieve its
+      *   identifier (overloaded version taking a functor name)
+      */
+    static size_t internFunctor(const std::string& name, size_t arity);
+    
+    /** \brief Retrieve the name atom of an interned functor
+      */
+    static size_t getFunctorAtom(size_t functor);
+    
+    /** \brief Retrieve the arity of an interned functor
+      */
+    static size_t getFunctorArity(size_t functor);
+    
+    /** \brief Retrieve the maximum number of atoms and functors which
+      *   can be interned, respectively
+      */
+    static size_t getCapacity();
+    
+    /** \brief Retrieve the number of interned atoms
+      */
+    static size_t getNumAtoms();
+    
+    /** \brief Retrieve the number of interned functors
+      */
+    static size_t getNumFunctors();
+    
+  private:
+    /** \brief Prolog symbol table (implementation)
+      */
+    class Impl;
+    
+    /** \brief Retrieve the process-wide symbol table implementation
+      */
+    static Impl& getImpl();
+  };
+};
+
+#endif
@@ -23,8 +23,10 @@
 #ifndef ROS_PROLOG_TERM_H
 #define ROS_PROLOG_TERM_H
 
+#include <functional>
 #include <initializer_list>
 #include <list>
+#include <stdint.h>
 #include <string>
 #include <vector>
 
@@ -37,12 +39,38 @@ namespace prolog {
   class Integer;    
   class List;
   class Number;
+  class String;
+  class TermArena;
+  class TermVisitor;
   class Variable;
   
   /** \brief Prolog term
+    * 
+    * A Prolog term is represented by a type tag and an inline value for
+    * atomic terms. Atoms are stored inline as the identifier of their
+    * interned name. Only compound terms, lists, strings, and variables
+    * refer to an out-of-line implementation.
+    * 
+    * Prolog terms compare structurally and are ordered according to
+    * the standard order of terms. Their structural hash is cached per
+    * compound node, so that terms can be used as keys of hashed
+    * containers.
     */    
   class Term {
   public:
+    /** \brief Definition of the Prolog term type enumerable type
+      */
+    enum Type {
+      InvalidType,
+      AtomType,
+      CompoundType,
+      FloatType,
+      IntegerType,
+      ListType,
+      StringType,
+      VariableType
+    };
+    
     /** \brief Default constructor
       */
     Term();
@@ -77,6 +105,11 @@ namespace prolog {
       */
     Term(const std::list<Term>& elements);
     
+    /** \brief Constructor (overloaded version for constructing a
+      *   Prolog list by moving from a list of element terms)
+      */
+    Term(std::list<Term>&& elements);
+    
     /** \brief Constructor (overloaded version for constructing a
       *   Prolog list from an initializer list of element terms)
       */
@@ -88,6 +121,12 @@ namespace prolog {
       */
     Term(const std::string& functor, const std::vector<Term>& arguments);
     
+    /** \brief Constructor (overloaded version for constructing a
+      *   Prolog compound term from a functor and by moving from a vector
+      *   of argument terms)
+      */
+    Term(const std::string& functor, std::vector<Term>&& arguments);
+    
     /** \brief Constructor (overloaded version for constructing a
       *   Prolog compound term from a functor and an initializer list
       *   of a argument terms)
@@ -99,9 +138,17 @@ namespace prolog {
       */
     Term(const Term& src);
     
+    /** \brief Move constructor
+      */
+    Term(Term&& src);
+    
     /** \brief Destructor
       */
-    virtual ~Term();
+    ~Term();
+    
+    /** \brief Retrieve the type of this Prolog term
+      */
+    Type getType() const;
     
     /** \brief True, if this Prolog term is an atom
       */
@@ -119,6 +166,10 @@ namespace prolog {
       */
     bool isNumber() const;
     
+    /** \brief True, if this Prolog term is a string
+      */
+    bool isString() const;
+    
     /** \brief True, if this Prolog term is a variable
       */
     bool isVariable() const;
@@ -127,6 +178,62 @@ namespace prolog {
       */
     bool isValid() const;
     
+    /** \brief Retrieve the structural hash value of this Prolog term
+      * 
+      * The hash value of a compound term is computed once and cached
+      * with its implementation. Arguments modified through the mutable
+      * iterators of a compound term therefore invalidate the cached
+      * hash value of this compound term only, but not that of any
+      * enclosing term.
+      */
+    size_t getHash() const;
+    
+    /** \brief Compare this Prolog term with another Prolog term
+      *   according to the standard order of terms
+      * 
+      * Terms are ordered Variable < Number < Atom < String < Compound.
+      * Numbers are ordered by value, atoms and strings alphabetically,
+      * and compound terms by arity, name, and arguments. Variables are ordered by
+      * name. An empty list is ordered as the atom [], non-empty lists
+      * as compound terms with functor '[|]'/2. Invalid terms precede
+      * all valid terms.
+      * 
+      * \return A negative value, zero, or a positive value if this term
+      *   precedes, equals, or succeeds the other term.
+      */
+    int compare(const Term& term) const;
+    
+    /** \brief Accept a Prolog term visitor by dispatching this Prolog
+      *   term to its visit method for the type of the term
+      * 
+      * The arguments or elements of compound terms and lists are not
+      * visited. Use a Prolog term walker to traverse a term.
+      */
+    void accept(TermVisitor& visitor) const;
+    
+    /** \brief Assignment operator
+      */
+    Term& operator=(const Term& src);
+    
+    /** \brief Move assignment operator
+      */
+    Term& operator=(Term&& src);
+    
+    /** \brief Binary operator for comparing this Prolog term with
+      *   another Prolog term for structural equality
+      */
+    bool operator==(const Term& term) const;
+    
+    /** \brief Binary operator for comparing this Prolog term with
+      *   another Prolog term for structural inequality
+      */
+    bool operator!=(const Term& term) const;
+    
+    /** \brief Binary operator for comparing this Prolog term with
+      *   another Prolog term according to the standard order of terms
+      */
+    bool operator<(const Term& term) const;
+    
     /** \brief Binary operator for constructing a Prolog compound term
       *   using conjunction
       */
@@ -138,6 +245,9 @@ namespace prolog {
     Compound operator|(const Term& term) const;
     
   protected:
+    friend class TermArena;
+    friend class TermFactory;
+    
     /** \brief Prolog term (implementation)
       */
     class Impl {
@@ -146,10 +256,40 @@ namespace prolog {
       virtual ~Impl();
     };
     
-    /** \brief The Prolog term's implementation
+    /** \brief Prolog term value (inline payload of atomic terms)
+      */
+    union Value {
+      int64_t integer_;
+      double float_;
+      size_t atom_;
+    };
+    
+    /** \brief The Prolog term's type tag
+      */
+    Type type_;
+    
+    /** \brief The Prolog term's inline value
+      */
+    Value value_;
+    
+    /** \brief The Prolog term's out-of-line implementation
       */
     boost::shared_ptr<Impl> impl_;
   };
+  
+  /** \brief Compute the hash value of a Prolog term
+    */
+  size_t hash_value(const Term& term);
+};
+
+namespace std {
+  /** \brief Hash function specialization for Prolog terms
+    */
+  template <> struct hash<prolog::Term> {
+    size_t operator()(const prolog::Term& term) const {
+      return term.getHash();
+    }
+  };
 };
 
 #endif
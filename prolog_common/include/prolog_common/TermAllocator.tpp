@@ -0,0 +1,90 @@
+/******************************************************************************
+ * Copyright (C) 2016 by Ralf Kaestner                                        *
+ * ralf.kaestner@gmail.com                                                    *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the               *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+#include <utility>
+
+namespace prolog {
+
+/*****************************************************************************/
+/* Constructors and Destructor                                               */
+/*****************************************************************************/
+
+template <typename T> TermAllocator<T>::TermAllocator() :
+  arena_(0) {
+}
+
+template <typename T> TermAllocator<T>::TermAllocator(const TermArena&
+    arena) :
+  arena_(arena.impl_.get()) {
+}
+
+template <typename T> template <typename U> TermAllocator<T>::TermAllocator(
+    const TermAllocator<U>& src) :
+  arena_(src.arena_) {
+}
+
+/*****************************************************************************/
+/* Accessors                                                                 */
+/*****************************************************************************/
+
+template <typename T> size_t TermAllocator<T>::max_size() const {
+  return std::numeric_limits<size_t>::max()/sizeof(T);
+}
+
+/*****************************************************************************/
+/* Methods                                                                   */
+/*****************************************************************************/
+
+template <typename T> T* TermAllocator<T>::allocate(size_t n, const void*) {
+  if (arena_)
+    return static_cast<T*>(arena_->allocate(n*sizeof(T), alignof(T)));
+  else
+    return std::allocator<T>().allocate(n);
+}
+
+template <typename T> void TermAllocator<T>::deallocate(T* pointer, size_t
+    n) {
+  if (!arena_)
+    std::allocator<T>().deallocate(pointer, n);
+}
+
+template <typename T> template <typename U, typename... Args>
+void TermAllocator<T>::construct(U* pointer, Args&&... args) {
+  ::new(static_cast<void*>(pointer)) U(std::forward<Args>(args)...);
+}
+
+template <typename T> template <typename U>
+void TermAllocator<T>::destroy(U* pointer) {
+  pointer->~U();
+}
+
+/*****************************************************************************/
+/* Operators                                                                 */
+/*****************************************************************************/
+
+template <typename T> template <typename U>
+bool TermAllocator<T>::operator==(const TermAllocator<U>& allocator) const {
+  return (arena_ == allocator.arena_);
+}
+
+template <typename T> template <typename U>
+bool TermAllocator<T>::operator!=(const TermAllocator<U>& allocator) const {
+  return (arena_ != allocator.arena_);
+}
+
+}
@@ -0,0 +1,214 @@
+/******************************************************************************
+ * Copyright (C) 2016 by Ralf Kaestner                                        *
+ * ralf.kaestner@gmail.com                                                    *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the               *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+/** \file TermArena.h
+  * \brief Header file providing the TermArena class interface
+  */
+
+#ifndef ROS_PROLOG_TERM_ARENA_H
+#define ROS_PROLOG_TERM_ARENA_H
+
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/enable_shared_from_this.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <prolog_common/Term.h>
+
+namespace prolog {
+  template <typename T> class TermAllocator;
+  
+  /** \brief Prolog term arena
+    * 
+    * A Prolog term arena is a region allocator for building Prolog
+    * term graphs. The implementations of terms created by an arena are
+    * placed into large memory blocks owned by the arena and released in
+    * one shot together with the arena.
+    * 
+    * Terms created by an arena share ownership of the arena, such that
+    * the arena is released with the last of its terms. This includes
+    * copies of their arguments and elements. Within the arena, terms
+    * refer to each other without ownership, which would otherwise keep
+    * the arena alive forever. Terms created by an arena are therefore
+    * immutable, and modifying a list created by an arena copies the
+    * list to the heap. A term arena is not thread-safe.
+    */
+  class TermArena {
+  public:
+    /** \brief Default constructor
+      */
+    explicit TermArena(size_t blockSize = 16384);
+    
+    /** \brief Copy constructor
+      */
+    TermArena(const TermArena& src);
+    
+    /** \brief Destructor
+      */
+    ~TermArena();
+    
+    /** \brief Retrieve the block size of this Prolog term arena
+      */
+    size_t getBlockSize() const;
+    
+    /** \brief Retrieve the number of bytes allocated by this Prolog term
+      *   arena
+      */
+    size_t getNumBytes() const;
+    
+    /** \brief Create a Prolog compound term in this Prolog term arena
+      */
+    Compound createCompound(const std::string& functor, const
+      std::vector<Term>& arguments);
+    
+    /** \brief Create a Prolog list in this Prolog term arena
+      * 
+      * A list tail makes the list partial, whereas the elements of a
+      * list tail are shared with the created list.
+      */
+    List createList(const std::vector<Term>& elements, const Term& tail =
+      Term());
+    
+    /** \brief Create a Prolog variable in this Prolog term arena
+      */
+    Variable createVariable(const std::string& name);
+    
+  protected:
+    friend class List;
+    friend class Term;
+    template <typename T> friend class TermAllocator;
+    
+    /** \brief Prolog term arena (implementation)
+      */
+    class Impl :
+      public boost::enable_shared_from_this<Impl> {
+    public:
+      Impl(size_t blockSize);
+      ~Impl();
+      
+      void* allocate(size_t size, size_t alignment);
+      void* allocateTerm(size_t size, size_t alignment);
+      boost::shared_ptr<Term::Impl> adopt(Term::Impl* impl);
+      
+      static void store(Term& slot, const Term& term, const
+        boost::shared_ptr<Impl>& arena);
+      static boost::shared_ptr<Term::Impl> share(Term::Impl* impl);
+      
+      struct alignas(16) Header {
+        Term::Impl* impl_;
+        Header* next_;
+        Impl* arena_;
+      };
+      
+      size_t blockSize_;
+      size_t numBytes_;
+      
+      std::vector<char*> blocks_;
+      char* current_;
+      size_t available_;
+      
+      Header* headers_;
+    };
+    
+    /** \brief The Prolog term arena's implementation
+      */
+    boost::shared_ptr<Impl> impl_;
+  };
+  
+  /** \brief Prolog term allocator
+    * 
+    * The Prolog term allocator places the elements of term containers
+    * into a Prolog term arena. Without an arena, it falls back to the
+    * default heap allocator.
+    */
+  template <typename T> class TermAllocator {
+  public:
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+    
+    /** \brief Definition of the Prolog term allocator rebind type
+      */
+    template <typename U> struct rebind {
+      typedef TermAllocator<U> other;
+    };
+    
+    /** \brief Default constructor (allocating from the heap)
+      */
+    TermAllocator();
+    
+    /** \brief Constructor (overloaded version taking a Prolog term
+      *   arena to allocate from)
+      */
+    TermAllocator(const TermArena& arena);
+    
+    /** \brief Copy constructor
+      */
+    template <typename U> TermAllocator(const TermAllocator<U>& src);
+    
+    /** \brief Allocate storage for a number of elements
+      */
+    T* allocate(size_t n, const void* hint = 0);
+    
+    /** \brief Deallocate storage for a number of elements
+      */
+    void deallocate(T* pointer, size_t n);
+    
+    /** \brief Construct an element in allocated storage
+      */
+    template <typename U, typename... Args> void construct(U* pointer,
+      Args&&... args);
+    
+    /** \brief Destroy an element in allocated storage
+      */
+    template <typename U> void destroy(U* pointer);
+    
+    /** \brief Retrieve the maximum number of elements which can be
+      *   allocated
+      */
+    size_t max_size() const;
+    
+    /** \brief Binary operator for comparing this Prolog term allocator
+      *   with another Prolog term allocator for equality
+      */
+    template <typename U> bool operator==(const TermAllocator<U>&
+      allocator) const;
+    
+    /** \brief Binary operator for comparing this Prolog term allocator
+      *   with another Prolog term allocator for inequality
+      */
+    template <typename U> bool operator!=(const TermAllocator<U>&
+      allocator) const;
+    
+    /** \brief The Prolog term allocator's arena implementation (null
+      *   if allocating from the heap)
+      */
+    TermArena::Impl* arena_;
+  };
+};
+
+#include <prolog_common/TermAllocator.tpp>
+
+#endif
@@ -0,0 +1,128 @@
+/******************************************************************************
+ * Copyright (C) 2016 by Ralf Kaestner                                        *
+ * ralf.kaestner@gmail.com                                                    *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the               *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+/** \file TermFactory.h
+  * \brief Header file providing the TermFactory class interface
+  */
+
+#ifndef ROS_PROLOG_TERM_FACTORY_H
+#define ROS_PROLOG_TERM_FACTORY_H
+
+#include <string>
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/unordered_set.hpp>
+
+#include <prolog_common/Compound.h>
+#include <prolog_common/List.h>
+
+namespace prolog {
+  /** \brief Prolog term factory
+    * 
+    * A Prolog term factory hash-conses ground Prolog terms. Compound
+    * terms and lists whose arguments or elements are atomic or have
+    * themselves been created by the factory are looked up in a table of
+    * canonical instances, such that identical ground subterms share a
+    * single implementation. Non-ground terms are created as usual.
+    * 
+    * Canonical instances are shared by all their users, and modifying
+    * one through its iterators copies it first. Canonical instances which
+    * are no longer referenced outside the factory are evicted whenever
+    * the table has doubled in size since the last collection, or when
+    * collect() is called. Terms built into a Prolog term arena must not
+    * be passed to the factory. A term factory is thread-safe, and copies
+    * of it share the same table of canonical instances.
+    */
+  class TermFactory {
+  public:
+    /** \brief Default constructor
+      */
+    TermFactory();
+    
+    /** \brief Copy constructor
+      */
+    TermFactory(const TermFactory& src);
+    
+    /** \brief Destructor
+      */
+    ~TermFactory();
+    
+    /** \brief Retrieve the number of canonical Prolog terms held by this
+      *   Prolog term factory
+      */
+    size_t getNumTerms() const;
+    
+    /** \brief Create a Prolog compound term through this Prolog term
+      *   factory
+      */
+    Compound createCompound(const std::string& functor, const
+      std::vector<Term>& arguments);
+    
+    /** \brief Create a Prolog compound term through this Prolog term
+      *   factory (overloaded version moving from a vector of arguments)
+      */
+    Compound createCompound(const std::string& functor, std::vector<Term>&&
+      arguments);
+    
+    /** \brief Create a Prolog list through this Prolog term factory
+      */
+    List createList(std::vector<Term>&& elements, const Term& tail = Term());
+    
+    /** \brief Retrieve the canonical instance of a Prolog term
+      * 
+      * The term is rebuilt bottom-up through this factory, replacing all
+      * its ground subterms by their canonical instances.
+      */
+    Term canonicalize(const Term& term);
+    
+    /** \brief Release all canonical Prolog terms held by this Prolog term
+      *   factory which are not referenced elsewhere
+      */
+    void collect();
+    
+    /** \brief Release all canonical Prolog terms held by this Prolog term
+      *   factory
+      */
+    void clear();
+    
+  protected:
+    /** \brief Prolog term factory (implementation)
+      */
+    class Impl {
+    public:
+      Impl();
+      ~Impl();
+      
+      bool isCanonical(const Term& term) const;
+      Term intern(Term&& term);
+      void collect();
+      
+      mutable boost::mutex mutex_;
+      boost::unordered_set<Term> terms_;
+      size_t collectionThreshold_;
+    };
+    
+    /** \brief The Prolog term factory's implementation
+      */
+    boost::shared_ptr<Impl> impl_;
+  };
+};
+
+#endif
@@ -0,0 +1,96 @@
+/******************************************************************************
+ * Copyright (C) 2016 by Ralf Kaestner                                        *
+ * ralf.kaestner@gmail.com                                                    *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the               *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+/** \file TermVisitor.h
+  * \brief Header file providing the TermVisitor class interface
+  */
+
+#ifndef ROS_PROLOG_TERM_VISITOR_H
+#define ROS_PROLOG_TERM_VISITOR_H
+
+namespace prolog {
+  class Atom;
+  class Compound;
+  class Float;
+  class Integer;
+  class List;
+  class String;
+  class Variable;
+  
+  /** \brief Prolog term visitor
+    * 
+    * A Prolog term visitor is dispatched on the type of a Prolog term
+    * through Term::accept(). The default implementation of each visit
+    * method does nothing, such that subclasses only override the
+    * methods for the types of terms they are interested in.
+    * 
+    * When driven by a Prolog term walker, the visit methods of compound
+    * terms and lists are called before, and the leave methods after
+    * their arguments or elements have been visited.
+    */
+  class TermVisitor {
+  public:
+    /** \brief Default constructor
+      */
+    TermVisitor();
+    
+    /** \brief Destructor
+      */
+    virtual ~TermVisitor();
+    
+    /** \brief Visit a Prolog atom
+      */
+    virtual void visitAtom(const Atom& atom);
+    
+    /** \brief Visit a Prolog compound term
+      */
+    virtual void visitCompound(const Compound& compound);
+    
+    /** \brief Visit a Prolog float
+      */
+    virtual void visitFloat(const Float& number);
+    
+    /** \brief Visit a Prolog integer
+      */
+    virtual void visitInteger(const Integer& number);
+    
+    /** \brief Visit a Prolog list
+      */
+    virtual void visitList(const List& list);
+    
+    /** \brief Visit a Prolog string
+      */
+    virtual void visitString(const String& string);
+    
+    /** \brief Visit a Prolog variable
+      */
+    virtual void visitVariable(const Variable& variable);
+    
+    /** \brief Leave a Prolog compound term after its arguments have been
+      *   visited
+      */
+    virtual void leaveCompound(const Compound& compound);
+    
+    /** \brief Leave a Prolog list after its elements and its tail have
+      *   been visited
+      */
+    virtual void leaveList(const List& list);
+  };
+};
+
+#endif
@@ -0,0 +1,85 @@
+/******************************************************************************
+ * Copyright (C) 2016 by Ralf Kaestner                                        *
+ * ralf.kaestner@gmail.com                                                    *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the               *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+/** \file TermWalker.h
+  * \brief Header file providing the TermWalker class interface
+  */
+
+#ifndef ROS_PROLOG_TERM_WALKER_H
+#define ROS_PROLOG_TERM_WALKER_H
+
+#include <vector>
+
+#include <prolog_common/Compound.h>
+#include <prolog_common/List.h>
+#include <prolog_common/Term.h>
+#include <prolog_common/TermVisitor.h>
+
+namespace prolog {
+  /** \brief Prolog term walker
+    * 
+    * A Prolog term walker traverses a Prolog term depth-first and
+    * dispatches each of its subterms to a Prolog term visitor. The
+    * traversal is iterative and keeps its state in an explicit stack,
+    * such that deeply nested terms, e.g., long chains of conjunctions,
+    * do not overflow the call stack. The elements of a partial list are
+    * followed by its tail.
+    * 
+    * The stack is retained between walks. A term walker is thus not
+    * thread-safe, but may be reused without further allocations.
+    */
+  class TermWalker {
+  public:
+    /** \brief Default constructor
+      */
+    TermWalker();
+    
+    /** \brief Copy constructor
+      */
+    TermWalker(const TermWalker& src);
+    
+    /** \brief Destructor
+      */
+    ~TermWalker();
+    
+    /** \brief Walk a Prolog term with a Prolog term visitor
+      */
+    void walk(const Term& term, TermVisitor& visitor);
+    
+  protected:
+    /** \brief Prolog term walker stack frame
+      */
+    struct Frame {
+      Frame(const Term& term);
+      
+      Term term_;
+      Compound::ConstIterator argument_;
+      Compound::ConstIterator argumentsEnd_;
+      List::ConstIterator element_;
+      List::ConstIterator elementsEnd_;
+      bool entered_;
+      bool tail_;
+    };
+    
+    /** \brief The stack of this Prolog term walker
+      */
+    std::vector<Frame> frames_;
+  };
+};
+
+#endif
@@ -0,0 +1,239 @@
+/******************************************************************************
+ * Copyright (C) 2016 by Ralf Kaestner                                        *
+ * ralf.kaestner@gmail.com                                                    *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the               *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+/** \file TypedQuery.h
+  * \brief Header file providing the TypedQuery class interface
+  */
+
+#ifndef ROS_PROLOG_TYPED_QUERY_H
+#define ROS_PROLOG_TYPED_QUERY_H
+
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <boost/type_traits.hpp>
+#include <boost/utility/enable_if.hpp>
+
+#include <prolog_common/Query.h>
+#include <prolog_common/Solution.h>
+#include <prolog_common/SolutionAccessor.h>
+#include <prolog_common/Symbol.h>
+
+namespace prolog {
+  /** \brief Prolog typed query output argument
+    * 
+    * The output argument marks an argument of a typed query as a
+    * variable, the bound value of which is decoded into a value of
+    * type T.
+    */
+  template <typename T> struct Output {
+    typedef T Type;
+  };
+  
+  /** \brief Prolog typed query argument traits
+    * 
+    * The argument traits statically map the type of a typed query
+    * argument to the kind of Prolog term representing it.
+    */
+  template <typename T, typename Enable = void> struct TypedArgument;
+  
+  /** \brief Prolog typed query argument traits (specialization for
+    *   string arguments represented by atoms)
+    */
+  template <typename T> struct TypedArgument<T, typename boost::enable_if<
+      boost::is_base_of<std::string, T> >::type> {
+    typedef T Input;
+    static const Term::Type type = Term::AtomType;
+    static Term toTerm(const T& value, size_t index);
+  };
+  
+  /** \brief Prolog typed query argument traits (specialization for
+    *   integral arguments represented by integers)
+    */
+  template <typename T> struct TypedArgument<T, typename boost::enable_if<
+      boost::is_integral<T> >::type> {
+    typedef T Input;
+    static const Term::Type type = Term::IntegerType;
+    static Term toTerm(const T& value, size_t index);
+  };
+  
+  /** \brief Prolog typed query argument traits (specialization for
+    *   floating point arguments represented by floats)
+    */
+  template <typename T> struct TypedArgument<T, typename boost::enable_if<
+      boost::is_floating_point<T> >::type> {
+    typedef T Input;
+    static const Term::Type type = Term::FloatType;
+    static Term toTerm(const T& value, size_t index);
+  };
+  
+  /** \brief Prolog typed query argument traits (specialization for
+    *   output arguments represented by variables)
+    */
+  template <typename T> struct TypedArgument<Output<T> > {
+    typedef Output<T> Input;
+    static const Term::Type type = Term::VariableType;
+    static Term toTerm(const Output<T>& value, size_t index);
+  };
+  
+  /** \brief Prolog typed query result
+    * 
+    * The result of a typed query is a tuple holding the value types of
+    * its output arguments in order.
+    */
+  template <typename... Args> struct TypedResult;
+  
+  template <> struct TypedResult<> {
+    typedef std::tuple<> Type;
+  };
+  
+  template <typename A, typename... Args> struct TypedResult<A, Args...> {
+    typedef typename TypedResult<Args...>::Type Type;
+  };
+  
+  template <typename T, typename... Args> struct TypedResult<Output<T>,
+      Args...> {
+    typedef decltype(std::tuple_cat(std::declval<std::tuple<T> >(),
+      std::declval<typename TypedResult<Args...>::Type>())) Type;
+  };
+  
+  /** \brief Prolog typed query field schema
+    * 
+    * Specialize the field schema to decode the solutions of a typed
+    * query into a user-defined structure. The specialization must
+    * provide a static getFields() function which returns a tuple of
+    * pointers to the members of the structure, in the order of the
+    * output arguments of the query.
+    */
+  template <class S> struct FieldSchema;
+  
+  /** \brief Prolog typed query
+    * 
+    * A typed query fixes the functor name and arity of a Prolog query
+    * at compile time. The functor F is required to provide a static
+    * getName() function. Each argument type in Args is statically mapped
+    * to a kind of Prolog term, where Output<T> declares a variable.
+    * 
+    * The solutions of a typed query are decoded directly from the
+    * slots of their bindings into a tuple or a user-defined structure,
+    * without name lookups once the slots have been cached for the
+    * bindings schema of the query. Decoding is not thread-safe.
+    */
+  template <class F, typename... Args> class TypedQuery :
+    public Query {
+  public:
+    /** \brief Definition of the Prolog typed query result type
+      */
+    typedef typename TypedResult<Args...>::Type Result;
+    
+    /** \brief Constructor
+      * 
+      * Output arguments are passed as empty Output<T> values, e.g., as
+      * {}.
+      */
+    TypedQuery(const typename TypedArgument<Args>::Input&... arguments);
+    
+    /** \brief Copy constructor
+      */
+    TypedQuery(const TypedQuery<F, Args...>& src);
+    
+    /** \brief Destructor
+      */
+    virtual ~TypedQuery();
+    
+    /** \brief Retrieve the result of this Prolog typed query from a
+      *   Prolog solution
+      */
+    Result getResult(const Solution& solution) const;
+    
+    /** \brief Retrieve the result of this Prolog typed query from a
+      *   Prolog solution (overloaded version decoding into a result
+      *   tuple)
+      */
+    void getResult(const Solution& solution, Result& result) const;
+    
+    /** \brief Retrieve the result of this Prolog typed query from a
+      *   Prolog solution (overloaded version decoding into a structure
+      *   with a field schema)
+      */
+    template <class S> void getResult(const Solution& solution, S& result)
+      const;
+    
+  protected:
+    /** \brief Compile-time sequence of indices
+      */
+    template <size_t... I> struct Indices {
+    };
+    
+    /** \brief Compile-time generator of a sequence of indices
+      */
+    template <size_t N, size_t... I> struct MakeIndices :
+      MakeIndices<N-1, N-1, I...> {
+    };
+    
+    template <size_t... I> struct MakeIndices<0, I...> {
+      typedef Indices<I...> Type;
+    };
+    
+    /** \brief Compile-time mapping of a result tuple to a tuple of
+      *   solution accessors
+      */
+    template <class R> struct Accessors;
+    
+    template <typename... T> struct Accessors<std::tuple<T...> > {
+      typedef std::tuple<SolutionAccessor<T>...> Type;
+    };
+    
+    /** \brief The number of output arguments of this Prolog typed query
+      */
+    static const size_t numOutputs = std::tuple_size<Result>::value;
+    
+    /** \brief Create the arguments of this Prolog typed query
+      */
+    template <size_t... I> static std::vector<Term> createArguments(
+      Indices<I...>, const typename TypedArgument<Args>::Input&...
+      arguments);
+    
+    /** \brief Create the solution accessors of this Prolog typed query
+      *   from the variable arguments of the query
+      */
+    template <size_t... I> static typename Accessors<Result>::Type
+      createAccessors(const std::vector<Term>& arguments, Indices<I...>);
+    
+    /** \brief Decode a Prolog solution into a result tuple
+      */
+    template <size_t... I> void decodeResult(const Solution& solution,
+      Result& result, Indices<I...>) const;
+    
+    /** \brief Decode a Prolog solution into a structure with a field
+      *   schema
+      */
+    template <class S, size_t... I> void decodeFields(const Solution&
+      solution, S& result, Indices<I...>) const;
+    
+    /** \brief The solution accessors of this Prolog typed query
+      */
+    typename Accessors<Result>::Type accessors_;
+  };
+};
+
+#include <prolog_common/TypedQuery.tpp>
+
+#endif
@@ -0,0 +1,141 @@
+/******************************************************************************
+ * Copyright (C) 2016 by Ralf Kaestner                                        *
+ * ralf.kaestner@gmail.com                                                    *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the               *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+#include <prolog_common/Atom.h>
+#include <prolog_common/Float.h>
+#include <prolog_common/Integer.h>
+#include <prolog_common/Variable.h>
+
+namespace prolog {
+
+/*****************************************************************************/
+/* Constructors and Destructor                                               */
+/*****************************************************************************/
+
+template <class F, typename... Args> TypedQuery<F, Args...>::TypedQuery(
+    const typename TypedArgument<Args>::Input&... arguments) :
+  Query(F::getName(), createArguments(typename MakeIndices<sizeof...(Args)>::
+    Type(), arguments...)),
+  accessors_(createAccessors(getArguments(), typename MakeIndices<
+    numOutputs>::Type())) {
+}
+
+template <class F, typename... Args> TypedQuery<F, Args...>::TypedQuery(
+    const TypedQuery<F, Args...>& src) :
+  Query(src),
+  accessors_(src.accessors_) {
+}
+
+template <class F, typename... Args> TypedQuery<F, Args...>::~TypedQuery() {
+}
+
+/*****************************************************************************/
+/* Accessors                                                                 */
+/*****************************************************************************/
+
+template <class F, typename... Args> typename TypedQuery<F, Args...>::Result
+    TypedQuery<F, Args...>::getResult(const Solution& solution) const {
+  Result result;
+  
+  getResult(solution, result);
+  
+  return result;
+}
+
+template <class F, typename... Args> void TypedQuery<F, Args...>::getResult(
+    const Solution& solution, Result& result) const {
+  decodeResult(solution, result, typename MakeIndices<numOutputs>::Type());
+}
+
+template <class F, typename... Args> template <class S> void
+    TypedQuery<F, Args...>::getResult(const Solution& solution, S& result)
+    const {
+  decodeFields(solution, result, typename MakeIndices<numOutputs>::Type());
+}
+
+/*****************************************************************************/
+/* Methods                                                                   */
+/*****************************************************************************/
+
+template <typename T> Term TypedArgument<T, typename boost::enable_if<
+    boost::is_base_of<std::string, T> >::type>::toTerm(const T& value,
+    size_t index) {
+  return Atom(value);
+}
+
+template <typename T> Term TypedArgument<T, typename boost::enable_if<
+    boost::is_integral<T> >::type>::toTerm(const T& value, size_t index) {
+  return Integer(static_cast<int64_t>(value));
+}
+
+template <typename T> Term TypedArgument<T, typename boost::enable_if<
+    boost::is_floating_point<T> >::type>::toTerm(const T& value, size_t
+    index) {
+  return Float(value);
+}
+
+template <typename T> Term TypedArgument<Output<T> >::toTerm(const
+    Output<T>& value, size_t index) {
+  return Variable("V"+std::to_string(index));
+}
+
+template <class F, typename... Args> template <size_t... I>
+    std::vector<Term> TypedQuery<F, Args...>::createArguments(Indices<I...>,
+    const typename TypedArgument<Args>::Input&... arguments) {
+  return std::vector<Term>{TypedArgument<Args>::toTerm(arguments, I)...};
+}
+
+template <class F, typename... Args> template <size_t... I>
+    typename TypedQuery<F, Args...>::template Accessors<typename
+    TypedQuery<F, Args...>::Result>::Type TypedQuery<F, Args...>::
+    createAccessors(const std::vector<Term>& arguments, Indices<I...>) {
+  std::vector<Symbol> names;
+  
+  for (std::vector<Term>::const_iterator it = arguments.begin();
+      it != arguments.end(); ++it)
+    if (it->isVariable())
+      names.push_back(Symbol(Variable(*it).getName()));
+  
+  return typename Accessors<Result>::Type(typename std::tuple_element<I,
+    typename Accessors<Result>::Type>::type(names[I])...);
+}
+
+template <class F, typename... Args> template <size_t... I> void
+    TypedQuery<F, Args...>::decodeResult(const Solution& solution, Result&
+    result, Indices<I...>) const {
+  int expansion[] = {0, (std::get<I>(result) = std::get<I>(accessors_).
+    getValue(solution), 0)...};
+  
+  (void)expansion;
+}
+
+template <class F, typename... Args> template <class S, size_t... I> void
+    TypedQuery<F, Args...>::decodeFields(const Solution& solution, S& result,
+    Indices<I...>) const {
+  auto fields = FieldSchema<S>::getFields();
+  
+  static_assert(std::tuple_size<decltype(fields)>::value == numOutputs,
+    "Number of fields does not match the number of output arguments.");
+  
+  int expansion[] = {0, (result.*std::get<I>(fields) = std::get<I>(
+    accessors_).getValue(solution), 0)...};
+  
+  (void)expansion;
+}
+
+}
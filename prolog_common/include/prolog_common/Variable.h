@@ -49,11 +49,11 @@ namespace prolog {
     
     /** \brief Destructor
       */
-    virtual ~Variable();
+    ~Variable();
     
     /** \brief Retrieve the name of this Prolog variable
       */
-    std::string getName() const;
+    const std::string& getName() const;
     
     /** \brief True, if this Prolog variable is anonymous
       */
@@ -61,6 +61,7 @@ namespace prolog {
     
   protected:
     friend class Term;
+    friend class TermArena;
     
     /** \brief Prolog variable (implementation)
       */
@@ -16,6 +16,8 @@
  * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
  ******************************************************************************/
 
+#include <prolog_common/SymbolTable.h>
+
 #include "prolog_common/Atom.h"
 
 namespace prolog {
@@ -29,7 +31,13 @@ Atom::Atom(const char* name) :
 }
 
 Atom::Atom(const std::string& name) {
-  impl_.reset(new Impl(name));
+  type_ = AtomType;
+  value_.atom_ = SymbolTable::internAtom(name);
+}
+
+Atom::Atom(const Symbol& symbol) {
+  type_ = AtomType;
+  value_.atom_ = symbol.getIdentifier();
 }
 
 Atom::Atom(const Atom& src) :
@@ -38,25 +46,22 @@ Atom::Atom(const Atom& src) :
 
 Atom::Atom(const Term& src) :
   Term(src) {
-  BOOST_ASSERT(boost::dynamic_pointer_cast<Impl>(impl_));
+  BOOST_ASSERT(isAtom());
 }
 
 Atom::~Atom() {  
 }
 
-Atom::Impl::Impl(const std::string& name) :
-  name_(name) {
-}
-
-Atom::Impl::~Impl() {
-}
-
 /*****************************************************************************/
 /* Accessors                                                                 */
 /*****************************************************************************/
 
-std::string Atom::getName() const {
-  return boost::static_pointer_cast<Impl>(impl_)->name_;
+const std::string& Atom::getName() const {
+  return SymbolTable::getAtomName(value_.atom_);
+}
+
+Symbol Atom::getSymbol() const {
+  return Symbol::fromIdentifier(value_.atom_);
 }
 
 }
@@ -16,6 +16,10 @@
  * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
  ******************************************************************************/
 
+#include <boost/functional/hash.hpp>
+
+#include <prolog_common/SymbolTable.h>
+
 #include "prolog_common/Bindings.h"
 
 namespace prolog {
@@ -28,6 +32,23 @@ Bindings::Bindings() :
   impl_(new Impl()) {
 }
 
+Bindings::Bindings(const TermArena& arena) :
+  impl_(new Impl(BindingsSchema(), arena)) {
+}
+
+Bindings::Bindings(const BindingsSchema& schema) :
+  impl_(new Impl(schema)) {
+}
+
+Bindings::Bindings(const BindingsSchema& schema, const TermArena& arena) :
+  impl_(new Impl(schema, arena)) {
+}
+
+Bindings::Bindings(const BindingsSchema& schema, const boost::shared_ptr<
+    const Materializer>& materializer) :
+  impl_(new Impl(schema, materializer)) {
+}
+
 Bindings::Bindings(const Bindings& src) :
   impl_(src.impl_) {
 }
@@ -35,7 +56,54 @@ Bindings::Bindings(const Bindings& src) :
 Bindings::~Bindings() {  
 }
 
-Bindings::Impl::Impl() {
+Bindings::Materializer::~Materializer() {
+}
+
+Bindings::ConstIterator::ConstIterator() :
+  impl_(0),
+  slot_(0) {
+}
+
+Bindings::ConstIterator::ConstIterator(const Impl* impl, size_t slot) :
+  impl_(impl),
+  slot_(slot) {
+  while ((slot_ < impl_->terms_.size()) && !impl_->isBound(slot_))
+    ++slot_;
+}
+
+Bindings::Impl::Impl(const BindingsSchema& schema) :
+  schema_(schema),
+  terms_(schema.getNumSlots()),
+  numTerms_(0),
+  numPending_(0) {
+}
+
+Bindings::Impl::Impl(const BindingsSchema& schema, const TermArena& arena) :
+  schema_(schema),
+  terms_(schema.getNumSlots()),
+  numTerms_(0),
+  arena_(new TermArena(arena)),
+  numPending_(0) {
+}
+
+Bindings::Impl::Impl(const BindingsSchema& schema, const boost::shared_ptr<
+    const Materializer>& materializer) :
+  schema_(schema),
+  terms_(schema.getNumSlots()),
+  numTerms_(0),
+  materializer_(materializer),
+  pending_(schema.getNumSlots(), false),
+  numPending_(0) {
+  BOOST_ASSERT(materializer);
+  
+  for (size_t slot = 0; slot < pending_.size(); ++slot) {
+    if (materializer->isBound(slot)) {
+      pending_[slot] = true;
+      
+      ++numTerms_;
+      ++numPending_;
+    }
+  }
 }
 
 Bindings::Impl::~Impl() {
@@ -46,59 +114,202 @@ Bindings::Impl::~Impl() {
 /*****************************************************************************/
 
 Term Bindings::getTerm(const std::string& name) const {
-  boost::unordered_map<std::string, Term>::const_iterator it =
-    impl_->terms_.find(name);
+  size_t atom;
+  
+  if (SymbolTable::lookupAtom(name, atom))
+    return getTerm(Symbol::fromIdentifier(atom));
+  else
+    return Term();
+}
+
+Term Bindings::getTerm(const Symbol& name) const {
+  size_t slot;
   
-  if (it != impl_->terms_.end())
-    return it->second;
+  if (impl_->schema_.lookupSlot(name, slot))
+    return getTerm(slot);
+  else
+    return Term();
+}
+
+Term Bindings::getTerm(size_t slot) const {
+  if (slot < impl_->terms_.size())
+    return impl_->getTerm(slot);
   else
     return Term();
 }
 
+const BindingsSchema& Bindings::getSchema() const {
+  return impl_->schema_;
+}
+
+size_t Bindings::getNumTerms() const {
+  return impl_->numTerms_;
+}
+
 bool Bindings::contain(const std::string& name) const {
-  return (impl_->terms_.find(name) != impl_->terms_.end());
+  size_t atom;
+  
+  if (SymbolTable::lookupAtom(name, atom))
+    return contain(Symbol::fromIdentifier(atom));
+  else
+    return false;
+}
+
+bool Bindings::contain(const Symbol& name) const {
+  size_t slot;
+  
+  return impl_->schema_.lookupSlot(name, slot) &&
+    (slot < impl_->terms_.size()) && impl_->isBound(slot);
+}
+
+bool Bindings::isArenaBacked() const {
+  return impl_->arena_.get();
+}
+
+bool Bindings::areLazy() const {
+  return impl_->numPending_;
 }
 
 bool Bindings::areEmpty() const {
-  return impl_->terms_.empty();
+  return !impl_->numTerms_;
+}
+
+size_t Bindings::getHash() const {
+  size_t hash = 0;
+  
+  for (ConstIterator it = begin(); it != end(); ++it) {
+    size_t entryHash = hash_value(it->first);
+    
+    boost::hash_combine(entryHash, it->second.getHash());
+    hash += entryHash;
+  }
+  
+  return hash;
+}
+
+bool Bindings::Impl::isBound(size_t slot) const {
+  return terms_[slot].isValid() || ((slot < pending_.size()) &&
+    pending_[slot]);
+}
+
+const Term& Bindings::Impl::getTerm(size_t slot) const {
+  if ((slot < pending_.size()) && pending_[slot]) {
+    terms_[slot] = materializer_->materialize(slot);
+    pending_[slot] = false;
+    
+    if (!--numPending_)
+      pending_.clear();
+  }
+  
+  return terms_[slot];
 }
 
 /*****************************************************************************/
 /* Methods                                                                   */
 /*****************************************************************************/
 
-boost::unordered_map<std::string, Term>::iterator Bindings::begin() {
-  return impl_->terms_.begin();
+Bindings::ConstIterator Bindings::begin() const {
+  return ConstIterator(impl_.get(), 0);
 }
 
-boost::unordered_map<std::string, Term>::const_iterator Bindings::begin()
-    const {
-  return impl_->terms_.begin();
+Bindings::ConstIterator Bindings::end() const {
+  return ConstIterator(impl_.get(), impl_->terms_.size());
 }
 
-boost::unordered_map<std::string, Term>::iterator Bindings::end() {
-  return impl_->terms_.end();
+void Bindings::ConstIterator::increment() {
+  ++slot_;
+  
+  while ((slot_ < impl_->terms_.size()) && !impl_->isBound(slot_))
+    ++slot_;
 }
 
-boost::unordered_map<std::string, Term>::const_iterator Bindings::end()
-    const {
-  return impl_->terms_.end();
+void Bindings::addTerm(const std::string& name, const Term& term) {
+  addTerm(Symbol(name), term);
 }
 
-void Bindings::addTerm(const std::string& name, const Term& term) {
-  impl_->terms_.insert(std::make_pair(name, term));
+void Bindings::addTerm(const Symbol& name, const Term& term) {
+  size_t slot = impl_->schema_.addSymbol(name);
+  
+  if ((slot >= impl_->terms_.size()) || !impl_->isBound(slot))
+    setTerm(slot, term);
+}
+
+void Bindings::setTerm(size_t slot, const Term& term) {
+  setTerm(slot, Term(term));
+}
+
+void Bindings::setTerm(size_t slot, Term&& term) {
+  BOOST_ASSERT(slot < impl_->schema_.getNumSlots());
+  
+  if (slot >= impl_->terms_.size())
+    impl_->terms_.resize(impl_->schema_.getNumSlots());
+  
+  if (impl_->isBound(slot))
+    --impl_->numTerms_;
+  if (term.isValid())
+    ++impl_->numTerms_;
+  
+  if ((slot < impl_->pending_.size()) && impl_->pending_[slot]) {
+    impl_->pending_[slot] = false;
+    
+    if (!--impl_->numPending_)
+      impl_->pending_.clear();
+  }
+  
+  impl_->terms_[slot] = std::move(term);
 }
 
 void Bindings::clear() {
-  impl_->terms_.clear();
+  impl_->terms_.assign(impl_->terms_.size(), Term());
+  impl_->numTerms_ = 0;
+  
+  impl_->pending_.clear();
+  impl_->numPending_ = 0;
+  impl_->materializer_.reset();
 }
 
 /*****************************************************************************/
 /* Operators                                                                 */
 /*****************************************************************************/
 
+bool Bindings::ConstIterator::equal(const ConstIterator& iterator) const {
+  return (slot_ == iterator.slot_) && (impl_ == iterator.impl_);
+}
+
+std::pair<const Symbol&, const Term&> Bindings::ConstIterator::dereference()
+    const {
+  return std::pair<const Symbol&, const Term&>(
+    impl_->schema_.getSymbol(slot_), impl_->getTerm(slot_));
+}
+
 Term Bindings::operator[](const std::string& name) const {
   return getTerm(name);
 }
 
+bool Bindings::operator==(const Bindings& bindings) const {
+  if (impl_ == bindings.impl_)
+    return true;
+  else if (impl_->numTerms_ != bindings.impl_->numTerms_)
+    return false;
+  
+  for (ConstIterator it = begin(); it != end(); ++it) {
+    size_t slot;
+    
+    if (!bindings.impl_->schema_.lookupSlot(it->first, slot) ||
+        (slot >= bindings.impl_->terms_.size()) ||
+        (bindings.impl_->getTerm(slot) != it->second))
+      return false;
+  }
+  
+  return true;
+}
+
+bool Bindings::operator!=(const Bindings& bindings) const {
+  return !operator==(bindings);
+}
+
+size_t hash_value(const Bindings& bindings) {
+  return bindings.getHash();
+}
+
 }
@@ -0,0 +1,114 @@
+/******************************************************************************
+ * Copyright (C) 2016 by Ralf Kaestner                                        *
+ * ralf.kaestner@gmail.com                                                    *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the               *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+#include "prolog_common/BindingsSchema.h"
+
+namespace prolog {
+
+/*****************************************************************************/
+/* Constructors and Destructor                                               */
+/*****************************************************************************/
+
+BindingsSchema::BindingsSchema() :
+  impl_(new Impl()) {
+}
+
+BindingsSchema::BindingsSchema(const std::vector<Symbol>& symbols) :
+  impl_(new Impl(symbols)) {
+}
+
+BindingsSchema::BindingsSchema(const BindingsSchema& src) :
+  impl_(src.impl_) {
+}
+
+BindingsSchema::~BindingsSchema() {
+}
+
+BindingsSchema::Impl::Impl() {
+}
+
+BindingsSchema::Impl::Impl(const std::vector<Symbol>& symbols) {
+  for (std::vector<Symbol>::const_iterator it = symbols.begin();
+      it != symbols.end(); ++it) {
+    if (slots_.insert(std::make_pair(*it, symbols_.size())).second)
+      symbols_.push_back(*it);
+  }
+}
+
+BindingsSchema::Impl::~Impl() {
+}
+
+/*****************************************************************************/
+/* Accessors                                                                 */
+/*****************************************************************************/
+
+size_t BindingsSchema::getNumSlots() const {
+  return impl_->symbols_.size();
+}
+
+const Symbol& BindingsSchema::getSymbol(size_t slot) const {
+  return impl_->symbols_[slot];
+}
+
+bool BindingsSchema::lookupSlot(const Symbol& symbol, size_t& slot) const {
+  boost::unordered_map<Symbol, size_t>::const_iterator it =
+    impl_->slots_.find(symbol);
+  
+  if (it != impl_->slots_.end()) {
+    slot = it->second;
+    return true;
+  }
+  else
+    return false;
+}
+
+/*****************************************************************************/
+/* Methods                                                                   */
+/*****************************************************************************/
+
+size_t BindingsSchema::addSymbol(const Symbol& symbol) {
+  size_t slot;
+  
+  if (lookupSlot(symbol, slot))
+    return slot;
+  
+  if (impl_.use_count() > 1)
+    impl_.reset(new Impl(impl_->symbols_));
+  
+  slot = impl_->symbols_.size();
+  
+  impl_->symbols_.push_back(symbol);
+  impl_->slots_.insert(std::make_pair(symbol, slot));
+  
+  return slot;
+}
+
+/*****************************************************************************/
+/* Operators                                                                 */
+/*****************************************************************************/
+
+bool BindingsSchema::operator==(const BindingsSchema& schema) const {
+  return (impl_ == schema.impl_) ||
+    (impl_->symbols_ == schema.impl_->symbols_);
+}
+
+bool BindingsSchema::operator!=(const BindingsSchema& schema) const {
+  return !operator==(schema);
+}
+
+}
@@ -0,0 +1,424 @@
+/******************************************************************************
+ * Copyright (C) 2016 by Ralf Kaestner                                        *
+ * ralf.kaestner@gmail.com                                                    *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the               *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+#include <cstring>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include <prolog_common/Atom.h>
+#include <prolog_common/Compound.h>
+#include <prolog_common/Float.h>
+#include <prolog_common/Integer.h>
+#include <prolog_common/List.h>
+#include <prolog_common/String.h>
+#include <prolog_common/Variable.h>
+
+#include "prolog_common/BindingsSnapshot.h"
+
+namespace prolog {
+
+/*****************************************************************************/
+/* Constructors and Destructor                                               */
+/*****************************************************************************/
+
+BindingsSnapshot::DecodingError::DecodingError(const std::string&
+    description) :
+  ros::Exception("Failure to decode bindings snapshot: "+description) {
+}
+
+BindingsSnapshot::BindingsSnapshot() {
+}
+
+BindingsSnapshot::BindingsSnapshot(const BindingsSchema& schema) :
+  impl_(new Impl(schema)) {
+}
+
+BindingsSnapshot::BindingsSnapshot(const BindingsSnapshot& src) :
+  impl_(src.impl_) {
+}
+
+BindingsSnapshot::~BindingsSnapshot() {
+}
+
+BindingsSnapshot::Impl::Impl(const BindingsSchema& schema) :
+  schema_(schema) {
+}
+
+BindingsSnapshot::Impl::~Impl() {
+}
+
+/*****************************************************************************/
+/* Accessors                                                                 */
+/*****************************************************************************/
+
+const BindingsSchema& BindingsSnapshot::getSchema() const {
+  static BindingsSchema schema;
+  
+  if (impl_.get())
+    return impl_->schema_;
+  else
+    return schema;
+}
+
+size_t BindingsSnapshot::getSize() const {
+  if (impl_.get())
+    return impl_->buffer_.size();
+  else
+    return 0;
+}
+
+bool BindingsSnapshot::isValid() const {
+  return impl_.get();
+}
+
+/*****************************************************************************/
+/* Methods                                                                   */
+/*****************************************************************************/
+
+void BindingsSnapshot::beginBindings(const BindingsSchema& schema) {
+  impl_.reset(new Impl(schema));
+}
+
+void BindingsSnapshot::putUnbound() {
+  BOOST_ASSERT(impl_.get());
+  
+  impl_->putTag('u');
+}
+
+void BindingsSnapshot::putAtom(const char* name, size_t length) {
+  BOOST_ASSERT(impl_.get());
+  
+  impl_->putTag('a');
+  impl_->putChars(name, length);
+}
+
+void BindingsSnapshot::putInteger(int64_t value) {
+  BOOST_ASSERT(impl_.get());
+  
+  impl_->putTag('i');
+  impl_->buffer_.append(reinterpret_cast<const char*>(&value),
+    sizeof(value));
+}
+
+void BindingsSnapshot::putFloat(double value) {
+  BOOST_ASSERT(impl_.get());
+  
+  impl_->putTag('f');
+  impl_->buffer_.append(reinterpret_cast<const char*>(&value),
+    sizeof(value));
+}
+
+void BindingsSnapshot::putString(const char* value, size_t length) {
+  BOOST_ASSERT(impl_.get());
+  
+  impl_->putTag('s');
+  impl_->putChars(value, length);
+}
+
+void BindingsSnapshot::putVariable(const char* name, size_t length) {
+  BOOST_ASSERT(impl_.get());
+  
+  impl_->putTag('v');
+  impl_->putChars(name, length);
+}
+
+void BindingsSnapshot::putCompound(const char* functor, size_t length,
+    size_t arity) {
+  BOOST_ASSERT(impl_.get());
+  
+  impl_->putTag('c');
+  impl_->putLength(arity);
+  impl_->putChars(functor, length);
+}
+
+void BindingsSnapshot::putList(size_t numElements, bool partial) {
+  BOOST_ASSERT(impl_.get());
+  
+  impl_->putTag(partial ? 'p' : 'l');
+  impl_->putLength(numElements);
+}
+
+Bindings BindingsSnapshot::decode() const {
+  if (!impl_.get())
+    return Bindings();
+  
+  Bindings bindings(impl_->schema_);
+  size_t offset = 0;
+  
+  for (size_t slot = 0; slot < impl_->schema_.getNumSlots(); ++slot) {
+    if (offset >= impl_->buffer_.size())
+      throw DecodingError("Missing slot.");
+    
+    if (impl_->buffer_[offset] == 'u')
+      ++offset;
+    else
+      bindings.setTerm(slot, impl_->decode(offset));
+  }
+  
+  if (offset != impl_->buffer_.size())
+    throw DecodingError("Trailing data.");
+  
+  return bindings;
+}
+
+void BindingsSnapshot::replay(BindingsWriter& writer) const {
+  if (!impl_.get())
+    return;
+  
+  size_t offset = 0;
+  
+  writer.beginBindings(impl_->schema_);
+  
+  for (size_t slot = 0; slot < impl_->schema_.getNumSlots(); ++slot) {
+    if (offset >= impl_->buffer_.size())
+      throw DecodingError("Missing slot.");
+    
+    if (impl_->buffer_[offset] == 'u') {
+      ++offset;
+      writer.putUnbound();
+    }
+    else
+      impl_->replay(offset, writer);
+  }
+  
+  if (offset != impl_->buffer_.size())
+    throw DecodingError("Trailing data.");
+  
+  writer.endBindings();
+}
+
+void BindingsSnapshot::Impl::putTag(char tag) {
+  buffer_.push_back(tag);
+}
+
+void BindingsSnapshot::Impl::putLength(size_t length) {
+  uint32_t value = length;
+  
+  buffer_.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void BindingsSnapshot::Impl::putChars(const char* chars, size_t length) {
+  putLength(length);
+  buffer_.append(chars, length);
+}
+
+char BindingsSnapshot::Impl::getTag(size_t& offset) const {
+  if (offset >= buffer_.size())
+    throw DecodingError("Unexpected end of data.");
+  
+  return buffer_[offset++];
+}
+
+size_t BindingsSnapshot::Impl::getLength(size_t& offset) const {
+  uint32_t value;
+  
+  if (offset+sizeof(value) > buffer_.size())
+    throw DecodingError("Unexpected end of data.");
+  
+  std::memcpy(&value, buffer_.data()+offset, sizeof(value));
+  offset += sizeof(value);
+  
+  return value;
+}
+
+std::string BindingsSnapshot::Impl::getChars(size_t& offset) const {
+  size_t length = getLength(offset);
+  
+  if (offset+length > buffer_.size())
+    throw DecodingError("Unexpected end of data.");
+  
+  std::string chars(buffer_, offset, length);
+  offset += length;
+  
+  return chars;
+}
+
+Term BindingsSnapshot::Impl::decode(size_t& offset) const {
+  std::vector<Frame> frames;
+  std::vector<Term> terms;
+  
+  while (true) {
+    char tag = getTag(offset);
+    
+    if ((tag == 'c') || (tag == 'l') || (tag == 'p')) {
+      Frame frame;
+      
+      frame.tag_ = tag;
+      frame.numSubterms_ = getLength(offset);
+      frame.offset_ = terms.size();
+      
+      if (tag == 'c')
+        frame.functor_ = getChars(offset);
+      else if (tag == 'p')
+        ++frame.numSubterms_;
+      
+      frames.push_back(frame);
+    }
+    else
+      terms.push_back(decodeAtomic(tag, offset));
+    
+    while (!frames.empty() && (terms.size()-frames.back().offset_ ==
+        frames.back().numSubterms_)) {
+      const Frame& frame = frames.back();
+      std::vector<Term> subterms(
+        std::make_move_iterator(terms.begin()+frame.offset_),
+        std::make_move_iterator(terms.end()));
+      Term term;
+      
+      if (frame.tag_ == 'c')
+        term = Compound(frame.functor_, std::move(subterms));
+      else if (frame.tag_ == 'p') {
+        Term tail = subterms.back();
+        
+        subterms.pop_back();
+        term = List(subterms, tail);
+      }
+      else
+        term = List(std::move(subterms));
+      
+      terms.resize(frame.offset_);
+      terms.push_back(std::move(term));
+      frames.pop_back();
+    }
+    
+    if (frames.empty())
+      return terms.back();
+  }
+}
+
+Term BindingsSnapshot::Impl::decodeAtomic(char tag, size_t& offset) const {
+  switch (tag) {
+    case 'a':
+      return Atom(getChars(offset));
+    case 'i':
+    case 'f': {
+      if (offset+sizeof(int64_t) > buffer_.size())
+        throw DecodingError("Unexpected end of data.");
+      
+      const char* data = buffer_.data()+offset;
+      offset += sizeof(int64_t);
+      
+      if (tag == 'i') {
+        int64_t value;
+        
+        std::memcpy(&value, data, sizeof(value));
+        return Integer(value);
+      }
+      else {
+        double value;
+        
+        std::memcpy(&value, data, sizeof(value));
+        return Float(value);
+      }
+    }
+    case 's':
+      return String(getChars(offset));
+    case 'v':
+      return Variable(getChars(offset));
+    default:
+      throw DecodingError("Invalid tag.");
+  }
+}
+
+void BindingsSnapshot::Impl::replay(size_t& offset, BindingsWriter&
+    writer) const {
+  std::vector<size_t> numSubterms;
+  
+  while (true) {
+    char tag = getTag(offset);
+    size_t numTermSubterms = 0;
+    
+    if (tag == 'c') {
+      numTermSubterms = getLength(offset);
+      std::string functor = getChars(offset);
+      
+      writer.putCompound(functor.c_str(), functor.length(),
+        numTermSubterms);
+    }
+    else if ((tag == 'l') || (tag == 'p')) {
+      size_t numElements = getLength(offset);
+      
+      writer.putList(numElements, tag == 'p');
+      numTermSubterms = (tag == 'p') ? numElements+1 : numElements;
+    }
+    else
+      replayAtomic(tag, offset, writer);
+    
+    if (numTermSubterms)
+      numSubterms.push_back(numTermSubterms);
+    else {
+      while (!numSubterms.empty() && !--numSubterms.back())
+        numSubterms.pop_back();
+      
+      if (numSubterms.empty())
+        return;
+    }
+  }
+}
+
+void BindingsSnapshot::Impl::replayAtomic(char tag, size_t& offset,
+    BindingsWriter& writer) const {
+  switch (tag) {
+    case 'a': {
+      std::string name = getChars(offset);
+      
+      writer.putAtom(name.c_str(), name.length());
+      break;
+    }
+    case 'i':
+    case 'f': {
+      if (offset+sizeof(int64_t) > buffer_.size())
+        throw DecodingError("Unexpected end of data.");
+      
+      const char* data = buffer_.data()+offset;
+      offset += sizeof(int64_t);
+      
+      if (tag == 'i') {
+        int64_t value;
+        
+        std::memcpy(&value, data, sizeof(value));
+        writer.putInteger(value);
+      }
+      else {
+        double value;
+        
+        std::memcpy(&value, data, sizeof(value));
+        writer.putFloat(value);
+      }
+      
+      break;
+    }
+    case 's': {
+      std::string value = getChars(offset);
+      
+      writer.putString(value.c_str(), value.length());
+      break;
+    }
+    case 'v': {
+      std::string name = getChars(offset);
+      
+      writer.putVariable(name.c_str(), name.length());
+      break;
+    }
+    default:
+      throw DecodingError("Invalid tag.");
+  }
+}
+
+}
@@ -38,6 +38,15 @@ Clause::Clause(const std::string& predicate, const std::vector<Term>&
     impl_.reset(new Fact::Impl(predicate, arguments));
 }
 
+Clause::Clause(const std::string& predicate, std::vector<Term>&& arguments,
+    std::list<Term>&& goals) {
+  if (!goals.empty())
+    impl_.reset(new Rule::Impl(predicate, std::move(arguments),
+      std::move(goals)));
+  else
+    impl_.reset(new Fact::Impl(predicate, std::move(arguments)));
+}
+
 Clause::Clause(const std::string& predicate, const std::initializer_list<
     Term>& arguments, const std::initializer_list<Term>& goals) {
   if (goals.size())
@@ -16,6 +16,8 @@
  * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
  ******************************************************************************/
 
+#include <prolog_common/SymbolTable.h>
+
 #include "prolog_common/Compound.h"
 
 namespace prolog {
@@ -26,16 +28,23 @@ namespace prolog {
 
 Compound::Compound(const std::string& functor, const std::vector<Term>&
     arguments) {
+  type_ = CompoundType;
   impl_.reset(new Impl(functor, arguments));
 }
 
+Compound::Compound(const std::string& functor, std::vector<Term>&&
+    arguments) {
+  type_ = CompoundType;
+  impl_.reset(new Impl(functor, std::move(arguments)));
+}
+
 Compound::Compound(const Compound& src) :
   Term(src) {
 }
 
 Compound::Compound(const Term& src) :
   Term(src) {
-  BOOST_ASSERT(boost::dynamic_pointer_cast<Impl>(impl_));
+  BOOST_ASSERT(isCompound());
 }
 
 Compound::~Compound() {  
@@ -43,12 +52,37 @@ Compound::~Compound() {
 
 Compound::Impl::Impl(const std::string& functor, const std::vector<Term>&
     arguments) :
-  functor_(functor),
-  arguments_(arguments) {
+  functor_(SymbolTable::internFunctor(functor, arguments.size())),
+  arguments_(arguments.begin(), arguments.end()),
+  hash_(0) {
   BOOST_ASSERT(!functor.empty());
   BOOST_ASSERT(!arguments.empty());  
 }
 
+Compound::Impl::Impl(const std::string& functor, std::vector<Term>&&
+    arguments) :
+  functor_(SymbolTable::internFunctor(functor, arguments.size())),
+  arguments_(std::make_move_iterator(arguments.begin()),
+    std::make_move_iterator(arguments.end())),
+  hash_(0) {
+  BOOST_ASSERT(!functor.empty());
+  BOOST_ASSERT(!arguments_.empty());
+}
+
+Compound::Impl::Impl(size_t functor, const TermAllocator<Term>& allocator) :
+  functor_(functor),
+  arguments_(SymbolTable::getFunctorArity(functor), Term(), allocator),
+  hash_(0) {
+  BOOST_ASSERT(!arguments_.empty());
+}
+
+Compound::Impl::Impl(const Impl& src) :
+  Term::Impl(),
+  functor_(src.functor_),
+  arguments_(src.arguments_.begin(), src.arguments_.end()),
+  hash_(0) {
+}
+
 Compound::Impl::~Impl() {
 }
 
@@ -56,35 +90,62 @@ Compound::Impl::~Impl() {
 /* Accessors                                                                 */
 /*****************************************************************************/
 
-std::string Compound::getFunctor() const {
+const std::string& Compound::getFunctor() const {
+  return SymbolTable::getAtomName(SymbolTable::getFunctorAtom(
+    boost::static_pointer_cast<Impl>(impl_)->functor_));
+}
+
+size_t Compound::getFunctorIdentifier() const {
   return boost::static_pointer_cast<Impl>(impl_)->functor_;
 }
 
-std::vector<Term> Compound::getArguments() const {
+const Compound::Arguments& Compound::getArguments() const {
   return boost::static_pointer_cast<Impl>(impl_)->arguments_;
 }
 
+const Term& Compound::getArgument(size_t index) const {
+  return boost::static_pointer_cast<Impl>(impl_)->arguments_[index];
+}
+
 size_t Compound::getArity() const {
   return boost::static_pointer_cast<Impl>(impl_)->arguments_.size();
 }
 
+bool Compound::Impl::isArenaAllocated() const {
+  return arguments_.get_allocator().arena_;
+}
+
+Compound::Impl& Compound::getMutableImpl() {
+  if ((impl_.use_count() > 1) || boost::static_pointer_cast<Impl>(impl_)->
+      isArenaAllocated())
+    impl_.reset(new Impl(*boost::static_pointer_cast<Impl>(impl_)));
+  
+  return *boost::static_pointer_cast<Impl>(impl_);
+}
+
 /*****************************************************************************/
 /* Methods                                                                   */
 /*****************************************************************************/
 
-std::vector<Term>::iterator Compound::begin() {
-  return boost::static_pointer_cast<Impl>(impl_)->arguments_.begin();
+Compound::Iterator Compound::begin() {
+  Impl& impl = getMutableImpl();
+  
+  impl.hash_ = 0;
+  return impl.arguments_.begin();
 }
 
-std::vector<Term>::const_iterator Compound::begin() const {
+Compound::ConstIterator Compound::begin() const {
   return boost::static_pointer_cast<Impl>(impl_)->arguments_.begin();
 }
 
-std::vector<Term>::iterator Compound::end() {
-  return boost::static_pointer_cast<Impl>(impl_)->arguments_.end();
+Compound::Iterator Compound::end() {
+  Impl& impl = getMutableImpl();
+  
+  impl.hash_ = 0;
+  return impl.arguments_.end();
 }
 
-std::vector<Term>::const_iterator Compound::end() const {
+Compound::ConstIterator Compound::end() const {
   return boost::static_pointer_cast<Impl>(impl_)->arguments_.end();
 }
 
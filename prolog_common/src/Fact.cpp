@@ -28,6 +28,10 @@ Fact::Fact(const std::string& predicate, const std::vector<Term>& arguments) {
   impl_.reset(new Impl(predicate, arguments));
 }
 
+Fact::Fact(const std::string& predicate, std::vector<Term>&& arguments) {
+  impl_.reset(new Impl(predicate, std::move(arguments)));
+}
+
 Fact::Fact(const Fact& src) :
   Clause(src) {
 }
@@ -51,6 +55,17 @@ Fact::Impl::Impl(const std::string& predicate, const std::vector<Term>&
     BOOST_ASSERT(!it->isCompound());
 }
 
+Fact::Impl::Impl(const std::string& predicate, std::vector<Term>&&
+    arguments) :
+  predicate_(predicate),
+  arguments_(std::move(arguments)) {
+  BOOST_ASSERT(!predicate.empty());
+  
+  for (std::vector<Term>::const_iterator it = arguments_.begin();
+      it != arguments_.end(); ++it)
+    BOOST_ASSERT(!it->isCompound());
+}
+
 Fact::Impl::~Impl() {
 }
 
@@ -58,11 +73,11 @@ Fact::Impl::~Impl() {
 /* Accessors                                                                 */
 /*****************************************************************************/
 
-std::string Fact::getPredicate() const {
+const std::string& Fact::getPredicate() const {
   return boost::static_pointer_cast<Impl>(impl_)->predicate_;
 }
 
-std::vector<Term> Fact::getArguments() const {
+const std::vector<Term>& Fact::getArguments() const {
   return boost::static_pointer_cast<Impl>(impl_)->arguments_;
 }
 
@@ -25,7 +25,8 @@ namespace prolog {
 /*****************************************************************************/
 
 Float::Float(double value) {
-  impl_.reset(new Impl(value));
+  type_ = FloatType;
+  value_.float_ = value;
 }
 
 Float::Float(const Float& src) :
@@ -34,25 +35,18 @@ Float::Float(const Float& src) :
 
 Float::Float(const Term& src) :
   Number(src) {
-  BOOST_ASSERT(boost::dynamic_pointer_cast<Impl>(impl_));
+  BOOST_ASSERT(isFloat());
 }
 
 Float::~Float() {  
 }
 
-Float::Impl::Impl(double value) :
-  value_(value) {
-}
-
-Float::Impl::~Impl() {
-}
-
 /*****************************************************************************/
 /* Accessors                                                                 */
 /*****************************************************************************/
 
 double Float::getValue() const {
-  return boost::static_pointer_cast<Impl>(impl_)->value_;
+  return value_.float_;
 }
 
 }
@@ -0,0 +1,124 @@
+/******************************************************************************
+ * Copyright (C) 2016 by Ralf Kaestner                                        *
+ * ralf.kaestner@gmail.com                                                    *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the               *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+#include <boost/assert.hpp>
+
+#include "prolog_common/Atom.h"
+#include "prolog_common/Compound.h"
+
+#include "prolog_common/GoalBuilder.h"
+
+namespace prolog {
+
+/*****************************************************************************/
+/* Constructors and Destructor                                               */
+/*****************************************************************************/
+
+GoalBuilder::GoalBuilder() :
+  impl_(new Impl(0)) {
+}
+
+GoalBuilder::GoalBuilder(TermArena& arena) :
+  impl_(new Impl(&arena)) {
+}
+
+GoalBuilder::GoalBuilder(const GoalBuilder& src) :
+  impl_(src.impl_) {
+}
+
+GoalBuilder::~GoalBuilder() {
+}
+
+GoalBuilder::Impl::Impl(TermArena* arena) :
+  arena_(arena) {
+}
+
+GoalBuilder::Impl::~Impl() {
+}
+
+/*****************************************************************************/
+/* Accessors                                                                 */
+/*****************************************************************************/
+
+Term GoalBuilder::getGoal() const {
+  if (!impl_->terms_.empty())
+    return impl_->terms_.back();
+  else
+    return Term();
+}
+
+/*****************************************************************************/
+/* Methods                                                                   */
+/*****************************************************************************/
+
+void GoalBuilder::putTerm(const Term& term) {
+  impl_->terms_.push_back(term);
+}
+
+void GoalBuilder::putCompound(const std::string& functor, size_t arity) {
+  BOOST_ASSERT(impl_->terms_.size() >= arity);
+  
+  if (arity) {
+    std::vector<Term>::iterator begin = impl_->terms_.end()-arity;
+    Term compound = impl_->createCompound(functor, begin,
+      impl_->terms_.end());
+    
+    impl_->terms_.erase(begin+1, impl_->terms_.end());
+    impl_->terms_.back() = std::move(compound);
+  }
+  else
+    impl_->terms_.push_back(Atom(functor));
+}
+
+void GoalBuilder::putConjunction(size_t numConjuncts) {
+  impl_->putOperator("','", numConjuncts);
+}
+
+void GoalBuilder::putDisjunction(size_t numDisjuncts) {
+  impl_->putOperator("';'", numDisjuncts);
+}
+
+void GoalBuilder::clear() {
+  impl_->terms_.clear();
+}
+
+Term GoalBuilder::Impl::createCompound(const std::string& functor,
+    std::vector<Term>::iterator begin, std::vector<Term>::iterator end) {
+  if (arena_)
+    return arena_->createCompound(functor, std::vector<Term>(begin, end));
+  else
+    return Compound(functor, std::vector<Term>(
+      std::make_move_iterator(begin), std::make_move_iterator(end)));
+}
+
+void GoalBuilder::Impl::putOperator(const std::string& functor, size_t
+    numOperands) {
+  BOOST_ASSERT(numOperands && (terms_.size() >= numOperands));
+  
+  while (numOperands > 1) {
+    std::vector<Term>::iterator begin = terms_.end()-2;
+    Term compound = createCompound(functor, begin, terms_.end());
+    
+    terms_.pop_back();
+    terms_.back() = std::move(compound);
+    
+    --numOperands;
+  }
+}
+
+}
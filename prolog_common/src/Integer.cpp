@@ -25,7 +25,8 @@ namespace prolog {
 /*****************************************************************************/
 
 Integer::Integer(int64_t value) {
-  impl_.reset(new Impl(value));
+  type_ = IntegerType;
+  value_.integer_ = value;
 }
 
 Integer::Integer(const Integer& src) :
@@ -34,25 +35,18 @@ Integer::Integer(const Integer& src) :
 
 Integer::Integer(const Term& src) :
   Number(src) {
-  BOOST_ASSERT(boost::dynamic_pointer_cast<Impl>(impl_));
+  BOOST_ASSERT(isInteger());
 }
 
 Integer::~Integer() {  
 }
 
-Integer::Impl::Impl(int64_t value) :
-  value_(value) {
-}
-
-Integer::Impl::~Impl() {
-}
-
 /*****************************************************************************/
 /* Accessors                                                                 */
 /*****************************************************************************/
 
 int64_t Integer::getValue() const {
-  return boost::static_pointer_cast<Impl>(impl_)->value_;
+  return value_.integer_;
 }
 
 }
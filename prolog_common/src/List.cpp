@@ -16,6 +16,8 @@
  * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
  ******************************************************************************/
 
+#include <prolog_common/Variable.h>
+
 #include "prolog_common/List.h"
 
 namespace prolog {
@@ -24,27 +26,113 @@ namespace prolog {
 /* Constructors and Destructor                                               */
 /*****************************************************************************/
 
+List::ConstIterator::ConstIterator() :
+  impl_(0),
+  index_(0) {
+}
+
+List::ConstIterator::ConstIterator(const Impl* impl) :
+  impl_(impl),
+  index_(0) {
+  while (impl_ && (index_ >= impl_->elements_.size()))
+    impl_ = impl_->next_.get();
+}
+
 List::List(const std::list<Term>& elements) {
+  type_ = ListType;
   impl_.reset(new Impl(elements));
 }
 
+List::List(std::list<Term>&& elements) {
+  type_ = ListType;
+  impl_.reset(new Impl(std::move(elements)));
+}
+
+List::List(const std::vector<Term>& elements) {
+  type_ = ListType;
+  impl_.reset(new Impl(elements));
+}
+
+List::List(std::vector<Term>&& elements) {
+  type_ = ListType;
+  impl_.reset(new Impl(std::move(elements)));
+}
+
+List::List(const std::initializer_list<Term>& elements) :
+  List(std::vector<Term>(elements)) {
+}
+
+List::List(const Term& head, const Term& tail) :
+  List(std::vector<Term>(1, head), tail) {
+}
+
+List::List(const std::vector<Term>& elements, const Term& tail) :
+  List(elements) {
+  setTail(tail);
+}
+
 List::List(const List& src) :
   Term(src) {
 }
 
 List::List(const Term& src) :
   Term(src) {
-  BOOST_ASSERT(boost::dynamic_pointer_cast<Impl>(impl_));
+  BOOST_ASSERT(isList());
 }
 
 List::~List() {  
 }
 
 List::Impl::Impl(const std::list<Term>& elements) :
-  elements_(elements) {
+  elements_(elements.begin(), elements.end()),
+  size_(elements_.size()) {
+}
+
+List::Impl::Impl(std::list<Term>&& elements) :
+  elements_(std::make_move_iterator(elements.begin()),
+    std::make_move_iterator(elements.end())),
+  size_(elements_.size()) {
+}
+
+List::Impl::Impl(const std::vector<Term>& elements) :
+  elements_(elements.begin(), elements.end()),
+  size_(elements_.size()) {
+}
+
+List::Impl::Impl(std::vector<Term>&& elements) :
+  elements_(std::make_move_iterator(elements.begin()),
+    std::make_move_iterator(elements.end())),
+  size_(elements_.size()) {
+}
+
+List::Impl::Impl(const TermAllocator<Term>& allocator, size_t capacity) :
+  elements_(allocator),
+  size_(0) {
+  elements_.reserve(capacity);
+}
+
+List::Impl::Impl(const Impl& src) :
+  Term::Impl(),
+  elements_(src.elements_.begin(), src.elements_.end()),
+  next_(src.next_),
+  tail_(src.tail_),
+  size_(src.size_) {
+  if (next_.get() && !next_.use_count())
+    next_ = boost::static_pointer_cast<Impl>(TermArena::Impl::share(
+      next_.get()));
 }
 
 List::Impl::~Impl() {
+  boost::shared_ptr<Impl> next;
+  
+  next.swap(next_);
+  
+  while (next.unique()) {
+    boost::shared_ptr<Impl> successor;
+    
+    successor.swap(next->next_);
+    next.swap(successor);
+  }
 }
 
 /*****************************************************************************/
@@ -52,58 +140,165 @@ List::Impl::~Impl() {
 /*****************************************************************************/
 
 size_t List::getNumElements() const {
-  return boost::static_pointer_cast<Impl>(impl_)->elements_.size();
+  return boost::static_pointer_cast<Impl>(impl_)->size_;
 }
 
-std::list<Term> List::getElements() const {
-  return boost::static_pointer_cast<Impl>(impl_)->elements_;
+List::ConstRange List::getElements() const {
+  return ConstRange(begin(), end());
 }
 
-bool List::isEmpty() const {
-  return boost::static_pointer_cast<Impl>(impl_)->elements_.empty();
+const Term& List::getTail() const {
+  return boost::static_pointer_cast<Impl>(impl_)->getLast().tail_;
 }
+
+void List::setTail(const Term& tail) {
+  if (tail.isList()) {
+    List list(tail);
+    
+    if (list.isEmpty() && !list.isPartial())
+      setTail(Term());
+    else {
+      Impl& impl = getDetachedImpl();
       
+      impl.next_ = boost::static_pointer_cast<Impl>(list.impl_);
+      impl.tail_ = Term();
+      impl.size_ = impl.elements_.size()+impl.next_->size_;
+    }
+  }
+  else {
+    BOOST_ASSERT(!tail.isValid() || tail.isVariable());
+    
+    getDetachedImpl().tail_ = tail;
+  }
+}
+
+bool List::isEmpty() const {
+  return !boost::static_pointer_cast<Impl>(impl_)->size_;
+}
+
+bool List::isPartial() const {
+  return getTail().isVariable();
+}
+
+const List::Impl& List::Impl::getLast() const {
+  const Impl* impl = this;
+  
+  while (impl->next_)
+    impl = impl->next_.get();
+  
+  return *impl;
+}
+
+bool List::Impl::isArenaAllocated() const {
+  return elements_.get_allocator().arena_;
+}
+
+List::Impl& List::getMutableImpl() {
+  if ((impl_.use_count() > 1) || boost::static_pointer_cast<Impl>(impl_)->
+      isArenaAllocated())
+    impl_.reset(new Impl(*boost::static_pointer_cast<Impl>(impl_)));
+  
+  return *boost::static_pointer_cast<Impl>(impl_);
+}
+
+List::Impl& List::getDetachedImpl() {
+  Impl& impl = getMutableImpl();
+  
+  if (impl.next_) {
+    const Impl& last = impl.getLast();
+    
+    impl.elements_.reserve(impl.size_);
+    for (const Impl* next = impl.next_.get(); next; next = next->next_.get())
+      impl.elements_.insert(impl.elements_.end(), next->elements_.begin(),
+        next->elements_.end());
+    
+    impl.tail_ = last.tail_;
+    impl.next_.reset();
+  }
+  
+  return impl;
+}
+
 /*****************************************************************************/
 /* Methods                                                                   */
 /*****************************************************************************/
 
-std::list<Term>::iterator List::begin() {
-  return boost::static_pointer_cast<Impl>(impl_)->elements_.begin();
+List::ConstIterator List::begin() const {
+  return ConstIterator(boost::static_pointer_cast<Impl>(impl_).get());
 }
 
-std::list<Term>::const_iterator List::begin() const {
-  return boost::static_pointer_cast<Impl>(impl_)->elements_.begin();
+List::ConstIterator List::end() const {
+  return ConstIterator();
 }
 
-std::list<Term>::iterator List::end() {
-  return boost::static_pointer_cast<Impl>(impl_)->elements_.end();
+void List::ConstIterator::increment() {
+  ++index_;
+  
+  while (impl_ && (index_ >= impl_->elements_.size())) {
+    impl_ = impl_->next_.get();
+    index_ = 0;
+  }
 }
 
-std::list<Term>::const_iterator List::end() const {
-  return boost::static_pointer_cast<Impl>(impl_)->elements_.end();
+void List::reserve(size_t numElements) {
+  getDetachedImpl().elements_.reserve(numElements);
 }
 
 void List::append(const Term& element) {
-  boost::static_pointer_cast<Impl>(impl_)->elements_.push_back(element);
+  BOOST_ASSERT(!isPartial());
+  
+  Impl& impl = getDetachedImpl();
+  
+  impl.elements_.push_back(element);
+  ++impl.size_;
+}
+
+void List::append(Term&& element) {
+  BOOST_ASSERT(!isPartial());
+  
+  Impl& impl = getDetachedImpl();
+  
+  impl.elements_.push_back(std::move(element));
+  ++impl.size_;
 }
 
 void List::append(const List& list) {
-  std::list<Term>& elements = boost::static_pointer_cast<Impl>(
-    impl_)->elements_;
-  std::list<Term>& listElements = boost::static_pointer_cast<Impl>(
-    list.impl_)->elements_;
+  BOOST_ASSERT(!isPartial());
+  
+  Impl& impl = getDetachedImpl();
   
-  elements.insert(elements.end(), listElements.begin(), listElements.end());
+  impl.elements_.reserve(impl.size_+list.getNumElements());
+  impl.elements_.insert(impl.elements_.end(), list.begin(), list.end());
+  impl.tail_ = list.getTail();
+  impl.size_ = impl.elements_.size();
 }
 
 void List::clear() {
-  boost::static_pointer_cast<Impl>(impl_)->elements_.clear();
+  if ((impl_.use_count() > 1) || boost::static_pointer_cast<Impl>(impl_)->
+      isArenaAllocated())
+    impl_.reset(new Impl(std::vector<Term>()));
+  else {
+    Impl& impl = *boost::static_pointer_cast<Impl>(impl_);
+    
+    impl.elements_.clear();
+    impl.next_.reset();
+    impl.tail_ = Term();
+    impl.size_ = 0;
+  }
 }
 
 /*****************************************************************************/
 /* Operators                                                                 */
 /*****************************************************************************/
 
+bool List::ConstIterator::equal(const ConstIterator& iterator) const {
+  return (impl_ == iterator.impl_) && (index_ == iterator.index_);
+}
+
+const Term& List::ConstIterator::dereference() const {
+  return impl_->elements_[index_];
+}
+
 List& List::operator+=(const Term& element) {
   append(element);
   
@@ -125,9 +320,11 @@ List List::operator+(const Term& element) const {
 }
 
 List List::operator+(const List& list) const {
-  List result(*this);
+  BOOST_ASSERT(!isPartial());
+  
+  List result(std::vector<Term>(begin(), end()));
   
-  result.append(list);
+  result.setTail(list);
   
   return result;
 }
@@ -16,9 +16,6 @@
  * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
  ******************************************************************************/
 
-#include <prolog_common/Float.h>
-#include <prolog_common/Integer.h>
-
 #include "prolog_common/Number.h"
 
 namespace prolog {
@@ -36,28 +33,22 @@ Number::Number(const Number& src) :
 
 Number::Number(const Term& src) :
   Term(src) {
-  BOOST_ASSERT(boost::dynamic_pointer_cast<Impl>(impl_));
+  BOOST_ASSERT(isNumber());
 }
 
 Number::~Number() {  
 }
 
-Number::Impl::Impl() {
-}
-
-Number::Impl::~Impl() {
-}
-
 /*****************************************************************************/
 /* Accessors                                                                 */
 /*****************************************************************************/
 
 bool Number::isFloat() const {
-  return boost::dynamic_pointer_cast<Float::Impl>(impl_).get();
+  return (type_ == FloatType);
 }
 
 bool Number::isInteger() const {
-  return boost::dynamic_pointer_cast<Integer::Impl>(impl_).get();
+  return (type_ == IntegerType);
 }
 
 }
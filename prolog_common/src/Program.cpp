@@ -28,6 +28,10 @@ Program::Program(const std::list<Clause>& clauses) {
   impl_.reset(new Impl(clauses));
 }
 
+Program::Program(std::list<Clause>&& clauses) {
+  impl_.reset(new Impl(std::move(clauses)));
+}
+
 Program::Program(const Program& src) :
   impl_(src.impl_) {
 }
@@ -39,6 +43,10 @@ Program::Impl::Impl(const std::list<Clause>& clauses) :
   clauses_(clauses) {
 }
 
+Program::Impl::Impl(std::list<Clause>&& clauses) :
+  clauses_(std::move(clauses)) {
+}
+
 Program::Impl::~Impl() {
 }
 
@@ -50,7 +58,7 @@ size_t Program::getNumClauses() const {
   return boost::static_pointer_cast<Impl>(impl_)->clauses_.size();
 }
 
-std::list<Clause> Program::getClauses() const {
+const std::list<Clause>& Program::getClauses() const {
   return boost::static_pointer_cast<Impl>(impl_)->clauses_;
 }
 
@@ -82,6 +90,11 @@ void Program::append(const Clause& clause) {
   boost::static_pointer_cast<Impl>(impl_)->clauses_.push_back(clause);
 }
 
+void Program::append(Clause&& clause) {
+  boost::static_pointer_cast<Impl>(impl_)->clauses_.push_back(
+    std::move(clause));
+}
+
 void Program::append(const Program& program) {
   std::list<Clause>& clauses = boost::static_pointer_cast<Impl>(
     impl_)->clauses_;
@@ -16,6 +16,8 @@
  * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
  ******************************************************************************/
 
+#include <boost/functional/hash.hpp>
+
 #include "prolog_common/Query.h"
 
 namespace prolog {
@@ -38,6 +40,10 @@ Query::Query(const std::string& predicate, const std::initializer_list<Term>&
   impl_(new Impl("user", predicate, arguments)) {
 }
 
+Query::Query(const std::string& predicate, std::vector<Term>&& arguments) :
+  impl_(new Impl("user", predicate, std::move(arguments))) {
+}
+
 Query::Query(const std::string& module, const std::string& predicate, const
     std::vector<Term>& arguments) :
   impl_(new Impl(module, predicate, arguments)) {
@@ -48,6 +54,11 @@ Query::Query(const std::string& module, const std::string& predicate, const
   impl_(new Impl(module, predicate, arguments)) {
 }
 
+Query::Query(const std::string& module, const std::string& predicate,
+    std::vector<Term>&& arguments) :
+  impl_(new Impl(module, predicate, std::move(arguments))) {
+}
+
 Query::Query(const Query& src) :
   impl_(src.impl_) {
 }
@@ -63,6 +74,14 @@ Query::Impl::Impl(const std::string& module, const std::string& predicate,
   BOOST_ASSERT(!predicate.empty());
 }
 
+Query::Impl::Impl(const std::string& module, const std::string& predicate,
+    std::vector<Term>&& arguments) :
+  module_(module),
+  predicate_(predicate),
+  arguments_(std::move(arguments)) {
+  BOOST_ASSERT(!predicate.empty());
+}
+
 Query::Impl::~Impl() {
 }
 
@@ -70,15 +89,15 @@ Query::Impl::~Impl() {
 /* Accessors                                                                 */
 /*****************************************************************************/
 
-std::string Query::getModule() const {
+const std::string& Query::getModule() const {
   return impl_->module_;
 }
 
-std::string Query::getPredicate() const {
+const std::string& Query::getPredicate() const {
   return impl_->predicate_;
 }
 
-std::vector<Term> Query::getArguments() const {
+const std::vector<Term>& Query::getArguments() const {
   return impl_->arguments_;
 }
 
@@ -100,24 +119,55 @@ bool Query::isValid() const {
   return !impl_->predicate_.empty();
 }
 
+size_t Query::getHash() const {
+  size_t hash = boost::hash_value(impl_->module_);
+  
+  boost::hash_combine(hash, impl_->predicate_);
+  
+  for (std::vector<Term>::const_iterator it = impl_->arguments_.begin();
+      it != impl_->arguments_.end(); ++it)
+    boost::hash_combine(hash, it->getHash());
+  
+  return hash;
+}
+
 /*****************************************************************************/
 /* Methods                                                                   */
 /*****************************************************************************/
 
 std::vector<Term>::iterator Query::begin() {
-  impl_->arguments_.begin();
+  return impl_->arguments_.begin();
 }
 
 std::vector<Term>::const_iterator Query::begin() const {
-  impl_->arguments_.begin();
+  return impl_->arguments_.begin();
 }
 
 std::vector<Term>::iterator Query::end() {
-  impl_->arguments_.end();
+  return impl_->arguments_.end();
 }
 
 std::vector<Term>::const_iterator Query::end() const {
-  impl_->arguments_.end();
+  return impl_->arguments_.end();
+}
+
+/*****************************************************************************/
+/* Operators                                                                 */
+/*****************************************************************************/
+
+bool Query::operator==(const Query& query) const {
+  return (impl_ == query.impl_) ||
+    ((impl_->module_ == query.impl_->module_) &&
+    (impl_->predicate_ == query.impl_->predicate_) &&
+    (impl_->arguments_ == query.impl_->arguments_));
+}
+
+bool Query::operator!=(const Query& query) const {
+  return !operator==(query);
+}
+
+size_t hash_value(const Query& query) {
+  return query.getHash();
 }
 
 }
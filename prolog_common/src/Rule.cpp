@@ -29,6 +29,11 @@ Rule::Rule(const std::string& predicate, const std::vector<Term>& arguments,
   impl_.reset(new Impl(predicate, arguments, goals));
 }
 
+Rule::Rule(const std::string& predicate, std::vector<Term>&& arguments,
+    std::list<Term>&& goals) {
+  impl_.reset(new Impl(predicate, std::move(arguments), std::move(goals)));
+}
+
 Rule::Rule(const Rule& src) :
   Clause(src) {
 }
@@ -54,6 +59,19 @@ Rule::Impl::Impl(const std::string& predicate, const std::vector<Term>&
     BOOST_ASSERT(!it->isCompound());
 }
 
+Rule::Impl::Impl(const std::string& predicate, std::vector<Term>&&
+    arguments, std::list<Term>&& goals) :
+  predicate_(predicate),
+  arguments_(std::move(arguments)),
+  goals_(std::move(goals)) {
+  BOOST_ASSERT(!predicate.empty());
+  BOOST_ASSERT(!goals_.empty());
+  
+  for (std::vector<Term>::const_iterator it = arguments_.begin();
+      it != arguments_.end(); ++it)
+    BOOST_ASSERT(!it->isCompound());
+}
+
 Rule::Impl::~Impl() {
 }
 
@@ -61,15 +79,15 @@ Rule::Impl::~Impl() {
 /* Accessors                                                                 */
 /*****************************************************************************/
 
-std::string Rule::getPredicate() const {
+const std::string& Rule::getPredicate() const {
   return boost::static_pointer_cast<Impl>(impl_)->predicate_;
 }
 
-std::vector<Term> Rule::getArguments() const {
+const std::vector<Term>& Rule::getArguments() const {
   return boost::static_pointer_cast<Impl>(impl_)->arguments_;
 }
 
-std::list<Term> Rule::getGoals() const {
+const std::list<Term>& Rule::getGoals() const {
   return boost::static_pointer_cast<Impl>(impl_)->goals_;
 }
 
@@ -90,6 +108,12 @@ void Rule::append(const Term& goal) {
     boost::static_pointer_cast<Impl>(impl_)->goals_.push_back(goal);
 }
 
+void Rule::append(Term&& goal) {
+  if (impl_)
+    boost::static_pointer_cast<Impl>(impl_)->goals_.push_back(
+      std::move(goal));
+}
+
 /*****************************************************************************/
 /* Operators                                                                 */
 /*****************************************************************************/
@@ -57,11 +57,13 @@ Solution::Impl::~Impl() {
 /* Accessors                                                                 */
 /*****************************************************************************/
 
-Bindings Solution::getBindings() const {
+const Bindings& Solution::getBindings() const {
+  static const Bindings empty;
+  
   if (impl_.get())
     return impl_->bindings_;
   else
-    return Bindings();
+    return empty;
 }
 
 bool Solution::isValid() const {
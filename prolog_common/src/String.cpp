@@ -0,0 +1,72 @@
+/******************************************************************************
+ * Copyright (C) 2016 by Ralf Kaestner                                        *
+ * ralf.kaestner@gmail.com                                                    *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the               *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+#include "prolog_common/String.h"
+
+namespace prolog {
+
+/*****************************************************************************/
+/* Constructors and Destructor                                               */
+/*****************************************************************************/
+
+String::String(const char* value) :
+  String(std::string(value)) {
+}
+
+String::String(const std::string& value) {
+  type_ = StringType;
+  impl_.reset(new Impl(value));
+}
+
+String::String(std::string&& value) {
+  type_ = StringType;
+  impl_.reset(new Impl(std::move(value)));
+}
+
+String::String(const String& src) :
+  Term(src) {
+}
+
+String::String(const Term& src) :
+  Term(src) {
+  BOOST_ASSERT(isString());
+}
+
+String::~String() {  
+}
+
+String::Impl::Impl(const std::string& value) :
+  value_(value) {
+}
+
+String::Impl::Impl(std::string&& value) :
+  value_(std::move(value)) {
+}
+
+String::Impl::~Impl() {
+}
+
+/*****************************************************************************/
+/* Accessors                                                                 */
+/*****************************************************************************/
+
+const std::string& String::getValue() const {
+  return boost::static_pointer_cast<Impl>(impl_)->value_;
+}
+
+}
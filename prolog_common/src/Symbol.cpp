@@ -0,0 +1,101 @@
+/******************************************************************************
+ * Copyright (C) 2016 by Ralf Kaestner                                        *
+ * ralf.kaestner@gmail.com                                                    *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the               *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+#include <limits>
+
+#include <boost/functional/hash.hpp>
+
+#include <prolog_common/SymbolTable.h>
+
+#include "prolog_common/Symbol.h"
+
+namespace prolog {
+
+/*****************************************************************************/
+/* Constructors and Destructor                                               */
+/*****************************************************************************/
+
+Symbol::Symbol() :
+  identifier_(std::numeric_limits<uint32_t>::max()) {
+}
+
+Symbol::Symbol(const std::string& name) :
+  identifier_(SymbolTable::internAtom(name)) {
+}
+
+Symbol::Symbol(const Symbol& src) :
+  identifier_(src.identifier_) {
+}
+
+Symbol::~Symbol() {
+}
+
+/*****************************************************************************/
+/* Accessors                                                                 */
+/*****************************************************************************/
+
+size_t Symbol::getIdentifier() const {
+  return identifier_;
+}
+
+const std::string& Symbol::getName() const {
+  static const std::string empty;
+  
+  if (isValid())
+    return SymbolTable::getAtomName(identifier_);
+  else
+    return empty;
+}
+
+bool Symbol::isValid() const {
+  return (identifier_ != std::numeric_limits<uint32_t>::max());
+}
+
+/*****************************************************************************/
+/* Methods                                                                   */
+/*****************************************************************************/
+
+Symbol Symbol::fromIdentifier(size_t identifier) {
+  Symbol symbol;
+  
+  symbol.identifier_ = identifier;
+  
+  return symbol;
+}
+
+/*****************************************************************************/
+/* Operators                                                                 */
+/*****************************************************************************/
+
+bool Symbol::operator==(const Symbol& symbol) const {
+  return (identifier_ == symbol.identifier_);
+}
+
+bool Symbol::operator!=(const Symbol& symbol) const {
+  return (identifier_ != symbol.identifier_);
+}
+
+size_t hash_value(const Symbol& symbol) {
+  return boost::hash_value(symbol.getIdentifier());
+}
+
+std::ostream& operator<<(std::ostream& stream, const Symbol& symbol) {
+  return stream << symbol.getName();
+}
+
+}
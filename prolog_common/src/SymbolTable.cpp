@@ -0,0 +1,253 @@
+/******************************************************************************
+ * Copyright (C) 2016 by Ralf Kaestner                                        *
+ * ralf.kaestner@gmail.com                                                    *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the               *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+#include <utility>
+#include <vector>
+
+#include <boost/thread/locks.hpp>
+#include <boost/thread/shared_mutex.hpp>
+#include <boost/unordered_map.hpp>
+
+#include "prolog_common/SymbolTable.h"
+
+namespace prolog {
+
+/*****************************************************************************/
+/* Implementation                                                            */
+/*****************************************************************************/
+
+class SymbolTable::Impl {
+public:
+  /** \brief Chunked storage of the interned entries
+    * 
+    * Chunks are allocated once and never move, so entries may be
+    * resolved concurrently with the insertion of new entries.
+    */
+  template <typename T> class Chunks {
+  public:
+    static const size_t chunkSize = 4096;
+    static const size_t maxNumChunks = 16384;
+    
+    Chunks();
+    ~Chunks();
+    
+    const T& get(size_t index) const;
+    size_t append(const T& entry);
+    
+    T* chunks_[maxNumChunks];
+    size_t size_;
+  };
+  
+  struct Functor {
+    size_t atom_;
+    size_t arity_;
+  };
+  
+  Impl();
+  ~Impl();
+  
+  boost::shared_mutex mutex_;
+  
+  boost::unordered_map<std::string, size_t> atomIdentifiers_;
+  boost::unordered_map<std::pair<size_t, size_t>, size_t>
+    functorIdentifiers_;
+  
+  Chunks<const std::string*> atoms_;
+  Chunks<Functor> functors_;
+};
+
+/*****************************************************************************/
+/* Constructors and Destructor                                               */
+/*****************************************************************************/
+
+SymbolTable::CapacityExceeded::CapacityExceeded(const std::string& what) :
+  ros::Exception("Capacity of the symbol table exceeded: "+what) {
+}
+
+SymbolTable::Impl::Impl() {
+}
+
+SymbolTable::Impl::~Impl() {
+}
+
+template <typename T> SymbolTable::Impl::Chunks<T>::Chunks() :
+  size_(0) {
+  for (size_t index = 0; index < maxNumChunks; ++index)
+    chunks_[index] = 0;
+}
+
+template <typename T> SymbolTable::Impl::Chunks<T>::~Chunks() {
+  for (size_t index = 0; index < maxNumChunks; ++index)
+    delete[] chunks_[index];
+}
+
+/*****************************************************************************/
+/* Accessors                                                                 */
+/*****************************************************************************/
+
+bool SymbolTable::lookupAtom(const std::string& name, size_t& atom) {
+  Impl& impl = getImpl();
+  boost::shared_lock<boost::shared_mutex> lock(impl.mutex_);
+  
+  boost::unordered_map<std::string, size_t>::const_iterator it =
+    impl.atomIdentifiers_.find(name);
+    
+  if (it != impl.atomIdentifiers_.end()) {
+    atom = it->second;
+    return true;
+  }
+  else
+    return false;
+}
+
+const std::string& SymbolTable::getAtomName(size_t atom) {
+  return *getImpl().atoms_.get(atom);
+}
+
+size_t SymbolTable::getFunctorAtom(size_t functor) {
+  return getImpl().functors_.get(functor).atom_;
+}
+
+size_t SymbolTable::getFunctorArity(size_t functor) {
+  return getImpl().functors_.get(functor).arity_;
+}
+
+size_t SymbolTable::getCapacity() {
+  return Impl::Chunks<Impl::Functor>::chunkSize*
+    Impl::Chunks<Impl::Functor>::maxNumChunks;
+}
+
+size_t SymbolTable::getNumAtoms() {
+  Impl& impl = getImpl();
+  boost::shared_lock<boost::shared_mutex> lock(impl.mutex_);
+  
+  return impl.atoms_.size_;
+}
+
+size_t SymbolTable::getNumFunctors() {
+  Impl& impl = getImpl();
+  boost::shared_lock<boost::shared_mutex> lock(impl.mutex_);
+  
+  return impl.functors_.size_;
+}
+
+SymbolTable::Impl& SymbolTable::getImpl() {
+  static Impl* impl = new Impl();
+  
+  return *impl;
+}
+
+template <typename T> const T& SymbolTable::Impl::Chunks<T>::get(size_t
+    index) const {
+  return chunks_[index/chunkSize][index%chunkSize];
+}
+
+/*****************************************************************************/
+/* Methods                                                                   */
+/*****************************************************************************/
+
+size_t SymbolTable::internAtom(const std::string& name) {
+  Impl& impl = getImpl();
+  
+  {
+    boost::shared_lock<boost::shared_mutex> lock(impl.mutex_);
+    
+    boost::unordered_map<std::string, size_t>::const_iterator it =
+      impl.atomIdentifiers_.find(name);
+      
+    if (it != impl.atomIdentifiers_.end())
+      return it->second;
+  }
+  
+  boost::unique_lock<boost::shared_mutex> lock(impl.mutex_);
+  
+  std::pair<boost::unordered_map<std::string, size_t>::iterator, bool>
+    result = impl.atomIdentifiers_.insert(std::make_pair(name,
+    impl.atoms_.size_));
+    
+  if (result.second) {
+    try {
+      impl.atoms_.append(&result.first->first);
+    }
+    catch (...) {
+      impl.atomIdentifiers_.erase(result.first);
+      throw;
+    }
+  }
+  
+  return result.first->second;
+}
+
+size_t SymbolTable::internFunctor(size_t atom, size_t arity) {
+  Impl& impl = getImpl();
+  std::pair<size_t, size_t> key(atom, arity);
+  
+  {
+    boost::shared_lock<boost::shared_mutex> lock(impl.mutex_);
+    
+    boost::unordered_map<std::pair<size_t, size_t>, size_t>::const_iterator
+      it = impl.functorIdentifiers_.find(key);
+      
+    if (it != impl.functorIdentifiers_.end())
+      return it->second;
+  }
+  
+  boost::unique_lock<boost::shared_mutex> lock(impl.mutex_);
+  
+  std::pair<boost::unordered_map<std::pair<size_t, size_t>, size_t>::
+    iterator, bool> result = impl.functorIdentifiers_.insert(
+    std::make_pair(key, impl.functors_.size_));
+  
+  if (result.second) {
+    Impl::Functor functor;
+    
+    functor.atom_ = atom;
+    functor.arity_ = arity;
+    
+    try {
+      impl.functors_.append(functor);
+    }
+    catch (...) {
+      impl.functorIdentifiers_.erase(result.first);
+      throw;
+    }
+  }
+  
+  return result.first->second;
+}
+
+size_t SymbolTable::internFunctor(const std::string& name, size_t arity) {
+  return internFunctor(internAtom(name), arity);
+}
+
+template <typename T> size_t SymbolTable::Impl::Chunks<T>::append(const T&
+    entry) {
+  size_t chunk = size_/chunkSize;
+  
+  if (chunk >= maxNumChunks)
+    throw CapacityExceeded("Too many entries.");
+  
+  if (!chunks_[chunk])
+    chunks_[chunk] = new T[chunkSize];
+  
+  chunks_[chunk][size_%chunkSize] = entry;
+  
+  return size_++;
+}
+
+}
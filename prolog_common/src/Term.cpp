@@ -16,12 +16,22 @@
  * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
  ******************************************************************************/
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#include <boost/functional/hash.hpp>
+
 #include <prolog_common/Atom.h>
 #include <prolog_common/Compound.h>
 #include <prolog_common/Float.h>
 #include <prolog_common/Integer.h>
 #include <prolog_common/List.h>
-#include <prolog_common/Number.h>
+#include <prolog_common/String.h>
+#include <prolog_common/SymbolTable.h>
+#include <prolog_common/TermArena.h>
+#include <prolog_common/TermVisitor.h>
 #include <prolog_common/Variable.h>
 
 #include "prolog_common/Term.h"
@@ -32,7 +42,8 @@ namespace prolog {
 /* Constructors and Destructor                                               */
 /*****************************************************************************/
 
-Term::Term() {
+Term::Term() :
+  type_(InvalidType) {
 }
 
 Term::Term(const char* name) :
@@ -40,10 +51,14 @@ Term::Term(const char* name) :
 }
 
 Term::Term(const std::string& name) {
-  if (!name.empty() && ((name[0] == toupper(name[0])) || (name[0] == '_')))
+  if (!name.empty() && ((name[0] == toupper(name[0])) || (name[0] == '_'))) {
+    type_ = VariableType;
     impl_.reset(new Variable::Impl(name));
-  else
-    impl_.reset(new Atom::Impl(name));
+  }
+  else {
+    type_ = AtomType;
+    value_.atom_ = SymbolTable::internAtom(name);
+  }
 }
 
 Term::Term(int value) :
@@ -51,32 +66,59 @@ Term::Term(int value) :
 }
 
 Term::Term(int64_t value) :
-  impl_(new Integer::Impl(value)) {
+  type_(IntegerType) {
+  value_.integer_ = value;
 }
 
 Term::Term(double value) :
-  impl_(new Float::Impl(value)) {
+  type_(FloatType) {
+  value_.float_ = value;
 }
 
 Term::Term(const std::list<Term>& elements) :
+  type_(ListType),
   impl_(new List::Impl(elements)) {
 }
 
+Term::Term(std::list<Term>&& elements) :
+  type_(ListType),
+  impl_(new List::Impl(std::move(elements))) {
+}
+
 Term::Term(const std::initializer_list<Term>& elements) :
-  impl_(new List::Impl(elements)) {
+  type_(ListType),
+  impl_(new List::Impl(std::vector<Term>(elements))) {
 }
 
 Term::Term(const std::string& functor, const std::vector<Term>& arguments) :
+  type_(CompoundType),
   impl_(new Compound::Impl(functor, arguments)) {
 }
 
+Term::Term(const std::string& functor, std::vector<Term>&& arguments) :
+  type_(CompoundType),
+  impl_(new Compound::Impl(functor, std::move(arguments))) {
+}
+
 Term::Term(const std::string& functor, const std::initializer_list<Term>&
     arguments) :
+  type_(CompoundType),
   impl_(new Compound::Impl(functor, arguments)) {
 }
 
 Term::Term(const Term& src) :
+  type_(src.type_),
+  value_(src.value_),
   impl_(src.impl_) {
+  if (impl_.get() && !impl_.use_count())
+    impl_ = TermArena::Impl::share(impl_.get());
+}
+
+Term::Term(Term&& src) :
+  type_(src.type_),
+  value_(src.value_),
+  impl_(std::move(src.impl_)) {
+  src.type_ = InvalidType;
 }
 
 Term::~Term() {  
@@ -92,34 +134,320 @@ Term::Impl::~Impl() {
 /* Accessors                                                                 */
 /*****************************************************************************/
 
+Term::Type Term::getType() const {
+  return type_;
+}
+
 bool Term::isAtom() const {
-  return boost::dynamic_pointer_cast<Atom::Impl>(impl_).get();
+  return (type_ == AtomType);
 }
 
 bool Term::isCompound() const {
-  return boost::dynamic_pointer_cast<Compound::Impl>(impl_).get();
+  return (type_ == CompoundType);
 }
 
 bool Term::isList() const {
-  return boost::dynamic_pointer_cast<List::Impl>(impl_).get();
+  return (type_ == ListType);
 }
 
 bool Term::isNumber() const {
-  return boost::dynamic_pointer_cast<Number::Impl>(impl_).get();
+  return (type_ == IntegerType) || (type_ == FloatType);
+}
+
+bool Term::isString() const {
+  return (type_ == StringType);
 }
 
 bool Term::isVariable() const {
-  return boost::dynamic_pointer_cast<Variable::Impl>(impl_).get();
+  return (type_ == VariableType);
 }
 
 bool Term::isValid() const {
-  return impl_.get();
+  return (type_ != InvalidType);
+}
+
+size_t Term::getHash() const {
+  size_t hash = boost::hash_value(static_cast<int>(type_));
+  
+  if (type_ == AtomType)
+    boost::hash_combine(hash, value_.atom_);
+  else if (type_ == IntegerType)
+    boost::hash_combine(hash, value_.integer_);
+  else if (type_ == FloatType) {
+    uint64_t bits;
+    
+    std::memcpy(&bits, &value_.float_, sizeof(bits));
+    boost::hash_combine(hash, bits);
+  }
+  else if (type_ == StringType)
+    boost::hash_combine(hash, String(*this).getValue());
+  else if (type_ == VariableType)
+    boost::hash_combine(hash, Variable(*this).getName());
+  else if (type_ == CompoundType) {
+    const Compound::Impl& impl = static_cast<const Compound::Impl&>(*impl_);
+    size_t cached = impl.hash_;
+    
+    if (!cached) {
+      boost::hash_combine(hash, impl.functor_);
+      
+      for (Compound::ConstIterator it = impl.arguments_.begin();
+          it != impl.arguments_.end(); ++it)
+        boost::hash_combine(hash, it->getHash());
+        
+      cached = hash ? hash : 1;
+      impl.hash_ = cached;
+    }
+    
+    return cached;
+  }
+  else if (type_ == ListType) {
+    List list(*this);
+    
+    for (List::ConstIterator it = list.begin(); it != list.end(); ++it)
+      boost::hash_combine(hash, it->getHash());
+    
+    boost::hash_combine(hash, list.getTail().getHash());
+  }
+  
+  return hash;
+}
+
+/*****************************************************************************/
+/* Methods                                                                   */
+/*****************************************************************************/
+
+int Term::compare(const Term& term) const {
+  static const int ranks[] = {0, 3, 5, 2, 2, 5, 4, 1};
+  
+  int rank = (isList() && List(*this).isEmpty() &&
+    !List(*this).isPartial()) ? 3 : ranks[type_];
+  int termRank = (term.isList() && List(term).isEmpty() &&
+    !List(term).isPartial()) ? 3 : ranks[term.type_];
+  
+  if (rank != termRank)
+    return (rank < termRank) ? -1 : 1;
+  
+  if (rank == 1)
+    return Variable(*this).getName().compare(Variable(term).getName());
+  else if (rank == 2) {
+    if ((type_ == IntegerType) && (term.type_ == IntegerType))
+      return (value_.integer_ < term.value_.integer_) ? -1 :
+        (value_.integer_ > term.value_.integer_) ? 1 : 0;
+    
+    double value = (type_ == IntegerType) ?
+      static_cast<double>(value_.integer_) : value_.float_;
+    double termValue = (term.type_ == IntegerType) ?
+      static_cast<double>(term.value_.integer_) : term.value_.float_;
+      
+    if (std::isnan(value) != std::isnan(termValue))
+      return std::isnan(value) ? -1 : 1;
+    else if ((value != termValue) && !std::isnan(value))
+      return (value < termValue) ? -1 : 1;
+    else if (type_ != term.type_)
+      return (type_ == FloatType) ? -1 : 1;
+    else if ((type_ == FloatType) && !(*this == term)) {
+      if (std::signbit(value) != std::signbit(termValue))
+        return std::signbit(value) ? -1 : 1;
+      
+      uint64_t bits;
+      uint64_t termBits;
+      
+      std::memcpy(&bits, &value, sizeof(bits));
+      std::memcpy(&termBits, &termValue, sizeof(termBits));
+      
+      return (bits < termBits) ? -1 : 1;
+    }
+  }
+  else if (rank == 3) {
+    if ((type_ == AtomType) && (term.type_ == AtomType) &&
+        (value_.atom_ == term.value_.atom_))
+      return 0;
+      
+    static const std::string nil("[]");
+    
+    const std::string& name = isAtom() ?
+      SymbolTable::getAtomName(value_.atom_) : nil;
+    const std::string& termName = term.isAtom() ?
+      SymbolTable::getAtomName(term.value_.atom_) : nil;
+    
+    int result = name.compare(termName);
+    
+    if (result || (type_ == term.type_))
+      return result;
+    else
+      return isList() ? 1 : -1;
+  }
+  else if (rank == 4) {
+    if (impl_ == term.impl_)
+      return 0;
+    
+    return String(*this).getValue().compare(String(term).getValue());
+  }
+  else if (rank == 5) {
+    static const std::string cons("[|]");
+    
+    size_t arity = isList() ? 2 : Compound(*this).getArity();
+    size_t termArity = term.isList() ? 2 : Compound(term).getArity();
+    
+    if (arity != termArity)
+      return (arity < termArity) ? -1 : 1;
+    
+    int result = (isList() ? cons : Compound(*this).getFunctor()).compare(
+      term.isList() ? cons : Compound(term).getFunctor());
+    
+    if (result)
+      return result;
+    else if (type_ != term.type_)
+      return isList() ? 1 : -1;
+    else if (impl_ == term.impl_)
+      return 0;
+    
+    if (isCompound()) {
+      const Compound::Arguments& arguments =
+        static_cast<const Compound::Impl&>(*impl_).arguments_;
+      const Compound::Arguments& termArguments =
+        static_cast<const Compound::Impl&>(*term.impl_).arguments_;
+      
+      for (size_t index = 0; index < arguments.size(); ++index) {
+        result = arguments[index].compare(termArguments[index]);
+        
+        if (result)
+          return result;
+      }
+    }
+    else {
+      List list(*this);
+      List termList(term);
+      
+      List::ConstIterator it = list.begin();
+      List::ConstIterator jt = termList.begin();
+      
+      for ( ; (it != list.end()) && (jt != termList.end()); ++it, ++jt) {
+        result = it->compare(*jt);
+        
+        if (result)
+          return result;
+      }
+      
+      if (it != list.end())
+        return 1;
+      else if (jt != termList.end())
+        return -1;
+      
+      const Term& tail = list.getTail();
+      const Term& termTail = termList.getTail();
+      
+      if (tail.isValid() != termTail.isValid())
+        return tail.isValid() ? 1 : -1;
+      else
+        return tail.compare(termTail);
+    }
+  }
+  
+  return 0;
+}
+
+void Term::accept(TermVisitor& visitor) const {
+  switch (type_) {
+    case AtomType:
+      visitor.visitAtom(*this);
+      break;
+    case CompoundType:
+      visitor.visitCompound(*this);
+      break;
+    case FloatType:
+      visitor.visitFloat(*this);
+      break;
+    case IntegerType:
+      visitor.visitInteger(*this);
+      break;
+    case ListType:
+      visitor.visitList(*this);
+      break;
+    case StringType:
+      visitor.visitString(*this);
+      break;
+    case VariableType:
+      visitor.visitVariable(*this);
+      break;
+    default:
+      break;
+  }
 }
 
 /*****************************************************************************/
 /* Operators                                                                 */
 /*****************************************************************************/
 
+bool Term::operator==(const Term& term) const {
+  if (type_ != term.type_)
+    return false;
+  
+  if (type_ == AtomType)
+    return (value_.atom_ == term.value_.atom_);
+  else if (type_ == IntegerType)
+    return (value_.integer_ == term.value_.integer_);
+  else if (type_ == FloatType)
+    return !std::memcmp(&value_.float_, &term.value_.float_,
+      sizeof(value_.float_));
+  else if ((type_ == StringType) && (impl_ != term.impl_))
+    return (String(*this).getValue() == String(term).getValue());
+  else if (type_ == VariableType)
+    return (Variable(*this).getName() == Variable(term).getName());
+  else if ((type_ == CompoundType) && (impl_ != term.impl_)) {
+    const Compound::Impl& impl = static_cast<const Compound::Impl&>(*impl_);
+    const Compound::Impl& termImpl =
+      static_cast<const Compound::Impl&>(*term.impl_);
+    
+    if (impl.functor_ != termImpl.functor_)
+      return false;
+    
+    return (impl.arguments_ == termImpl.arguments_);
+  }
+  else if ((type_ == ListType) && (impl_ != term.impl_)) {
+    List list(*this);
+    List termList(term);
+    
+    if (list.getNumElements() != termList.getNumElements())
+      return false;
+    
+    return std::equal(list.begin(), list.end(), termList.begin()) &&
+      (list.getTail() == termList.getTail());
+  }
+  
+  return true;
+}
+
+bool Term::operator!=(const Term& term) const {
+  return !operator==(term);
+}
+
+bool Term::operator<(const Term& term) const {
+  return (compare(term) < 0);
+}
+
+
+Term& Term::operator=(const Term& src) {
+  type_ = src.type_;
+  value_ = src.value_;
+  impl_ = src.impl_;
+  
+  if (impl_.get() && !impl_.use_count())
+    impl_ = TermArena::Impl::share(impl_.get());
+  
+  return *this;
+}
+
+Term& Term::operator=(Term&& src) {
+  type_ = src.type_;
+  value_ = src.value_;
+  impl_ = std::move(src.impl_);
+  
+  src.type_ = InvalidType;
+  
+  return *this;
+}
+
 Compound Term::operator&(const Term& term) const {
   return Compound("','", {*this, term});
 }
@@ -128,4 +456,8 @@ Compound Term::operator|(const Term& term) const {
   return Compound("';'", {*this, term});
 }
 
+size_t hash_value(const Term& term) {
+  return term.getHash();
+}
+
 }
@@ -0,0 +1,211 @@
+/******************************************************************************
+ * Copyright (C) 2016 by Ralf Kaestner                                        *
+ * ralf.kaestner@gmail.com                                                    *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the               *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+#include <algorithm>
+#include <new>
+
+#include <prolog_common/Compound.h>
+#include <prolog_common/List.h>
+#include <prolog_common/SymbolTable.h>
+#include <prolog_common/Variable.h>
+
+#include "prolog_common/TermArena.h"
+
+namespace prolog {
+
+/*****************************************************************************/
+/* Constructors and Destructor                                               */
+/*****************************************************************************/
+
+TermArena::TermArena(size_t blockSize) :
+  impl_(new Impl(blockSize)) {
+}
+
+TermArena::TermArena(const TermArena& src) :
+  impl_(src.impl_) {
+}
+
+TermArena::~TermArena() {
+}
+
+TermArena::Impl::Impl(size_t blockSize) :
+  blockSize_(blockSize),
+  numBytes_(0),
+  current_(0),
+  available_(0),
+  headers_(0) {
+  BOOST_ASSERT(blockSize);
+}
+
+TermArena::Impl::~Impl() {
+  for (Header* header = headers_; header; header = header->next_)
+    header->impl_->~Impl();
+  
+  for (std::vector<char*>::iterator it = blocks_.begin();
+      it != blocks_.end(); ++it)
+    delete[] *it;
+}
+
+/*****************************************************************************/
+/* Accessors                                                                 */
+/*****************************************************************************/
+
+size_t TermArena::getBlockSize() const {
+  return impl_->blockSize_;
+}
+
+size_t TermArena::getNumBytes() const {
+  return impl_->numBytes_;
+}
+
+/*****************************************************************************/
+/* Methods                                                                   */
+/*****************************************************************************/
+
+Compound TermArena::createCompound(const std::string& functor, const
+    std::vector<Term>& arguments) {
+  BOOST_ASSERT(!arguments.empty());
+  
+  Compound::Impl* impl = new(impl_->allocateTerm(sizeof(Compound::Impl),
+    alignof(Compound::Impl))) Compound::Impl(SymbolTable::internFunctor(
+    functor, arguments.size()), TermAllocator<Term>(*this));
+  Term compound;
+  
+  compound.type_ = Term::CompoundType;
+  compound.impl_ = impl_->adopt(impl);
+  
+  for (size_t index = 0; index < arguments.size(); ++index)
+    Impl::store(impl->arguments_[index], arguments[index], impl_);
+  
+  return compound;
+}
+
+List TermArena::createList(const std::vector<Term>& elements, const Term&
+    tail) {
+  List::Impl* impl = new(impl_->allocateTerm(sizeof(List::Impl),
+    alignof(List::Impl))) List::Impl(TermAllocator<Term>(*this),
+    elements.size());
+  Term list;
+  
+  list.type_ = Term::ListType;
+  list.impl_ = impl_->adopt(impl);
+  
+  impl->elements_.resize(elements.size());
+  impl->size_ = elements.size();
+  
+  for (size_t index = 0; index < elements.size(); ++index)
+    Impl::store(impl->elements_[index], elements[index], impl_);
+  
+  if (tail.isList()) {
+    List tailList(tail);
+    
+    if (!tailList.isEmpty() || tailList.isPartial()) {
+      Term next;
+      
+      Impl::store(next, tailList, impl_);
+      impl->next_ = boost::static_pointer_cast<List::Impl>(next.impl_);
+      impl->size_ += impl->next_->size_;
+    }
+  }
+  else {
+    BOOST_ASSERT(!tail.isValid() || tail.isVariable());
+    
+    Impl::store(impl->tail_, tail, impl_);
+  }
+  
+  return list;
+}
+
+Variable TermArena::createVariable(const std::string& name) {
+  Term variable;
+  
+  variable.type_ = Term::VariableType;
+  variable.impl_ = impl_->adopt(new(impl_->allocateTerm(
+    sizeof(Variable::Impl), alignof(Variable::Impl))) Variable::Impl(name));
+  
+  return variable;
+}
+
+void* TermArena::Impl::allocate(size_t size, size_t alignment) {
+  size_t padding = reinterpret_cast<uintptr_t>(current_) % alignment;
+  
+  if (padding)
+    padding = alignment-padding;
+  
+  if (!current_ || (padding+size > available_)) {
+    size_t blockSize = std::max(blockSize_, size+alignment);
+    
+    blocks_.push_back(new char[blockSize]);
+    
+    current_ = blocks_.back();
+    available_ = blockSize;
+    numBytes_ += blockSize;
+    
+    padding = reinterpret_cast<uintptr_t>(current_) % alignment;
+    
+    if (padding)
+      padding = alignment-padding;
+  }
+  
+  void* memory = current_+padding;
+  
+  current_ += padding+size;
+  available_ -= padding+size;
+  
+  return memory;
+}
+
+void* TermArena::Impl::allocateTerm(size_t size, size_t alignment) {
+  BOOST_ASSERT(alignment <= alignof(Header));
+  
+  Header* header = new(allocate(sizeof(Header)+size, alignof(Header)))
+    Header();
+  
+  header->arena_ = this;
+  
+  return header+1;
+}
+
+boost::shared_ptr<Term::Impl> TermArena::Impl::adopt(Term::Impl* impl) {
+  Header* header = reinterpret_cast<Header*>(impl)-1;
+  
+  header->impl_ = impl;
+  header->next_ = headers_;
+  headers_ = header;
+  
+  return boost::shared_ptr<Term::Impl>(shared_from_this(), impl);
+}
+
+void TermArena::Impl::store(Term& slot, const Term& term, const
+    boost::shared_ptr<Impl>& arena) {
+  slot = term;
+  
+  if (slot.impl_.get() && !slot.impl_.owner_before(arena) &&
+      !arena.owner_before(slot.impl_))
+    slot.impl_ = boost::shared_ptr<Term::Impl>(
+      boost::shared_ptr<Term::Impl>(), slot.impl_.get());
+}
+
+boost::shared_ptr<Term::Impl> TermArena::Impl::share(Term::Impl* impl) {
+  Header* header = reinterpret_cast<Header*>(impl)-1;
+  
+  return boost::shared_ptr<Term::Impl>(header->arena_->shared_from_this(),
+    impl);
+}
+
+}
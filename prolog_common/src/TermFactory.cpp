@@ -0,0 +1,175 @@
+/******************************************************************************
+ * Copyright (C) 2016 by Ralf Kaestner                                        *
+ * ralf.kaestner@gmail.com                                                    *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the               *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+#include <algorithm>
+
+#include "prolog_common/TermFactory.h"
+
+namespace prolog {
+
+/*****************************************************************************/
+/* Constructors and Destructor                                               */
+/*****************************************************************************/
+
+TermFactory::TermFactory() :
+  impl_(new Impl()) {
+}
+
+TermFactory::TermFactory(const TermFactory& src) :
+  impl_(src.impl_) {
+}
+
+TermFactory::~TermFactory() {
+}
+
+TermFactory::Impl::Impl() :
+  collectionThreshold_(1024) {
+}
+
+TermFactory::Impl::~Impl() {
+}
+
+/*****************************************************************************/
+/* Accessors                                                                 */
+/*****************************************************************************/
+
+size_t TermFactory::getNumTerms() const {
+  boost::mutex::scoped_lock lock(impl_->mutex_);
+  
+  return impl_->terms_.size();
+}
+
+bool TermFactory::Impl::isCanonical(const Term& term) const {
+  if (term.isVariable())
+    return false;
+  else if (term.isCompound() || term.isList()) {
+    boost::unordered_set<Term>::const_iterator it = terms_.find(term);
+    
+    return (it != terms_.end()) && (it->impl_ == term.impl_);
+  }
+  else
+    return true;
+}
+
+/*****************************************************************************/
+/* Methods                                                                   */
+/*****************************************************************************/
+
+Compound TermFactory::createCompound(const std::string& functor, const
+    std::vector<Term>& arguments) {
+  return impl_->intern(Compound(functor, arguments));
+}
+
+Compound TermFactory::createCompound(const std::string& functor,
+    std::vector<Term>&& arguments) {
+  return impl_->intern(Compound(functor, std::move(arguments)));
+}
+
+List TermFactory::createList(std::vector<Term>&& elements, const Term&
+    tail) {
+  if (tail.isValid())
+    return List(elements, tail);
+  else
+    return impl_->intern(List(std::move(elements)));
+}
+
+Term TermFactory::canonicalize(const Term& term) {
+  if (term.isCompound()) {
+    const Compound compound(term);
+    std::vector<Term> arguments;
+    
+    arguments.reserve(compound.getArity());
+    for (Compound::ConstIterator it = compound.begin();
+        it != compound.end(); ++it)
+      arguments.push_back(canonicalize(*it));
+    
+    return createCompound(compound.getFunctor(), std::move(arguments));
+  }
+  else if (term.isList()) {
+    List list(term);
+    std::vector<Term> elements;
+    
+    elements.reserve(list.getNumElements());
+    for (List::ConstIterator it = list.begin(); it != list.end(); ++it)
+      elements.push_back(canonicalize(*it));
+    
+    return createList(std::move(elements), list.getTail());
+  }
+  else
+    return term;
+}
+
+void TermFactory::collect() {
+  boost::mutex::scoped_lock lock(impl_->mutex_);
+  
+  impl_->collect();
+}
+
+void TermFactory::clear() {
+  boost::mutex::scoped_lock lock(impl_->mutex_);
+  
+  impl_->terms_.clear();
+}
+
+Term TermFactory::Impl::intern(Term&& term) {
+  boost::mutex::scoped_lock lock(mutex_);
+  
+  if (term.isCompound()) {
+    const Compound compound(term);
+    
+    for (Compound::ConstIterator it = compound.begin();
+        it != compound.end(); ++it)
+      if (!isCanonical(*it))
+        return std::move(term);
+  }
+  else {
+    List list(term);
+    
+    for (List::ConstIterator it = list.begin(); it != list.end(); ++it)
+      if (!isCanonical(*it))
+        return std::move(term);
+  }
+  
+  if (terms_.size() >= collectionThreshold_) {
+    collect();
+    collectionThreshold_ = std::max(collectionThreshold_,
+      2*terms_.size());
+  }
+  
+  return *terms_.insert(std::move(term)).first;
+}
+
+void TermFactory::Impl::collect() {
+  bool collected = true;
+  
+  while (collected) {
+    collected = false;
+    
+    for (boost::unordered_set<Term>::iterator it = terms_.begin();
+        it != terms_.end(); ) {
+      if (it->impl_.use_count() == 1) {
+        it = terms_.erase(it);
+        collected = true;
+      }
+      else
+        ++it;
+    }
+  }
+}
+
+}
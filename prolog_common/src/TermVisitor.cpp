@@ -0,0 +1,64 @@
+/******************************************************************************
+ * Copyright (C) 2016 by Ralf Kaestner                                        *
+ * ralf.kaestner@gmail.com                                                    *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the               *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+#include "prolog_common/TermVisitor.h"
+
+namespace prolog {
+
+/*****************************************************************************/
+/* Constructors and Destructor                                               */
+/*****************************************************************************/
+
+TermVisitor::TermVisitor() {
+}
+
+TermVisitor::~TermVisitor() {
+}
+
+/*****************************************************************************/
+/* Methods                                                                   */
+/*****************************************************************************/
+
+void TermVisitor::visitAtom(const Atom&) {
+}
+
+void TermVisitor::visitCompound(const Compound&) {
+}
+
+void TermVisitor::visitFloat(const Float&) {
+}
+
+void TermVisitor::visitInteger(const Integer&) {
+}
+
+void TermVisitor::visitList(const List&) {
+}
+
+void TermVisitor::visitString(const String&) {
+}
+
+void TermVisitor::visitVariable(const Variable&) {
+}
+
+void TermVisitor::leaveCompound(const Compound&) {
+}
+
+void TermVisitor::leaveList(const List&) {
+}
+
+}
@@ -0,0 +1,97 @@
+/******************************************************************************
+ * Copyright (C) 2016 by Ralf Kaestner                                        *
+ * ralf.kaestner@gmail.com                                                    *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the               *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+#include "prolog_common/TermWalker.h"
+
+namespace prolog {
+
+/*****************************************************************************/
+/* Constructors and Destructor                                               */
+/*****************************************************************************/
+
+TermWalker::TermWalker() {
+}
+
+TermWalker::TermWalker(const TermWalker&) {
+}
+
+TermWalker::~TermWalker() {
+}
+
+TermWalker::Frame::Frame(const Term& term) :
+  term_(term),
+  entered_(false),
+  tail_(false) {
+}
+
+/*****************************************************************************/
+/* Methods                                                                   */
+/*****************************************************************************/
+
+void TermWalker::walk(const Term& term, TermVisitor& visitor) {
+  frames_.clear();
+  frames_.push_back(Frame(term));
+  
+  while (!frames_.empty()) {
+    Frame& frame = frames_.back();
+    
+    if (!frame.entered_) {
+      frame.term_.accept(visitor);
+      frame.entered_ = true;
+      
+      if (frame.term_.isCompound()) {
+        const Compound compound(frame.term_);
+        
+        frame.argument_ = compound.begin();
+        frame.argumentsEnd_ = compound.end();
+      }
+      else if (frame.term_.isList()) {
+        const List list(frame.term_);
+        
+        frame.element_ = list.begin();
+        frame.elementsEnd_ = list.end();
+      }
+      else
+        frames_.pop_back();
+    }
+    else if (frame.term_.isCompound()) {
+      if (frame.argument_ != frame.argumentsEnd_)
+        frames_.push_back(Frame(*frame.argument_++));
+      else {
+        visitor.leaveCompound(frame.term_);
+        frames_.pop_back();
+      }
+    }
+    else if (frame.element_ != frame.elementsEnd_)
+      frames_.push_back(Frame(*frame.element_++));
+    else {
+      const List list(frame.term_);
+      
+      if (list.isPartial() && !frame.tail_) {
+        frame.tail_ = true;
+        frames_.push_back(Frame(list.getTail()));
+      }
+      else {
+        visitor.leaveList(list);
+        frames_.pop_back();
+      }
+    }
+  }
+}
+
+}
@@ -29,6 +29,7 @@ Variable::Variable(const char* name) :
 }
 
 Variable::Variable(const std::string& name) {
+  type_ = VariableType;
   impl_.reset(new Impl(name));
 }
 
@@ -38,7 +39,7 @@ Variable::Variable(const Variable& src) :
 
 Variable::Variable(const Term& src) :
   Term(src) {
-  BOOST_ASSERT(boost::dynamic_pointer_cast<Impl>(impl_));
+  BOOST_ASSERT(isVariable());
 }
 
 Variable::~Variable() {  
@@ -58,7 +59,7 @@ Variable::Impl::~Impl() {
 /* Accessors                                                                 */
 /*****************************************************************************/
 
-std::string Variable::getName() const {
+const std::string& Variable::getName() const {
   return boost::static_pointer_cast<Impl>(impl_)->name_;
 }
 
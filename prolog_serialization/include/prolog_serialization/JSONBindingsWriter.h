@@ -0,0 +1,132 @@
+/******************************************************************************
+ * Copyright (C) 2016 by Ralf Kaestner                                        *
+ * ralf.kaestner@gmail.com                                                    *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the               *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+/** \file JSONBindingsWriter.h
+  * \brief Header file providing the JSONBindingsWriter class interface
+  */
+
+#ifndef ROS_PROLOG_SERIALIZATION_JSON_BINDINGS_WRITER_H
+#define ROS_PROLOG_SERIALIZATION_JSON_BINDINGS_WRITER_H
+
+#include <string>
+#include <vector>
+
+#include <prolog_common/BindingsWriter.h>
+
+namespace prolog {
+  namespace serialization {
+    /** \brief Prolog bindings writer for the JSON format
+      * 
+      * This Prolog bindings writer appends the bindings it receives to
+      * an output buffer as unstyled JSON text, in the format produced by
+      * the JSON serializer, but without building Prolog terms or a JSON
+      * document. Unbound slots are omitted from the output.
+      */
+    class JSONBindingsWriter :
+      public BindingsWriter {
+    public:
+      /** \brief Default constructor
+        */
+      JSONBindingsWriter();
+      
+      /** \brief Destructor
+        */
+      virtual ~JSONBindingsWriter();
+      
+      /** \brief Retrieve the output of this JSON bindings writer
+        */
+      const std::string& getOutput() const;
+      
+      /** \brief Clear the output of this JSON bindings writer
+        */
+      void clear();
+      
+      /** \brief Begin writing Prolog bindings (implementation)
+        */
+      void beginBindings(const BindingsSchema& schema);
+      
+      /** \brief End writing Prolog bindings (implementation)
+        */
+      void endBindings();
+      
+      /** \brief Put an unbound slot (implementation)
+        */
+      void putUnbound();
+      
+      /** \brief Put an atom (implementation)
+        */
+      void putAtom(const char* name, size_t length);
+      
+      /** \brief Put an integer number (implementation)
+        */
+      void putInteger(int64_t value);
+      
+      /** \brief Put a floating point number (implementation)
+        */
+      void putFloat(double value);
+      
+      /** \brief Put a string (implementation)
+        */
+      void putString(const char* value, size_t length);
+      
+      /** \brief Put a variable (implementation)
+        */
+      void putVariable(const char* name, size_t length);
+      
+      /** \brief Put a compound (implementation)
+        */
+      void putCompound(const char* functor, size_t length, size_t arity);
+      
+      /** \brief Put a list (implementation)
+        */
+      void putList(size_t numElements, bool partial = false);
+      
+    protected:
+      /** \brief Compound term or list being written by a JSON bindings
+        *   writer
+        */
+      class Frame {
+      public:
+        enum Type {
+          CompoundFrame,
+          ListFrame,
+          PartialListFrame
+        };
+        
+        Frame(Type type, size_t numTerms);
+        
+        Type type_;
+        size_t numTerms_;
+        size_t index_;
+      };
+      
+      void beginTerm();
+      void endTerm();
+      
+      void writeQuoted(const char* chars, size_t length);
+      
+      BindingsSchema schema_;
+      size_t slot_;
+      size_t numBound_;
+      std::vector<Frame> frames_;
+      std::string output_;
+    };
+  };
+};
+
+#endif
@@ -25,6 +25,9 @@
 
 #include <ros/exception.h>
 
+#include <prolog_common/TermArena.h>
+#include <prolog_common/TermFactory.h>
+
 #include <prolog_serialization/Deserializer.h>
 
 namespace Json {
@@ -66,6 +69,17 @@ namespace prolog {
         */
       Bindings deserializeBindings(std::istream& stream) const;
       
+      /** \brief Deserialize some Prolog bindings into a Prolog term arena
+        */
+      Bindings deserializeBindings(std::istream& stream, TermArena& arena)
+        const;
+      
+      /** \brief Deserialize some Prolog bindings through a hash-consing
+        *   Prolog term factory
+        */
+      Bindings deserializeBindings(std::istream& stream, TermFactory&
+        factory) const;
+      
       /** \brief Deserialize a Prolog clause (implementation)
         */
       Clause deserializeClause(std::istream& stream) const;
@@ -82,6 +96,16 @@ namespace prolog {
         */
       Term deserializeTerm(std::istream& stream) const;
       
+      /** \brief Deserialize a Prolog term into a Prolog term arena
+        */
+      Term deserializeTerm(std::istream& stream, TermArena& arena) const;
+      
+      /** \brief Deserialize a Prolog term through a hash-consing Prolog
+        *   term factory
+        */
+      Term deserializeTerm(std::istream& stream, TermFactory& factory)
+        const;
+      
       /** \brief Deserialize a JSON value
         */
       Json::Value deserializeValue(std::istream& stream) const;
@@ -90,6 +114,18 @@ namespace prolog {
         */
       Bindings valueToBindings(const Json::Value& value) const;
       
+      /** \brief Convert a JSON value to some Prolog bindings which are
+        *   built into a Prolog term arena
+        */
+      Bindings valueToBindings(const Json::Value& value, TermArena& arena)
+        const;
+      
+      /** \brief Convert a JSON value to some Prolog bindings which are
+        *   built through a hash-consing Prolog term factory
+        */
+      Bindings valueToBindings(const Json::Value& value, TermFactory&
+        factory) const;
+      
       /** \brief Convert a JSON value to a Prolog clause
         */
       Clause valueToClause(const Json::Value& value) const;
@@ -105,6 +141,30 @@ namespace prolog {
       /** \brief Convert a JSON value to a Prolog term
         */
       Term valueToTerm(const Json::Value& value) const;
+      
+      /** \brief Convert a JSON value to a Prolog term which is built
+        *   into a Prolog term arena
+        */
+      Term valueToTerm(const Json::Value& value, TermArena& arena) const;
+      
+      /** \brief Convert a JSON value to a Prolog term which is built
+        *   through a hash-consing Prolog term factory
+        */
+      Term valueToTerm(const Json::Value& value, TermFactory& factory)
+        const;
+      
+    private:
+      /** \brief Convert a JSON value to some Prolog bindings, optionally
+        *   built into a Prolog term arena or through a Prolog term factory
+        */
+      Bindings valueToBindings(const Json::Value& value, TermArena* arena,
+        TermFactory* factory) const;
+        
+      /** \brief Convert a JSON value to a Prolog term, optionally built
+        *   into a Prolog term arena or through a Prolog term factory
+        */
+      Term valueToTerm(const Json::Value& value, TermArena* arena,
+        TermFactory* factory) const;
     };
   };
 };
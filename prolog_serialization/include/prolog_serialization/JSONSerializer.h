@@ -24,6 +24,9 @@
 #define ROS_PROLOG_SERIALIZATION_JSON_SERIALIZER_H
 
 #include <string>
+#include <vector>
+
+#include <prolog_common/TermVisitor.h>
 
 #include <prolog_serialization/Serializer.h>
 
@@ -149,6 +152,13 @@ namespace prolog {
         */
       Json::Value ruleToValue(const Rule& rule) const;
       
+      /** \brief Convert a Prolog string to a JSON value
+        * 
+        * Strings are represented by objects with a single member named
+        * string, which distinguishes them from atoms and variables.
+        */
+      Json::Value stringToValue(const String& string) const;
+      
       /** \brief Convert a Prolog term to a JSON value
         */
       Json::Value termToValue(const Term& term) const;
@@ -157,6 +167,33 @@ namespace prolog {
         */
       Json::Value variableToValue(const Variable& variable) const;
       
+    protected:
+      /** \brief Prolog term visitor converting the terms visited by a
+        *   Prolog term walker to a JSON value
+        */
+      class ValueBuilder :
+        public TermVisitor {
+      public:
+        ValueBuilder(const JSONSerializer& serializer, Json::Value&
+          value);
+        
+        void visitAtom(const Atom& atom);
+        void visitCompound(const Compound& compound);
+        void visitFloat(const Float& number);
+        void visitInteger(const Integer& number);
+        void visitList(const List& list);
+        void visitString(const String& string);
+        void visitVariable(const Variable& variable);
+        void leaveCompound(const Compound& compound);
+        void leaveList(const List& list);
+        
+        Json::Value& append(const Json::Value& value);
+        
+        const JSONSerializer& serializer_;
+        Json::Value& value_;
+        std::vector<Json::Value*> values_;
+      };
+      
     private:
       OutputFormat outputFormat_;
       std::string outputIndent_;
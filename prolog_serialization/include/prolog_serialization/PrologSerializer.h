@@ -23,6 +23,10 @@
 #ifndef ROS_PROLOG_SERIALIZATION_PROLOG_SERIALIZER_H
 #define ROS_PROLOG_SERIALIZATION_PROLOG_SERIALIZER_H
 
+#include <vector>
+
+#include <prolog_common/TermVisitor.h>
+
 #include <prolog_serialization/Serializer.h>
 
 namespace prolog {
@@ -96,10 +100,48 @@ namespace prolog {
         */
       void serializeRule(std::ostream& stream, const Rule& rule) const;
       
+      /** \brief Serialize a Prolog string
+        */
+      void serializeString(std::ostream& stream, const String& string)
+        const;
+      
       /** \brief Serialize a Prolog variable
         */
       void serializeVariable(std::ostream& stream, const Variable& variable)
         const;
+      
+    protected:
+      /** \brief Prolog term visitor writing the terms visited by a
+        *   Prolog term walker in the Prolog syntax format
+        */
+      class TermWriter :
+        public TermVisitor {
+      public:
+        TermWriter(const PrologSerializer& serializer, std::ostream&
+          stream);
+        
+        void visitAtom(const Atom& atom);
+        void visitCompound(const Compound& compound);
+        void visitFloat(const Float& number);
+        void visitInteger(const Integer& number);
+        void visitList(const List& list);
+        void visitString(const String& string);
+        void visitVariable(const Variable& variable);
+        void leaveCompound(const Compound& compound);
+        void leaveList(const List& list);
+        
+        void separate();
+        
+        struct Scope {
+          size_t numTerms_;
+          size_t numElements_;
+          bool list_;
+        };
+        
+        const PrologSerializer& serializer_;
+        std::ostream& stream_;
+        std::vector<Scope> scopes_;
+      };
     };
   };
 };
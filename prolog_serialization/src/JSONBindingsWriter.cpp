@@ -0,0 +1,263 @@
+/******************************************************************************
+ * Copyright (C) 2016 by Ralf Kaestner                                        *
+ * ralf.kaestner@gmail.com                                                    *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the               *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+#include <boost/assert.hpp>
+
+#include "prolog_serialization/JSONBindingsWriter.h"
+
+namespace prolog { namespace serialization {
+
+/*****************************************************************************/
+/* Constructors and Destructor                                               */
+/*****************************************************************************/
+
+JSONBindingsWriter::JSONBindingsWriter() :
+  slot_(0),
+  numBound_(0) {
+}
+
+JSONBindingsWriter::~JSONBindingsWriter() {
+}
+
+JSONBindingsWriter::Frame::Frame(Type type, size_t numTerms) :
+  type_(type),
+  numTerms_(numTerms),
+  index_(0) {
+}
+
+/*****************************************************************************/
+/* Accessors                                                                 */
+/*****************************************************************************/
+
+const std::string& JSONBindingsWriter::getOutput() const {
+  return output_;
+}
+
+/*****************************************************************************/
+/* Methods                                                                   */
+/*****************************************************************************/
+
+void JSONBindingsWriter::clear() {
+  schema_ = BindingsSchema();
+  slot_ = 0;
+  numBound_ = 0;
+  frames_.clear();
+  output_.clear();
+}
+
+void JSONBindingsWriter::beginBindings(const BindingsSchema& schema) {
+  schema_ = schema;
+  slot_ = 0;
+  numBound_ = 0;
+  frames_.clear();
+  
+  output_.push_back('{');
+}
+
+void JSONBindingsWriter::endBindings() {
+  BOOST_ASSERT(frames_.empty());
+  
+  output_.push_back('}');
+}
+
+void JSONBindingsWriter::putUnbound() {
+  BOOST_ASSERT(frames_.empty());
+  
+  ++slot_;
+}
+
+void JSONBindingsWriter::putAtom(const char* name, size_t length) {
+  beginTerm();
+  writeQuoted(name, length);
+  endTerm();
+}
+
+void JSONBindingsWriter::putInteger(int64_t value) {
+  char buffer[32];
+  
+  beginTerm();
+  output_.append(buffer, std::snprintf(buffer, sizeof(buffer), "%" PRId64,
+    value));
+  endTerm();
+}
+
+void JSONBindingsWriter::putFloat(double value) {
+  beginTerm();
+  
+  if (std::isnan(value))
+    output_.append("null");
+  else if (std::isinf(value))
+    output_.append(value < 0.0 ? "-1e+9999" : "1e+9999");
+  else {
+    char buffer[32];
+    size_t length = std::snprintf(buffer, sizeof(buffer), "%.17g", value);
+    
+    output_.append(buffer, length);
+    
+    if (!std::strpbrk(buffer, ".e"))
+      output_.append(".0");
+  }
+  
+  endTerm();
+}
+
+void JSONBindingsWriter::putString(const char* value, size_t length) {
+  beginTerm();
+  output_.append("{\"string\":");
+  writeQuoted(value, length);
+  output_.push_back('}');
+  endTerm();
+}
+
+void JSONBindingsWriter::putVariable(const char* name, size_t length) {
+  beginTerm();
+  writeQuoted(name, length);
+  endTerm();
+}
+
+void JSONBindingsWriter::putCompound(const char* functor, size_t length,
+    size_t arity) {
+  beginTerm();
+  output_.append("{\"functor\":");
+  writeQuoted(functor, length);
+  output_.append(",\"arguments\":[");
+  
+  frames_.push_back(Frame(Frame::CompoundFrame, arity));
+  
+  if (!arity)
+    endTerm();
+}
+
+void JSONBindingsWriter::putList(size_t numElements, bool partial) {
+  beginTerm();
+  
+  if (partial) {
+    if (numElements)
+      output_.append("{\"functor\":\"[|]\",\"arguments\":[");
+    
+    frames_.push_back(Frame(Frame::PartialListFrame, numElements+1));
+  }
+  else {
+    output_.push_back('[');
+    
+    frames_.push_back(Frame(Frame::ListFrame, numElements));
+    
+    if (!numElements)
+      endTerm();
+  }
+}
+
+void JSONBindingsWriter::beginTerm() {
+  if (frames_.empty()) {
+    BOOST_ASSERT(slot_ < schema_.getNumSlots());
+    
+    if (numBound_)
+      output_.push_back(',');
+    
+    const std::string& name = schema_.getSymbol(slot_).getName();
+    
+    writeQuoted(name.c_str(), name.length());
+    output_.push_back(':');
+    
+    ++slot_;
+    ++numBound_;
+  }
+  else {
+    const Frame& frame = frames_.back();
+    
+    if (frame.index_) {
+      output_.push_back(',');
+      
+      if ((frame.type_ == Frame::PartialListFrame) &&
+          (frame.index_+1 < frame.numTerms_))
+        output_.append("{\"functor\":\"[|]\",\"arguments\":[");
+    }
+  }
+}
+
+void JSONBindingsWriter::endTerm() {
+  while (!frames_.empty()) {
+    Frame& frame = frames_.back();
+    
+    if (frame.index_ < frame.numTerms_)
+      ++frame.index_;
+    
+    if (frame.index_ < frame.numTerms_)
+      break;
+    
+    if (frame.type_ == Frame::CompoundFrame)
+      output_.append("]}");
+    else if (frame.type_ == Frame::ListFrame)
+      output_.push_back(']');
+    else for (size_t index = 1; index < frame.numTerms_; ++index)
+      output_.append("]}");
+    
+    frames_.pop_back();
+  }
+}
+
+void JSONBindingsWriter::writeQuoted(const char* chars, size_t length) {
+  static const char* digits = "0123456789abcdef";
+  
+  output_.push_back('"');
+  
+  for (size_t index = 0; index < length; ++index) {
+    unsigned char c = chars[index];
+    
+    switch (c) {
+      case '"':
+        output_.append("\\\"");
+        break;
+      case '\\':
+        output_.append("\\\\");
+        break;
+      case '\b':
+        output_.append("\\b");
+        break;
+      case '\f':
+        output_.append("\\f");
+        break;
+      case '\n':
+        output_.append("\\n");
+        break;
+      case '\r':
+        output_.append("\\r");
+        break;
+      case '\t':
+        output_.append("\\t");
+        break;
+      default:
+        if (c < 0x20) {
+          output_.append("\\u00");
+          output_.push_back(digits[c >> 4]);
+          output_.push_back(digits[c & 0xf]);
+        }
+        else
+          output_.push_back(c);
+    }
+  }
+  
+  output_.push_back('"');
+}
+
+}}
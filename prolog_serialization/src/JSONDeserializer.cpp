@@ -21,6 +21,11 @@
 #include <json/reader.h>
 #include <json/value.h>
 
+#include <prolog_common/Compound.h>
+#include <prolog_common/List.h>
+#include <prolog_common/String.h>
+#include <prolog_common/Variable.h>
+
 #include "prolog_serialization/JSONDeserializer.h"
 
 namespace prolog { namespace serialization {
@@ -51,7 +56,21 @@ JSONDeserializer::~JSONDeserializer() {
 Bindings JSONDeserializer::deserializeBindings(std::istream& stream) const {
   Json::Value value = deserializeValue(stream);
   
-  return valueToBindings(value);
+  return valueToBindings(value, 0, 0);
+}
+
+Bindings JSONDeserializer::deserializeBindings(std::istream& stream,
+    TermArena& arena) const {
+  Json::Value value = deserializeValue(stream);
+  
+  return valueToBindings(value, &arena, 0);
+}
+
+Bindings JSONDeserializer::deserializeBindings(std::istream& stream,
+    TermFactory& factory) const {
+  Json::Value value = deserializeValue(stream);
+  
+  return valueToBindings(value, 0, &factory);
 }
 
 Clause JSONDeserializer::deserializeClause(std::istream& stream) const {
@@ -75,7 +94,21 @@ Query JSONDeserializer::deserializeQuery(std::istream& stream) const {
 Term JSONDeserializer::deserializeTerm(std::istream& stream) const {
   Json::Value value = deserializeValue(stream);
   
-  return valueToTerm(value);
+  return valueToTerm(value, 0, 0);
+}
+
+Term JSONDeserializer::deserializeTerm(std::istream& stream, TermArena&
+    arena) const {
+  Json::Value value = deserializeValue(stream);
+  
+  return valueToTerm(value, &arena, 0);
+}
+
+Term JSONDeserializer::deserializeTerm(std::istream& stream, TermFactory&
+    factory) const {
+  Json::Value value = deserializeValue(stream);
+  
+  return valueToTerm(value, 0, &factory);
 }
 
 Json::Value JSONDeserializer::deserializeValue(std::istream& stream) const {
@@ -113,14 +146,29 @@ Json::Value JSONDeserializer::deserializeValue(std::istream& stream) const {
 }
 
 Bindings JSONDeserializer::valueToBindings(const Json::Value& value) const {
+  return valueToBindings(value, 0, 0);
+}
+
+Bindings JSONDeserializer::valueToBindings(const Json::Value& value,
+    TermArena& arena) const {
+  return valueToBindings(value, &arena, 0);
+}
+
+Bindings JSONDeserializer::valueToBindings(const Json::Value& value,
+    TermFactory& factory) const {
+  return valueToBindings(value, 0, &factory);
+}
+
+Bindings JSONDeserializer::valueToBindings(const Json::Value& value,
+    TermArena* arena, TermFactory* factory) const {
   if (value.isObject()) {
-    Bindings bindings;
+    Bindings bindings = arena ? Bindings(*arena) : Bindings();
     
     Json::Value::Members names = value.getMemberNames();
     
-    for (Json::Value::Members::iterator it = names.begin();
+    for (Json::Value::Members::const_iterator it = names.begin();
         it != names.end(); ++it)
-      bindings.addTerm(*it, valueToTerm(value[*it]));
+      bindings.addTerm(*it, valueToTerm(value[*it], arena, factory));
     
     return bindings;
   }
@@ -132,10 +180,10 @@ Program JSONDeserializer::valueToProgram(const Json::Value& value) const {
   if (value.isArray()) {
     std::list<Clause> clauses;
     
-    for (Json::Value::iterator it = value.begin(); it != value.end(); ++it)
+    for (Json::Value::const_iterator it = value.begin(); it != value.end(); ++it)
       clauses.push_back(valueToClause(*it));
     
-    return Program(clauses);
+    return Program(std::move(clauses));
   }
   else
     throw ConversionError("Invalid value type.");
@@ -165,7 +213,7 @@ Query JSONDeserializer::valueToQuery(const Json::Value& value) const {
       if (value["arguments"].isArray()) {
         Json::Value argumentsValue = value["arguments"];
     
-        for (Json::Value::iterator it = argumentsValue.begin();
+        for (Json::Value::const_iterator it = argumentsValue.begin();
             it != argumentsValue.end(); ++it)
           arguments.push_back(valueToTerm(*it));    
       }
@@ -173,7 +221,8 @@ Query JSONDeserializer::valueToQuery(const Json::Value& value) const {
         throw ParseError("Member [arguments] has invalid value type.");
     }
     
-    return Query(module, value["predicate"].asString(), arguments);
+    return Query(module, value["predicate"].asString(),
+      std::move(arguments));
   }
   else
     throw ConversionError("Invalid value type.");
@@ -196,7 +245,7 @@ Clause JSONDeserializer::valueToClause(const Json::Value& value) const {
       if (value["arguments"].isArray()) {
         Json::Value argumentsValue = value["arguments"];
     
-        for (Json::Value::iterator it = argumentsValue.begin();
+        for (Json::Value::const_iterator it = argumentsValue.begin();
             it != argumentsValue.end(); ++it)
           arguments.push_back(valueToTerm(*it));    
       }
@@ -208,7 +257,7 @@ Clause JSONDeserializer::valueToClause(const Json::Value& value) const {
       if (value["goals"].isArray()) {
         Json::Value goalsValue = value["goals"];
     
-        for (Json::Value::iterator it = goalsValue.begin();
+        for (Json::Value::const_iterator it = goalsValue.begin();
             it != goalsValue.end(); ++it)
           goals.push_back(valueToTerm(*it));    
       }
@@ -216,15 +265,36 @@ Clause JSONDeserializer::valueToClause(const Json::Value& value) const {
         throw ParseError("Member [goals] has invalid value type.");
     }
     
-    return Clause(value["predicate"].asString(), arguments, goals);
+    return Clause(value["predicate"].asString(), std::move(arguments),
+      std::move(goals));
   }
   else
     throw ConversionError("Invalid value type.");
 }
 
 Term JSONDeserializer::valueToTerm(const Json::Value& value) const {
+  return valueToTerm(value, 0, 0);
+}
+
+Term JSONDeserializer::valueToTerm(const Json::Value& value, TermArena&
+    arena) const {
+  return valueToTerm(value, &arena, 0);
+}
+
+Term JSONDeserializer::valueToTerm(const Json::Value& value, TermFactory&
+    factory) const {
+  return valueToTerm(value, 0, &factory);
+}
+
+Term JSONDeserializer::valueToTerm(const Json::Value& value, TermArena*
+    arena, TermFactory* factory) const {
   if (value.isObject()) {
-    std::vector<Term> arguments;
+    if ((value.size() == 1) && value.isMember("string")) {
+      if (!value["string"].isString())
+        throw ParseError("Member [string] has invalid value type.");
+      
+      return String(value["string"].asString());
+    }
     
     if (value.size() != 2)
       throw ParseError("Invalid number of object members.");
@@ -239,24 +309,60 @@ Term JSONDeserializer::valueToTerm(const Json::Value& value) const {
     if (!value["arguments"].isArray())
       throw ParseError("Member [arguments] has invalid value type.");
     
-    Json::Value argumentsValue = value["arguments"];
+    const Json::Value& argumentsValue = value["arguments"];
+    
+    if ((value["functor"].asString() == "[|]") &&
+        (argumentsValue.size() == 2)) {
+      Term head = valueToTerm(argumentsValue[0], arena, factory);
+      Term tail = valueToTerm(argumentsValue[1], arena, factory);
+      
+      if (tail.isList() || tail.isVariable()) {
+        if (arena)
+          return arena->createList(std::vector<Term>(1, head), tail);
+        
+        return List(head, tail);
+      }
+    }
+    
+    std::vector<Term> arguments;
     
-    for (Json::Value::iterator it = argumentsValue.begin();
+    arguments.reserve(argumentsValue.size());
+    for (Json::Value::const_iterator it = argumentsValue.begin();
         it != argumentsValue.end(); ++it)
-      arguments.push_back(valueToTerm(*it));
+      arguments.push_back(valueToTerm(*it, arena, factory));
     
-    return Term(value["functor"].asString(), arguments);
+    if (arena)
+      return arena->createCompound(value["functor"].asString(), arguments);
+    else if (factory)
+      return factory->createCompound(value["functor"].asString(),
+        std::move(arguments));
+    else
+      return Term(value["functor"].asString(), std::move(arguments));
   }
   else if (value.isArray()) {
-    std::list<Term> elements;
+    std::vector<Term> elements;
     
-    for (Json::Value::iterator it = value.begin(); it != value.end(); ++it)
-      elements.push_back(valueToTerm(*it));
+    elements.reserve(value.size());
+    for (Json::Value::const_iterator it = value.begin(); it != value.end();
+        ++it)
+      elements.push_back(valueToTerm(*it, arena, factory));
+    
+    if (arena)
+      return arena->createList(elements);
+    else if (factory)
+      return factory->createList(std::move(elements));
+    else
+      return List(std::move(elements));
+  }
+  else if (value.isString()) {
+    std::string name = value.asString();
     
-    return Term(elements);
+    if (arena && !name.empty() && ((name[0] == toupper(name[0])) ||
+        (name[0] == '_')))
+      return arena->createVariable(name);
+    else
+      return Term(name);
   }
-  else if (value.isString())
-    return Term(value.asString());
   else if (value.isDouble())
     return Term(value.asDouble());
   else if (value.isIntegral())
@@ -27,6 +27,8 @@
 #include <prolog_common/List.h>
 #include <prolog_common/Number.h>
 #include <prolog_common/Rule.h>
+#include <prolog_common/String.h>
+#include <prolog_common/TermWalker.h>
 #include <prolog_common/Variable.h>
 
 #include "prolog_serialization/JSONSerializer.h"
@@ -51,6 +53,12 @@ JSONSerializer::JSONSerializer(const JSONSerializer& src) :
 JSONSerializer::~JSONSerializer() {  
 }
 
+JSONSerializer::ValueBuilder::ValueBuilder(const JSONSerializer& serializer,
+    Json::Value& value) :
+  serializer_(serializer),
+  value_(value) {
+}
+
 /*****************************************************************************/
 /* Accessors                                                                 */
 /*****************************************************************************/
@@ -121,7 +129,7 @@ Json::Value JSONSerializer::bindingsToValue(const Bindings& bindings) const {
   
   for (Bindings::ConstIterator it = bindings.begin();
        it != bindings.end(); ++it)
-    value[it->first] = termToValue(it->second);
+    value[it->first.getName()] = termToValue(it->second);
   
   return value;
 }
@@ -134,26 +142,12 @@ Json::Value JSONSerializer::clauseToValue(const Clause& clause) const {
 }
 
 Json::Value JSONSerializer::compoundToValue(const Compound& compound) const {
-  std::string functor = compound.getFunctor();
-  std::vector<Term> arguments = compound.getArguments();
-  
-  Json::Value argumentsValue(Json::arrayValue);
-  
-  for (std::vector<Term>::const_iterator it = arguments.begin();
-       it != arguments.end(); ++it)
-    argumentsValue.append(termToValue(*it));
-       
-  Json::Value value(Json::objectValue);
-  
-  value["functor"] = functor;
-  value["arguments"] = argumentsValue;  
-  
-  return value;
+  return termToValue(compound);
 }
 
 Json::Value JSONSerializer::factToValue(const Fact& fact) const {
-  std::string predicate = fact.getPredicate();
-  std::vector<Term> arguments = fact.getArguments();
+  const std::string& predicate = fact.getPredicate();
+  const std::vector<Term>& arguments = fact.getArguments();
   
   Json::Value value(Json::objectValue);
   
@@ -188,13 +182,7 @@ Json::Value JSONSerializer::numberToValue(const Number& number) const {
 }
 
 Json::Value JSONSerializer::listToValue(const List& list) const {
-  Json::Value value(Json::arrayValue);
-  
-  for (std::list<Term>::const_iterator it = list.begin();
-       it != list.end(); ++it)
-    value.append(termToValue(*it));
-       
-  return value;
+  return termToValue(list);
 }
 
 Json::Value JSONSerializer::programToValue(const Program& program) const {
@@ -208,9 +196,9 @@ Json::Value JSONSerializer::programToValue(const Program& program) const {
 }
 
 Json::Value JSONSerializer::queryToValue(const Query& query) const {
-  std::string module = query.getModule();
-  std::string predicate = query.getPredicate();
-  std::vector<Term> arguments = query.getArguments();
+  const std::string& module = query.getModule();
+  const std::string& predicate = query.getPredicate();
+  const std::vector<Term>& arguments = query.getArguments();
   
   Json::Value value(Json::objectValue);
   
@@ -233,9 +221,9 @@ Json::Value JSONSerializer::queryToValue(const Query& query) const {
 }
 
 Json::Value JSONSerializer::ruleToValue(const Rule& rule) const {
-  std::string predicate = rule.getPredicate();
-  std::vector<Term> arguments = rule.getArguments();
-  std::list<Term> goals = rule.getGoals();
+  const std::string& predicate = rule.getPredicate();
+  const std::vector<Term>& arguments = rule.getArguments();
+  const std::list<Term>& goals = rule.getGoals();
   
   Json::Value value(Json::objectValue);
   
@@ -262,21 +250,98 @@ Json::Value JSONSerializer::ruleToValue(const Rule& rule) const {
   return value;
 }
 
+Json::Value JSONSerializer::stringToValue(const String& string) const {
+  Json::Value value(Json::objectValue);
+  
+  value["string"] = string.getValue();
+  
+  return value;
+}
+
 Json::Value JSONSerializer::termToValue(const Term& term) const {
-  if (term.isAtom())
-    return atomToValue(term);
-  else if (term.isCompound())
-    return compoundToValue(term);
-  else if (term.isList())
-    return listToValue(term);
-  else if (term.isNumber())
-    return numberToValue(term);
-  else if (term.isVariable())
-    return variableToValue(term);
+  Json::Value value;
+  ValueBuilder builder(*this, value);
+  TermWalker walker;
+  
+  walker.walk(term, builder);
+  
+  return value;
 }
 
 Json::Value JSONSerializer::variableToValue(const Variable& variable) const {
   return Json::Value(variable.getName());
 }
 
+void JSONSerializer::ValueBuilder::visitAtom(const Atom& atom) {
+  append(serializer_.atomToValue(atom));
+}
+
+void JSONSerializer::ValueBuilder::visitCompound(const Compound& compound) {
+  Json::Value value(Json::objectValue);
+  
+  value["functor"] = compound.getFunctor();
+  value["arguments"] = Json::Value(Json::arrayValue);
+  
+  values_.push_back(&append(value));
+}
+
+void JSONSerializer::ValueBuilder::visitFloat(const Float& number) {
+  append(serializer_.floatToValue(number));
+}
+
+void JSONSerializer::ValueBuilder::visitInteger(const Integer& number) {
+  append(serializer_.integerToValue(number));
+}
+
+void JSONSerializer::ValueBuilder::visitList(const List& list) {
+  values_.push_back(&append(Json::Value(Json::arrayValue)));
+}
+
+void JSONSerializer::ValueBuilder::visitString(const String& string) {
+  append(serializer_.stringToValue(string));
+}
+
+void JSONSerializer::ValueBuilder::visitVariable(const Variable& variable) {
+  append(serializer_.variableToValue(variable));
+}
+
+void JSONSerializer::ValueBuilder::leaveCompound(const Compound& compound) {
+  values_.pop_back();
+}
+
+void JSONSerializer::ValueBuilder::leaveList(const List& list) {
+  Json::Value& value = *values_.back();
+  values_.pop_back();
+  
+  if (list.isPartial()) {
+    Json::Value tailValue = value[value.size()-1];
+    
+    for (int index = static_cast<int>(value.size())-2; index >= 0;
+        --index) {
+      Json::Value argumentsValue(Json::arrayValue);
+      
+      argumentsValue.append(value[index]);
+      argumentsValue.append(tailValue);
+      
+      tailValue = Json::Value(Json::objectValue);
+      tailValue["functor"] = "[|]";
+      tailValue["arguments"] = argumentsValue;
+    }
+    
+    value = tailValue;
+  }
+}
+
+Json::Value& JSONSerializer::ValueBuilder::append(const Json::Value& value) {
+  if (values_.empty()) {
+    value_ = value;
+    
+    return value_;
+  }
+  else if (values_.back()->isObject())
+    return (*values_.back())["arguments"].append(value);
+  else
+    return values_.back()->append(value);
+}
+
 }}
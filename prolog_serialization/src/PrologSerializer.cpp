@@ -24,6 +24,8 @@
 #include <prolog_common/List.h>
 #include <prolog_common/Number.h>
 #include <prolog_common/Rule.h>
+#include <prolog_common/String.h>
+#include <prolog_common/TermWalker.h>
 #include <prolog_common/Variable.h>
 
 #include "prolog_serialization/PrologSerializer.h"
@@ -40,6 +42,12 @@ PrologSerializer::PrologSerializer() {
 PrologSerializer::~PrologSerializer() {  
 }
 
+PrologSerializer::TermWriter::TermWriter(const PrologSerializer& serializer,
+    std::ostream& stream) :
+  serializer_(serializer),
+  stream_(stream) {
+}
+
 /*****************************************************************************/
 /* Methods                                                                   */
 /*****************************************************************************/
@@ -77,8 +85,8 @@ void PrologSerializer::serializeProgram(std::ostream& stream, const Program&
 
 void PrologSerializer::serializeQuery(std::ostream& stream, const Query&
     query) const {
-  std::string module = query.getModule();
-  std::string predicate = query.getPredicate();
+  const std::string& module = query.getModule();
+  const std::string& predicate = query.getPredicate();
 
   if (!module.empty())
     stream << module << ":";
@@ -102,21 +110,15 @@ void PrologSerializer::serializeQuery(std::ostream& stream, const Query&
     
 void PrologSerializer::serializeTerm(std::ostream& stream, const Term& term)
     const {
-  if (term.isAtom())
-    serializeAtom(stream, term);
-  else if (term.isCompound())
-    serializeCompound(stream, term);
-  else if (term.isList())
-    serializeList(stream, term);
-  else if (term.isNumber())
-    serializeNumber(stream, term);
-  else if (term.isVariable())
-    serializeVariable(stream, term);
+  TermWriter writer(*this, stream);
+  TermWalker walker;
+  
+  walker.walk(term, writer);
 }
 
 void PrologSerializer::serializeAtom(std::ostream& stream, const Atom& atom)
     const {
-  std::string name = atom.getName();
+  const std::string& name = atom.getName();
   bool quoted = (name.empty() || (name[0] == '_'));
   
   if (!quoted) {
@@ -137,28 +139,13 @@ void PrologSerializer::serializeAtom(std::ostream& stream, const Atom& atom)
 
 void PrologSerializer::serializeCompound(std::ostream& stream, const Compound&
     compound) const {
-  std::string functor = compound.getFunctor();
-
-  stream << functor;
-  if (compound.getArity()) {
-    stream << "(";
-    
-    for (std::vector<Term>::const_iterator it = compound.begin();
-        it != compound.end(); ++it) {
-      if (it != compound.begin())
-        stream << ", ";
-      
-      serializeTerm(stream, *it);
-    }
-      
-    stream << ")";
-  }
+  serializeTerm(stream, compound);
 }
 
 void PrologSerializer::serializeFact(std::ostream& stream, const Fact& fact)
     const {
-  std::string predicate = fact.getPredicate();
-  std::vector<Term> arguments = fact.getArguments();
+  const std::string& predicate = fact.getPredicate();
+  const std::vector<Term>& arguments = fact.getArguments();
 
   stream << predicate;
   if (!arguments.empty()) {
@@ -198,26 +185,14 @@ void PrologSerializer::serializeNumber(std::ostream& stream, const Number&
 
 void PrologSerializer::serializeList(std::ostream& stream, const List& list)
     const {
-  std::list<Term> elements = list.getElements();
-
-  stream << "[";
-  
-  for (std::list<Term>::const_iterator it = elements.begin();
-      it != elements.end(); ++it) {
-    if (it != elements.begin())
-      stream << ", ";
-    
-    serializeTerm(stream, *it);
-  }
-  
-  stream << "]";
+  serializeTerm(stream, list);
 }
 
 void PrologSerializer::serializeRule(std::ostream& stream, const Rule& rule)
     const {
-  std::string predicate = rule.getPredicate();
-  std::vector<Term> arguments = rule.getArguments();
-  std::list<Term> goals = rule.getGoals();
+  const std::string& predicate = rule.getPredicate();
+  const std::vector<Term>& arguments = rule.getArguments();
+  const std::list<Term>& goals = rule.getGoals();
 
   stream << predicate;
   if (!arguments.empty()) {
@@ -247,9 +222,94 @@ void PrologSerializer::serializeRule(std::ostream& stream, const Rule& rule)
   stream << ".";
 }
 
+void PrologSerializer::serializeString(std::ostream& stream, const String&
+    string) const {
+  const std::string& value = string.getValue();
+  
+  stream << "\"";
+  
+  for (size_t index = 0; index < value.length(); ++index) {
+    if ((value[index] == '"') || (value[index] == '\\'))
+      stream << "\\";
+    
+    stream << value[index];
+  }
+  
+  stream << "\"";
+}
+
 void PrologSerializer::serializeVariable(std::ostream& stream, const Variable&
     variable) const {
   stream << variable.getName();
 }
 
+void PrologSerializer::TermWriter::visitAtom(const Atom& atom) {
+  separate();
+  serializer_.serializeAtom(stream_, atom);
+}
+
+void PrologSerializer::TermWriter::visitCompound(const Compound& compound) {
+  separate();
+  
+  stream_ << compound.getFunctor();
+  if (compound.getArity())
+    stream_ << "(";
+  
+  Scope scope = {0, 0, false};
+  scopes_.push_back(scope);
+}
+
+void PrologSerializer::TermWriter::visitFloat(const Float& number) {
+  separate();
+  serializer_.serializeFloat(stream_, number);
+}
+
+void PrologSerializer::TermWriter::visitInteger(const Integer& number) {
+  separate();
+  serializer_.serializeInteger(stream_, number);
+}
+
+void PrologSerializer::TermWriter::visitList(const List& list) {
+  separate();
+  stream_ << "[";
+  
+  Scope scope = {0, list.getNumElements(), true};
+  scopes_.push_back(scope);
+}
+
+void PrologSerializer::TermWriter::visitString(const String& string) {
+  separate();
+  serializer_.serializeString(stream_, string);
+}
+
+void PrologSerializer::TermWriter::visitVariable(const Variable& variable) {
+  separate();
+  serializer_.serializeVariable(stream_, variable);
+}
+
+void PrologSerializer::TermWriter::leaveCompound(const Compound& compound) {
+  scopes_.pop_back();
+  
+  if (compound.getArity())
+    stream_ << ")";
+}
+
+void PrologSerializer::TermWriter::leaveList(const List& list) {
+  scopes_.pop_back();
+  stream_ << "]";
+}
+
+void PrologSerializer::TermWriter::separate() {
+  if (!scopes_.empty()) {
+    Scope& scope = scopes_.back();
+    
+    if (scope.list_ && (scope.numTerms_ == scope.numElements_))
+      stream_ << "|";
+    else if (scope.numTerms_)
+      stream_ << ", ";
+    
+    ++scope.numTerms_;
+  }
+}
+
 }}
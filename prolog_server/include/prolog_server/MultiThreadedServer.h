@@ -23,20 +23,26 @@
 #ifndef ROS_PROLOG_SERVER_MULTI_THREADED_SERVER_H
 #define ROS_PROLOG_SERVER_MULTI_THREADED_SERVER_H
 
-#include <list>
-
-#include <roscpp_nodewrap/worker/Worker.h>
-
-#include <prolog_swi/Engine.h>
+#include <prolog_swi/PreparedQuery.h>
 
+#include <prolog_server/Registry.h>
 #include <prolog_server/Server.h>
 #include <prolog_server/ThreadedQuery.h>
+#include <prolog_server/WorkerPool.h>
 
 #include <roscpp_nodewrap/Nodelet.h>
 
 namespace prolog {
   namespace server {
     /** \brief Multi-threaded Prolog server implementation
+      * 
+      * The service callbacks of the multi-threaded Prolog server may
+      * be invoked concurrently, e.g., from a multi-threaded spinner.
+      * Queries are registered in sharded registries, and callbacks do
+      * not hold any registry lock while waiting for solutions. Callbacks
+      * never wait for a query which is pending admission to the worker
+      * pool, but respond with a pending status on which the client
+      * retries, such that pending queries do not occupy spinner threads.
       */  
     class MultiThreadedServer :
       public Server {
@@ -83,24 +89,53 @@ namespace prolog {
       bool closeQueryCallback(prolog_msgs::CloseQuery::Request& request,
         prolog_msgs::CloseQuery::Response& response);
     
+      /** \brief Prepare query service callback (implementation)
+        */
+      bool prepareQueryCallback(prolog_msgs::PrepareQuery::Request&
+        request, prolog_msgs::PrepareQuery::Response& response);
+      
+      /** \brief Execute prepared query service callback (implementation)
+        */
+      bool executePreparedCallback(prolog_msgs::ExecutePrepared::Request&
+        request, prolog_msgs::ExecutePrepared::Response& response);
+      
+      /** \brief Start a threaded Prolog query on an idle engine of this
+        *   multi-threaded Prolog server, or admit it to the worker pool's
+        *   admission queue if all engines are assigned
+        */
+      bool startQuery(const std::string& identifier, const ThreadedQuery&
+        query, size_t& queuePosition, double& expectedWait, std::string&
+        error);
+      
     private:      
       /** \brief The Prolog service server of this multi-threaded Prolog
         *   server
         */
       ServiceServer serviceServer_;
       
-      /** \brief The Prolog engines of this multi-threaded Prolog server
+      /** \brief The Prolog engine worker pool of this multi-threaded
+        *   Prolog server
         */
-      std::list<swi::Engine> engines_;
+      WorkerPool workerPool_;
       
-      /** \brief The Prolog queries of this multi-threaded Prolog server
+      /** \brief True, if the local stack usage of the Prolog queries of
+        *   this multi-threaded Prolog server is monitored
         */
-      boost::unordered_map<std::string, ThreadedQuery> queries_;
+      bool monitorLocalStack_;
       
-      /** \brief The workers of this multi-threaded Prolog server
+      /** \brief The number of solutions buffered by each Prolog query
+        *   of this multi-threaded Prolog server
         */
-      boost::unordered_map<std::string, nodewrap::Worker> workers_;
+      size_t solutionBufferSize_;
       
+      /** \brief The Prolog queries of this multi-threaded Prolog server
+        */
+      Registry<ThreadedQuery> queries_;
+      
+      /** \brief The prepared Prolog queries of this multi-threaded Prolog
+        *   server
+        */
+      Registry<swi::PreparedQuery> preparedQueries_;
     };
   };
 };
@@ -0,0 +1,114 @@
+/******************************************************************************
+ * Copyright (C) 2016 by Ralf Kaestner                                        *
+ * ralf.kaestner@gmail.com                                                    *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the               *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+/** \file Registry.h
+  * \brief Header file providing the Registry class interface
+  */
+
+#ifndef ROS_PROLOG_SERVER_REGISTRY_H
+#define ROS_PROLOG_SERVER_REGISTRY_H
+
+#include <string>
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/unordered_map.hpp>
+
+namespace prolog {
+  namespace server {
+    /** \brief Concurrent registry of Prolog server queries
+      * 
+      * The registry maps query identifiers to values of type T, which are
+      * expected to be cheaply copyable handles such as threaded or prepared
+      * queries. Its entries are distributed over a number of shards by the
+      * hash of their identifier, each shard being guarded by its own mutex.
+      * Lookups copy the value out of its shard, such that service callbacks
+      * operating on different queries neither block each other nor hold any
+      * registry lock while waiting for solutions.
+      */  
+    template <typename T> class Registry {
+    public:
+      /** \brief Default constructor
+        */
+      Registry(size_t numShards = 16);
+      
+      /** \brief Copy constructor
+        * 
+        * The copy shares the shards of the source registry.
+        */
+      Registry(const Registry<T>& src);
+      
+      /** \brief Destructor
+        */
+      ~Registry();
+      
+      /** \brief Retrieve the number of shards of this registry
+        */
+      size_t getNumShards() const;
+      
+      /** \brief Retrieve the number of entries of this registry
+        */
+      size_t getNumEntries() const;
+      
+      /** \brief Insert an entry into this registry
+        * 
+        * The entry is not inserted if its identifier is already registered.
+        */
+      bool insert(const std::string& identifier, const T& value);
+      
+      /** \brief Find an entry in this registry
+        */
+      bool find(const std::string& identifier, T& value) const;
+      
+      /** \brief Remove an entry from this registry
+        */
+      bool erase(const std::string& identifier);
+      
+      /** \brief Remove an entry from this registry (overloaded version
+        *   returning the removed value)
+        */
+      bool erase(const std::string& identifier, T& value);
+      
+      /** \brief Remove all entries from this registry
+        */
+      void clear();
+      
+    private:
+      /** \brief Registry shard
+        */
+      class Shard {
+      public:
+        boost::unordered_map<std::string, T> entries_;
+        mutable boost::mutex mutex_;
+      };
+      
+      /** \brief Retrieve the shard of an identifier
+        */
+      Shard& getShard(const std::string& identifier) const;
+      
+      /** \brief The shards of this registry
+        */
+      std::vector<boost::shared_ptr<Shard> > shards_;
+    };
+  };
+};
+
+#include <prolog_server/Registry.tpp>
+
+#endif
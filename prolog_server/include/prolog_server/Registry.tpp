@@ -0,0 +1,133 @@
+/******************************************************************************
+ * Copyright (C) 2016 by Ralf Kaestner                                        *
+ * ralf.kaestner@gmail.com                                                    *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the               *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+#include <boost/functional/hash.hpp>
+
+namespace prolog { namespace server {
+
+/*****************************************************************************/
+/* Constructors and Destructor                                               */
+/*****************************************************************************/
+
+template <typename T> Registry<T>::Registry(size_t numShards) {
+  if (!numShards)
+    numShards = 1;
+  
+  shards_.reserve(numShards);
+  
+  for (size_t index = 0; index < numShards; ++index)
+    shards_.push_back(boost::shared_ptr<Shard>(new Shard()));
+}
+
+template <typename T> Registry<T>::Registry(const Registry<T>& src) :
+  shards_(src.shards_) {
+}
+
+template <typename T> Registry<T>::~Registry() {
+}
+
+/*****************************************************************************/
+/* Accessors                                                                 */
+/*****************************************************************************/
+
+template <typename T> size_t Registry<T>::getNumShards() const {
+  return shards_.size();
+}
+
+template <typename T> size_t Registry<T>::getNumEntries() const {
+  size_t numEntries = 0;
+  
+  for (size_t index = 0; index < shards_.size(); ++index) {
+    boost::mutex::scoped_lock lock(shards_[index]->mutex_);
+    numEntries += shards_[index]->entries_.size();
+  }
+  
+  return numEntries;
+}
+
+template <typename T> typename Registry<T>::Shard& Registry<T>::getShard(
+    const std::string& identifier) const {
+  return *shards_[boost::hash<std::string>()(identifier)%shards_.size()];
+}
+
+/*****************************************************************************/
+/* Methods                                                                   */
+/*****************************************************************************/
+
+template <typename T> bool Registry<T>::insert(const std::string&
+    identifier, const T& value) {
+  Shard& shard = getShard(identifier);
+  boost::mutex::scoped_lock lock(shard.mutex_);
+  
+  return shard.entries_.insert(std::make_pair(identifier, value)).second;
+}
+
+template <typename T> bool Registry<T>::find(const std::string& identifier,
+    T& value) const {
+  Shard& shard = getShard(identifier);
+  boost::mutex::scoped_lock lock(shard.mutex_);
+  
+  typename boost::unordered_map<std::string, T>::const_iterator it =
+    shard.entries_.find(identifier);
+  
+  if (it != shard.entries_.end()) {
+    value = it->second;
+    return true;
+  }
+  else
+    return false;
+}
+
+template <typename T> bool Registry<T>::erase(const std::string&
+    identifier) {
+  Shard& shard = getShard(identifier);
+  boost::mutex::scoped_lock lock(shard.mutex_);
+  
+  return shard.entries_.erase(identifier);
+}
+
+template <typename T> bool Registry<T>::erase(const std::string&
+    identifier, T& value) {
+  Shard& shard = getShard(identifier);
+  boost::mutex::scoped_lock lock(shard.mutex_);
+  
+  typename boost::unordered_map<std::string, T>::iterator it =
+    shard.entries_.find(identifier);
+  
+  if (it != shard.entries_.end()) {
+    value = it->second;
+    shard.entries_.erase(it);
+    
+    return true;
+  }
+  else
+    return false;
+}
+
+template <typename T> void Registry<T>::clear() {
+  for (size_t index = 0; index < shards_.size(); ++index) {
+    boost::unordered_map<std::string, T> entries;
+    
+    {
+      boost::mutex::scoped_lock lock(shards_[index]->mutex_);
+      entries.swap(shards_[index]->entries_);
+    }
+  }
+}
+
+}}
@@ -0,0 +1,122 @@
+/******************************************************************************
+ * Copyright (C) 2016 by Ralf Kaestner                                        *
+ * ralf.kaestner@gmail.com                                                    *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the               *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+/** \file RingBuffer.h
+  * \brief Header file providing the RingBuffer class interface
+  */
+
+#ifndef ROS_PROLOG_SERVER_RING_BUFFER_H
+#define ROS_PROLOG_SERVER_RING_BUFFER_H
+
+#include <atomic>
+#include <vector>
+
+namespace prolog {
+  namespace server {
+    /** \brief Bounded single-producer/single-consumer ring buffer
+      * 
+      * The ring buffer passes values of type T from exactly one producer
+      * thread to exactly one consumer thread at a time. Both push() and
+      * pop() are wait-free and fail instead of blocking if the buffer is
+      * full or empty, respectively. The producer and consumer roles may
+      * migrate between threads, provided that the migration itself is
+      * synchronized.
+      * 
+      * The capacity of the buffer is rounded up to the next power of two.
+      */  
+    template <typename T> class RingBuffer {
+    public:
+      /** \brief Default constructor
+        */
+      RingBuffer(size_t capacity = 64);
+      
+      /** \brief Destructor
+        */
+      ~RingBuffer();
+      
+      /** \brief Retrieve the capacity of this ring buffer
+        */
+      size_t getCapacity() const;
+      
+      /** \brief Retrieve the number of values in this ring buffer
+        * 
+        * The size is exact only if called by the producer or consumer
+        * while the other party is inactive.
+        */
+      size_t getSize() const;
+      
+      /** \brief True, if this ring buffer is empty
+        */
+      bool isEmpty() const;
+      
+      /** \brief True, if this ring buffer is full
+        */
+      bool isFull() const;
+      
+      /** \brief Push a value to this ring buffer (producer only)
+        */
+      bool push(const T& value);
+      
+      /** \brief Pop a value from this ring buffer (consumer only)
+        * 
+        * The slot of the popped value is reset to a default-constructed
+        * value, such that the buffer does not retain its resources.
+        */
+      bool pop(T& value);
+      
+    private:
+      /** \brief Copying ring buffers is prohibited
+        */
+      RingBuffer(const RingBuffer<T>& src);
+      
+      /** \brief The size of a cache line in bytes
+        */
+      static const size_t cacheLineSize = 64;
+      
+      /** \brief The values of this ring buffer
+        */
+      std::vector<T> values_;
+      
+      /** \brief The index mask of this ring buffer
+        */
+      size_t mask_;
+      
+      /** \brief The index of the next value to be popped, written by
+        *   the consumer
+        */
+      alignas(cacheLineSize) std::atomic<size_t> head_;
+      
+      /** \brief The consumer's cached copy of the tail index
+        */
+      size_t cachedTail_;
+      
+      /** \brief The index of the next value to be pushed, written by
+        *   the producer
+        */
+      alignas(cacheLineSize) std::atomic<size_t> tail_;
+      
+      /** \brief The producer's cached copy of the head index
+        */
+      size_t cachedHead_;
+    };
+  };
+};
+
+#include <prolog_server/RingBuffer.tpp>
+
+#endif
@@ -0,0 +1,104 @@
+/******************************************************************************
+ * Copyright (C) 2016 by Ralf Kaestner                                        *
+ * ralf.kaestner@gmail.com                                                    *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the               *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+namespace prolog { namespace server {
+
+/*****************************************************************************/
+/* Constructors and Destructor                                               */
+/*****************************************************************************/
+
+template <typename T> RingBuffer<T>::RingBuffer(size_t capacity) :
+  head_(0),
+  cachedTail_(0),
+  tail_(0),
+  cachedHead_(0) {
+  size_t size = 1;
+  
+  while (size < capacity)
+    size <<= 1;
+  
+  values_.resize(size);
+  mask_ = size-1;
+}
+
+template <typename T> RingBuffer<T>::~RingBuffer() {
+}
+
+/*****************************************************************************/
+/* Accessors                                                                 */
+/*****************************************************************************/
+
+template <typename T> size_t RingBuffer<T>::getCapacity() const {
+  return values_.size();
+}
+
+template <typename T> size_t RingBuffer<T>::getSize() const {
+  size_t head = head_.load(std::memory_order_acquire);
+  size_t tail = tail_.load(std::memory_order_acquire);
+  
+  return tail-head;
+}
+
+template <typename T> bool RingBuffer<T>::isEmpty() const {
+  return head_.load(std::memory_order_acquire) ==
+    tail_.load(std::memory_order_acquire);
+}
+
+template <typename T> bool RingBuffer<T>::isFull() const {
+  return tail_.load(std::memory_order_acquire)-
+    head_.load(std::memory_order_acquire) >= values_.size();
+}
+
+/*****************************************************************************/
+/* Methods                                                                   */
+/*****************************************************************************/
+
+template <typename T> bool RingBuffer<T>::push(const T& value) {
+  size_t tail = tail_.load(std::memory_order_relaxed);
+  
+  if (tail-cachedHead_ >= values_.size()) {
+    cachedHead_ = head_.load(std::memory_order_acquire);
+    
+    if (tail-cachedHead_ >= values_.size())
+      return false;
+  }
+  
+  values_[tail & mask_] = value;
+  tail_.store(tail+1, std::memory_order_release);
+  
+  return true;
+}
+
+template <typename T> bool RingBuffer<T>::pop(T& value) {
+  size_t head = head_.load(std::memory_order_relaxed);
+  
+  if (head == cachedTail_) {
+    cachedTail_ = tail_.load(std::memory_order_acquire);
+    
+    if (head == cachedTail_)
+      return false;
+  }
+  
+  value = values_[head & mask_];
+  values_[head & mask_] = T();
+  head_.store(head+1, std::memory_order_release);
+  
+  return true;
+}
+
+}}
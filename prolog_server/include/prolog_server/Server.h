@@ -23,6 +23,7 @@
 #ifndef ROS_PROLOG_SERVER_H
 #define ROS_PROLOG_SERVER_H
 
+#include <boost/thread/mutex.hpp>
 #include <boost/unordered_map.hpp>
 #include <boost/uuid/uuid_generators.hpp>
 
@@ -31,10 +32,12 @@
 #include <roscpp_nodewrap/worker/Worker.h>
 
 #include <prolog_msgs/CloseQuery.h>
+#include <prolog_msgs/ExecutePrepared.h>
 #include <prolog_msgs/GetAllSolutions.h>
 #include <prolog_msgs/GetNextSolution.h>
 #include <prolog_msgs/HasSolution.h>
 #include <prolog_msgs/OpenQuery.h>
+#include <prolog_msgs/PrepareQuery.h>
 
 #include <prolog_swi/Context.h>
 
@@ -72,6 +75,9 @@ namespace prolog {
         defaultTrailStack = 256);
       
       /** \brief Generate a Prolog query identifier
+        * 
+        * Query identifiers may be generated concurrently from service
+        * callbacks executing in different threads.
         */ 
       std::string prologQueryIdentifier();
       
@@ -118,6 +124,18 @@ namespace prolog {
       virtual bool closeQueryCallback(prolog_msgs::CloseQuery::Request&
         request, prolog_msgs::CloseQuery::Response& response) = 0;
       
+      /** \brief Prepare query service callback (abstract declaration)
+        */
+      virtual bool prepareQueryCallback(prolog_msgs::PrepareQuery::Request&
+        request, prolog_msgs::PrepareQuery::Response& response) = 0;
+      
+      /** \brief Execute prepared query service callback (abstract
+        *   declaration)
+        */
+      virtual bool executePreparedCallback(prolog_msgs::ExecutePrepared::
+        Request& request, prolog_msgs::ExecutePrepared::Response&
+        response) = 0;
+      
     private:        
       /** \brief The Prolog context of this Prolog server
         */
@@ -126,6 +144,11 @@ namespace prolog {
       /** \brief The query identifier generator of this Prolog server
         */
       boost::uuids::random_generator queryIdentifierGenerator_;
+      
+      /** \brief The query identifier generator mutex of this Prolog
+        *   server
+        */
+      boost::mutex queryIdentifierMutex_;
     };
   };
 };
@@ -72,6 +72,8 @@ namespace prolog {
         nodewrap::ServiceServer getNextSolutionServer_;
         nodewrap::ServiceServer hasSolutionServer_;
         nodewrap::ServiceServer closeQueryServer_;
+        nodewrap::ServiceServer prepareQueryServer_;
+        nodewrap::ServiceServer executePreparedServer_;
       };
       
       /** \brief The Prolog service server's implementation
@@ -23,23 +23,37 @@
 #ifndef ROS_PROLOG_SERVER_THREADED_QUERY_H
 #define ROS_PROLOG_SERVER_THREADED_QUERY_H
 
-#include <list>
+#include <atomic>
 #include <string>
 
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/function.hpp>
 #include <boost/thread/condition.hpp>
 #include <boost/thread/mutex.hpp>
 #include <boost/shared_ptr.hpp>
 
-#include <roscpp_nodewrap/worker/WorkerEvent.h>
-
 #include <prolog_common/Bindings.h>
+#include <prolog_common/BindingsSnapshot.h>
+#include <prolog_common/BindingsWriter.h>
 
 #include <prolog_swi/Engine.h>
+#include <prolog_swi/Frame.h>
 #include <prolog_swi/Query.h>
 
+#include <prolog_server/RingBuffer.h>
+
 namespace prolog {
   namespace server {
     /** \brief Threaded Prolog query
+      * 
+      * The solutions of a threaded Prolog query are passed from the
+      * worker thread executing the query to the consuming thread through
+      * a bounded single-producer/single-consumer ring buffer. The worker
+      * thread pushes solutions without taking a lock while buffer space
+      * is left, and is suspended from the query on a full buffer. Each
+      * consumer takes a per-query consumer lock for every solution, which
+      * serializes concurrent consumers of the same query, but parks on
+      * the query's condition only while the buffer is empty.
       */  
     class ThreadedQuery {
     public:
@@ -68,12 +82,39 @@ namespace prolog {
         */
       std::string getError() const;
       
+      /** \brief Retrieve the high-water mark of the local stack usage
+        *   in bytes sampled by this threaded Prolog query
+        * 
+        * The local stack usage is only sampled if the underlying
+        * SWI-Prolog query has local stack monitoring enabled.
+        */
+      size_t getLocalStackHighWaterMark() const;
+      
+      /** \brief True, if this threaded Prolog query is pending admission
+        *   to a Prolog engine worker pool
+        */
+      bool isPending() const;
+      
       /** \brief Retrieve the next solution generated by this threaded
         *   Prolog query
+        * 
+        * Solutions are captured as Prolog bindings snapshots by the
+        * query's engine and decoded by the calling thread, such that
+        * the engine does not have to wait for term conversion.
         */
       bool getNextSolution(Bindings& bindings, std::string& error, bool
         block = false) const;
       
+      /** \brief Retrieve the next solution generated by this threaded
+        *   Prolog query (overloaded version writing the solution to a
+        *   Prolog bindings writer)
+        * 
+        * The captured snapshot is replayed into the writer by the
+        * calling thread, without decoding it into Prolog bindings.
+        */
+      bool getNextSolution(BindingsWriter& writer, std::string& error,
+        bool block = false) const;
+      
       /** \brief True, if this threaded Prolog query has at least one
         *   more solution
         */
@@ -81,26 +122,63 @@ namespace prolog {
       
     private:
       friend class MultiThreadedServer;
+      friend class WorkerPool;
+      
+      /** \brief Retrieve the snapshot of the next solution generated by
+        *   this threaded Prolog query
+        */
+      bool getNextSnapshot(BindingsSnapshot& snapshot, std::string& error,
+        bool block) const;
       
       /** \brief Threaded Prolog query (implementation)
         */ 
       class Impl {
       public:
-        Impl(const swi::Query& query, const swi::Engine& engine,
-          const Mode mode = BatchMode);
+        enum StepResult {
+          Yielded,
+          Waiting,
+          Finished
+        };
+        
+        Impl(const swi::Query& query, const Mode mode = BatchMode,
+          size_t bufferSize = 64);
         virtual ~Impl();
         
-        bool execute(const nodewrap::WorkerEvent& event);
+        bool isReady() const;
+        
+        StepResult step(size_t maxNumSolutions);
+        bool suspend();
+        void abort(const std::string& error);
+        void cancel();
+        
+        bool wait(bool block);
+        void notify();
+        void schedule();
+        void finish(const std::string& error);
         
         swi::Query query_;
         swi::Engine engine_;
+        swi::Frame frame_;
         
         Mode mode_;
         
-        std::list<Bindings> solutions_;
+        RingBuffer<BindingsSnapshot> solutions_;
         
         std::string error_;
+        std::atomic<size_t> localStackHighWaterMark_;
+        
+        boost::function<void()> resume_;
+        boost::function<void()> withdraw_;
+        boost::posix_time::ptime admissionTime_;
+        
+        bool started_;
+        std::atomic<bool> pending_;
+        std::atomic<bool> scheduled_;
+        std::atomic<bool> finished_;
+        std::atomic<bool> canceled_;
+        std::atomic<bool> waiting_;
         
+        boost::mutex consumerMutex_;
         boost::mutex mutex_;
         boost::condition condition_;
       };
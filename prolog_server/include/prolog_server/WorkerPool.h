@@ -0,0 +1,197 @@
+/******************************************************************************
+ * Copyright (C) 2016 by Ralf Kaestner                                        *
+ * ralf.kaestner@gmail.com                                                    *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the               *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+/** \file WorkerPool.h
+  * \brief Header file providing the WorkerPool class interface
+  */
+
+#ifndef ROS_PROLOG_SERVER_WORKER_POOL_H
+#define ROS_PROLOG_SERVER_WORKER_POOL_H
+
+#include <list>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/condition.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/weak_ptr.hpp>
+
+#include <prolog_swi/Engine.h>
+
+#include <prolog_server/ThreadedQuery.h>
+
+namespace prolog {
+  namespace server {
+    /** \brief Prolog engine worker pool
+      * 
+      * The worker pool multiplexes a pool of Prolog engines over a
+      * smaller number of long-lived threads. Each threaded Prolog query
+      * submitted to the pool is assigned an engine until it finishes,
+      * and is executed in steps by any of the pool's threads. A thread
+      * attaches the query's engine only for the duration of a step,
+      * which ends when the query has generated a number of solutions
+      * or has to wait for its solutions to be consumed. Many queries may
+      * therefore remain open without holding a thread.
+      * 
+      * Queries submitted while all engines are assigned are held in a
+      * bounded admission queue until an engine becomes idle, until
+      * they have been pending for longer than the maximum pending time,
+      * or until they are canceled.
+      */  
+    class WorkerPool {
+    public:
+      /** \brief Default constructor
+        */
+      WorkerPool();
+      
+      /** \brief Constructor (overloaded version taking the Prolog
+        *   engines of the pool, the number of threads, and the maximum
+        *   number of solutions generated by a query in each step)
+        */
+      WorkerPool(const std::vector<swi::Engine>& engines, size_t
+        numThreads, size_t numSolutionsPerStep = 64);
+      
+      /** \brief Copy constructor
+        */
+      WorkerPool(const WorkerPool& src);
+      
+      /** \brief Destructor
+        */
+      virtual ~WorkerPool();
+    
+      /** \brief Retrieve the number of threads of this Prolog engine
+        *   worker pool
+        */
+      size_t getNumThreads() const;
+      
+      /** \brief Retrieve the number of Prolog engines of this Prolog
+        *   engine worker pool
+        */
+      size_t getNumEngines() const;
+      
+      /** \brief Retrieve the number of idle Prolog engines of this
+        *   Prolog engine worker pool
+        */
+      size_t getNumIdleEngines() const;
+      
+      /** \brief Retrieve the number of pending queries of this Prolog
+        *   engine worker pool
+        */
+      size_t getNumPendingQueries() const;
+      
+      /** \brief Set the maximum number of pending queries of this Prolog
+        *   engine worker pool
+        */
+      void setMaxNumPendingQueries(size_t maxNumPendingQueries);
+      
+      /** \brief Retrieve the maximum number of pending queries of this
+        *   Prolog engine worker pool
+        */
+      size_t getMaxNumPendingQueries() const;
+      
+      /** \brief Set the maximum time in seconds a query may be pending
+        *   in this Prolog engine worker pool
+        * 
+        * A maximum pending time of zero lets queries pend until they are
+        * admitted.
+        */
+      void setMaxPendingTime(double maxPendingTime);
+      
+      /** \brief Retrieve the maximum time in seconds a query may be
+        *   pending in this Prolog engine worker pool
+        */
+      double getMaxPendingTime() const;
+      
+      /** \brief True, if this Prolog engine worker pool is valid
+        */
+      bool isValid() const;
+      
+      /** \brief Submit a threaded Prolog query to this Prolog engine
+        *   worker pool
+        * 
+        * The query is rejected if none of the pool's engines is idle and
+        * the admission queue is full.
+        */
+      bool submit(const ThreadedQuery& query);
+      
+      /** \brief Submit a threaded Prolog query to this Prolog engine
+        *   worker pool (overloaded version reporting the query's position
+        *   in the admission queue and its expected wait in seconds)
+        * 
+        * The queue position is zero for a query which has been admitted
+        * immediately. The expected wait is estimated from the mean time
+        * for which recent queries have held their engines.
+        */
+      bool submit(const ThreadedQuery& query, size_t& queuePosition,
+        double& expectedWait);
+      
+      /** \brief Shutdown this Prolog engine worker pool
+        * 
+        * All pending and executing queries are canceled, and the pool's
+        * threads are joined.
+        */
+      void shutdown();
+      
+    private:
+      /** \brief Prolog engine worker pool (implementation)
+        */ 
+      class Impl {
+      public:
+        Impl(const std::vector<swi::Engine>& engines, size_t numThreads,
+          size_t numSolutionsPerStep);
+        virtual ~Impl();
+        
+        void run();
+        void admit(const boost::shared_ptr<ThreadedQuery::Impl>& query);
+        void admitPending();
+        void expirePending();
+        void resume(const boost::weak_ptr<ThreadedQuery::Impl>& query);
+        void withdraw(const boost::weak_ptr<ThreadedQuery::Impl>& query);
+        void shutdown();
+        
+        std::list<swi::Engine> engines_;
+        std::set<boost::shared_ptr<ThreadedQuery::Impl> > queries_;
+        std::list<boost::shared_ptr<ThreadedQuery::Impl> > queue_;
+        std::list<std::pair<boost::shared_ptr<ThreadedQuery::Impl>,
+          boost::posix_time::ptime> > pending_;
+        
+        size_t numEngines_;
+        size_t numThreads_;
+        size_t numSolutionsPerStep_;
+        size_t maxNumPendingQueries_;
+        double maxPendingTime_;
+        double meanHoldTime_;
+        bool shutdown_;
+        
+        boost::thread_group threads_;
+        boost::mutex mutex_;
+        boost::condition condition_;
+      };
+      
+      /** \brief The Prolog engine worker pool's implementation
+        */
+      boost::shared_ptr<Impl> impl_;
+    };
+  };
+};
+
+#endif
@@ -18,13 +18,14 @@
 
 #include <list>
 #include <sstream>
+#include <vector>
 
 #include <boost/lexical_cast.hpp>
 
 #include <prolog_common/Bindings.h>
 
+#include <prolog_serialization/JSONBindingsWriter.h>
 #include <prolog_serialization/JSONDeserializer.h>
-#include <prolog_serialization/JSONSerializer.h>
 
 #include "prolog_server/MultiThreadedServer.h"
 
@@ -36,7 +37,9 @@ namespace prolog { namespace server {
 /* Constructors and Destructor                                               */
 /*****************************************************************************/
 
-MultiThreadedServer::MultiThreadedServer() {
+MultiThreadedServer::MultiThreadedServer() :
+  monitorLocalStack_(false),
+  solutionBufferSize_(64) {
 }
 
 MultiThreadedServer::~MultiThreadedServer() {
@@ -54,20 +57,35 @@ void MultiThreadedServer::init() {
     
     size_t numEngines = getParam(ros::names::append("prolog",
       "num_engines"), 4);
+    size_t numThreads = getParam(ros::names::append("prolog",
+      "num_threads"), (int)boost::thread::hardware_concurrency());
+    monitorLocalStack_ = getParam(ros::names::append("prolog",
+      "monitor_local_stack"), false);
+    solutionBufferSize_ = getParam(ros::names::append("prolog",
+      "solution_buffer_size"), (int)solutionBufferSize_);
+    
+    std::vector<swi::Engine> engines;
     
     for (size_t index = 0; index < numEngines; ++index) {
-      engines_.push_back(createPrologEngine("pooled_engine_"+
+      engines.push_back(createPrologEngine("pooled_engine_"+
         boost::lexical_cast<std::string>(index)));
     }
+    
+    workerPool_ = WorkerPool(engines, numThreads ? numThreads : 1);
+    workerPool_.setMaxNumPendingQueries(getParam(ros::names::append(
+      "prolog", "max_pending_queries"), 64));
+    workerPool_.setMaxPendingTime(getParam(ros::names::append("prolog",
+      "max_pending_time"), 10.0));
   }
 }
 
 void MultiThreadedServer::cleanup() {
   serviceServer_.shutdown();
-  engines_.clear();
+  workerPool_.shutdown();
+  workerPool_ = WorkerPool();
 
-  workers_.clear();
   queries_.clear();
+  preparedQueries_.clear();
   
   Server::cleanup();
 }
@@ -83,15 +101,6 @@ bool MultiThreadedServer::openQueryCallback(prolog_msgs::OpenQuery::Request&
     return true;
   }
   
-  if (engines_.empty()) {
-    response.ok = false;
-    response.error = "No Prolog engine available, pool exhausted.";
-      
-    NODEWRAP_ERROR_STREAM(response.error);
-      
-    return true;
-  }
-  
   ThreadedQuery query;
   std::string queryIdentifier = prologQueryIdentifier();  
   ThreadedQuery::Mode queryMode = ThreadedQuery::BatchMode;
@@ -105,7 +114,7 @@ bool MultiThreadedServer::openQueryCallback(prolog_msgs::OpenQuery::Request&
     
     try {
       query.impl_.reset(new ThreadedQuery::Impl(deserializer.
-        deserializeQuery(stream), engines_.front(), queryMode));
+        deserializeQuery(stream), queryMode, solutionBufferSize_));
     }
     catch (const ros::Exception& exception) {      
       response.ok = false;
@@ -120,7 +129,7 @@ bool MultiThreadedServer::openQueryCallback(prolog_msgs::OpenQuery::Request&
   else {
     try {
       query.impl_.reset(new ThreadedQuery::Impl(request.query,
-        engines_.front(), queryMode));
+        queryMode, solutionBufferSize_));
     }
     catch (const ros::Exception& exception) {
       response.ok = false;
@@ -133,65 +142,59 @@ bool MultiThreadedServer::openQueryCallback(prolog_msgs::OpenQuery::Request&
     }
   }
     
-  nodewrap::Worker worker;
-  nodewrap::WorkerOptions workerOptions;
-  
-  workerOptions.frequency = 0.0;
-  workerOptions.callback = boost::bind(&ThreadedQuery::Impl::execute,
-    query.impl_, _1);
-  workerOptions.autostart = true;
-  workerOptions.synchronous = false;
-  workerOptions.privateCallbackQueue = true;
+  std::string error;
+  size_t queuePosition;
+  double expectedWait;
   
-  try {
-    worker = addWorker("query_"+queryIdentifier, workerOptions);
-  }
-  catch (const ros::Exception& exception) {
+  if (!startQuery(queryIdentifier, query, queuePosition, expectedWait,
+      error)) {
     response.ok = false;
-    response.error = std::string("Failure to create worker: ")+
-      exception.what();
+    response.error = error;
     
     return true;
   }
   
-  engines_.pop_front();
-  queries_.insert(std::make_pair(queryIdentifier, query));
-  workers_.insert(std::make_pair(queryIdentifier, worker));
-  
   NODEWRAP_INFO_STREAM("Prolog query [" << queryIdentifier <<
     "] has been opened.");
   
   response.ok = true;
   response.id = queryIdentifier;
+  response.queue_position = queuePosition;
+  response.expected_wait = expectedWait;
   
   return true;
 }
 
 bool MultiThreadedServer::hasSolutionCallback(prolog_msgs::HasSolution::
     Request& request, prolog_msgs::HasSolution::Response& response) {
-  boost::unordered_map<std::string, ThreadedQuery>::iterator
-    it = queries_.find(request.id);
+  ThreadedQuery query;
   
-  if (it == queries_.end()) {
-    response.status = prolog_msgs::GetNextSolution::Response::
+  if (!queries_.find(request.id, query)) {
+    response.status = prolog_msgs::HasSolution::Response::
       STATUS_INVALID_ID;
     
     return true;
   }
   
+  if (query.isPending()) {
+    response.status = prolog_msgs::HasSolution::Response::STATUS_PENDING;
+    
+    return true;
+  }
+  
   std::string error;
   
-  response.result = it->second.hasSolution(error, true);
+  response.result = query.hasSolution(error, true);
   
   if (!response.result && !error.empty()) {
-    response.status = prolog_msgs::GetNextSolution::Response::
+    response.status = prolog_msgs::HasSolution::Response::
       STATUS_QUERY_FAILED;
     response.error = error;
     
     return true;
   }
   
-  response.status = prolog_msgs::GetNextSolution::Response::STATUS_OK;
+  response.status = prolog_msgs::HasSolution::Response::STATUS_OK;
   
   return true;
 }
@@ -199,33 +202,33 @@ bool MultiThreadedServer::hasSolutionCallback(prolog_msgs::HasSolution::
 bool MultiThreadedServer::getAllSolutionsCallback(prolog_msgs::
     GetAllSolutions::Request& request, prolog_msgs::GetAllSolutions::
     Response& response) {
-  boost::unordered_map<std::string, ThreadedQuery>::iterator
-    it = queries_.find(request.id);
+  ThreadedQuery query;
   
-  if (it == queries_.end()) {
+  if (!queries_.find(request.id, query)) {
     response.status = prolog_msgs::GetNextSolution::Response::
       STATUS_INVALID_ID;
     
     return true;
   }
   
-  std::list<Bindings> solutions;
-  Bindings bindings;
-  std::string error;
+  if (query.isPending()) {
+    response.status = prolog_msgs::GetAllSolutions::Response::
+      STATUS_PENDING;
+    
+    return true;
+  }
   
-  while (it->second.getNextSolution(bindings, error, true))
-    solutions.push_back(bindings);
+  std::list<std::string> solutions;
+  serialization::JSONBindingsWriter writer;
+  std::string error;
   
-  boost::unordered_map<std::string, nodewrap::Worker>::iterator
-    jt = workers_.find(request.id);
-    
-  if (jt != workers_.end()) {
-    jt->second.cancel(true);
-    workers_.erase(jt);
+  while (query.getNextSolution(writer, error, true)) {
+    solutions.push_back(writer.getOutput());
+    writer.clear();
   }
   
-  engines_.push_back(it->second.impl_->engine_);
-  queries_.erase(it);
+  queries_.erase(request.id);
+  query.impl_->cancel();
   
   NODEWRAP_INFO_STREAM("Prolog query [" << request.id <<
     "] has been closed.");
@@ -245,17 +248,7 @@ bool MultiThreadedServer::getAllSolutionsCallback(prolog_msgs::
     return true;
   }
     
-  serialization::JSONSerializer serializer;
-
-  for (std::list<Bindings>::const_iterator it = solutions.begin();
-      it != solutions.end(); ++it) {
-    std::ostringstream stream;
-  
-    serializer.serializeBindings(stream, *it);
-  
-    response.solutions.push_back(stream.str());
-  }
-
+  response.solutions.assign(solutions.begin(), solutions.end());
   response.status = prolog_msgs::GetNextSolution::Response::STATUS_OK;
   
   return true;
@@ -264,20 +257,26 @@ bool MultiThreadedServer::getAllSolutionsCallback(prolog_msgs::
 bool MultiThreadedServer::getNextSolutionCallback(prolog_msgs::
     GetNextSolution::Request& request, prolog_msgs::GetNextSolution::
     Response& response) {
-  boost::unordered_map<std::string, ThreadedQuery>::iterator
-    it = queries_.find(request.id);
+  ThreadedQuery query;
   
-  if (it == queries_.end()) {
+  if (!queries_.find(request.id, query)) {
     response.status = prolog_msgs::GetNextSolution::Response::
       STATUS_INVALID_ID;
     
     return true;
   }
   
-  Bindings bindings;
+  if (query.isPending()) {
+    response.status = prolog_msgs::GetNextSolution::Response::
+      STATUS_PENDING;
+    
+    return true;
+  }
+  
+  serialization::JSONBindingsWriter writer;
   std::string error;
   
-  if (!it->second.getNextSolution(bindings, error, true)) {
+  if (!query.getNextSolution(writer, error, true)) {
     if (!error.empty()) {
       response.status = prolog_msgs::GetNextSolution::Response::
         STATUS_QUERY_FAILED;
@@ -291,27 +290,14 @@ bool MultiThreadedServer::getNextSolutionCallback(prolog_msgs::
   }
   
   if (request.close) {
-    boost::unordered_map<std::string, nodewrap::Worker>::iterator
-      jt = workers_.find(request.id);
-      
-    if (jt != workers_.end()) {
-      jt->second.cancel(true);
-      workers_.erase(jt);
-    }
-    
-    engines_.push_back(it->second.impl_->engine_);
-    queries_.erase(it);
+    queries_.erase(request.id);
+    query.impl_->cancel();
     
     NODEWRAP_INFO_STREAM("Prolog query [" << request.id <<
       "] has been closed.");
   }
   
-  std::ostringstream stream;
-  serialization::JSONSerializer serializer;
-  
-  serializer.serializeBindings(stream, bindings);
-
-  response.solution = stream.str();    
+  response.solution = writer.getOutput();
   response.status = prolog_msgs::GetNextSolution::Response::STATUS_OK;
   
   return true;
@@ -319,25 +305,24 @@ bool MultiThreadedServer::getNextSolutionCallback(prolog_msgs::
 
 bool MultiThreadedServer::closeQueryCallback(prolog_msgs::CloseQuery::
     Request& request, prolog_msgs::CloseQuery::Response& response) {
-  boost::unordered_map<std::string, ThreadedQuery>::iterator
-    it = queries_.find(request.id);
-  
-  if (it == queries_.end()) {
-    response.status = prolog_msgs::CloseQuery::Response::STATUS_INVALID_ID;
+  if (preparedQueries_.erase(request.id)) {
+    NODEWRAP_INFO_STREAM("Prepared Prolog query [" << request.id << 
+      "] has been released.");
+    
+    response.status = prolog_msgs::CloseQuery::Response::STATUS_OK;
     
     return true;
   }
   
-  boost::unordered_map<std::string, nodewrap::Worker>::iterator
-    jt = workers_.find(request.id);
+  ThreadedQuery query;
   
-  if (jt != workers_.end()) {
-    jt->second.cancel(true);
-    workers_.erase(jt);
+  if (!queries_.erase(request.id, query)) {
+    response.status = prolog_msgs::CloseQuery::Response::STATUS_INVALID_ID;
+    
+    return true;
   }
   
-  engines_.push_back(it->second.impl_->engine_);
-  queries_.erase(it);
+  query.impl_->cancel();
   
   NODEWRAP_INFO_STREAM("Prolog query [" << request.id << 
     "] has been closed.");
@@ -347,4 +332,141 @@ bool MultiThreadedServer::closeQueryCallback(prolog_msgs::CloseQuery::
   return true;
 }
 
+bool MultiThreadedServer::prepareQueryCallback(prolog_msgs::PrepareQuery::
+    Request& request, prolog_msgs::PrepareQuery::Response& response) {
+  if (request.query.empty()) {
+    response.ok = false;
+    response.error = "Query is empty.";
+    
+    NODEWRAP_ERROR_STREAM(response.error);
+      
+    return true;
+  }
+  
+  swi::PreparedQuery query;
+  std::string queryIdentifier = prologQueryIdentifier();
+  
+  try {
+    if (request.format == prolog_msgs::PrepareQuery::Request::FORMAT_JSON) {
+      std::istringstream stream(request.query);
+      serialization::JSONDeserializer deserializer;
+      
+      query = swi::PreparedQuery(deserializer.deserializeQuery(stream),
+        request.parameters);
+    }
+    else
+      query = swi::PreparedQuery(request.query, request.parameters);
+  }
+  catch (const ros::Exception& exception) {      
+    response.ok = false;
+    response.error = std::string("Failure to prepare query: ")+
+      exception.what();
+      
+    NODEWRAP_ERROR_STREAM(response.error);
+      
+    return true;
+  }
+  
+  preparedQueries_.insert(queryIdentifier, query);
+  
+  NODEWRAP_INFO_STREAM("Prolog query [" << queryIdentifier <<
+    "] has been prepared.");
+  
+  response.ok = true;
+  response.id = queryIdentifier;
+  
+  return true;
+}
+
+bool MultiThreadedServer::executePreparedCallback(prolog_msgs::
+    ExecutePrepared::Request& request, prolog_msgs::ExecutePrepared::
+    Response& response) {
+  swi::PreparedQuery preparedQuery;
+  
+  if (!preparedQueries_.find(request.id, preparedQuery)) {
+    response.ok = false;
+    response.error = "Prepared query identifier is invalid.";
+    
+    NODEWRAP_ERROR_STREAM(response.error);
+      
+    return true;
+  }
+  
+  ThreadedQuery query;
+  std::string queryIdentifier = prologQueryIdentifier();  
+  ThreadedQuery::Mode queryMode = ThreadedQuery::BatchMode;
+  
+  if (request.mode == prolog_msgs::ExecutePrepared::Request::
+      MODE_INCREMENTAL)
+    queryMode = ThreadedQuery::IncrementalMode;
+  
+  std::vector<Term> values;
+  serialization::JSONDeserializer deserializer;
+  
+  try {
+    for (size_t index = 0; index < request.values.size(); ++index) {
+      std::istringstream stream(request.values[index]);
+      
+      values.push_back(deserializer.deserializeTerm(stream));
+    }
+    
+    query.impl_.reset(new ThreadedQuery::Impl(swi::PreparedQuery(
+      preparedQuery, values), queryMode, solutionBufferSize_));
+  }
+  catch (const ros::Exception& exception) {      
+    response.ok = false;
+    response.error = std::string("Failure to create query: ")+
+      exception.what();
+      
+    NODEWRAP_ERROR_STREAM(response.error);
+      
+    return true;
+  }
+  
+  std::string error;
+  size_t queuePosition;
+  double expectedWait;
+  
+  if (!startQuery(queryIdentifier, query, queuePosition, expectedWait,
+      error)) {
+    response.ok = false;
+    response.error = error;
+    
+    return true;
+  }
+  
+  NODEWRAP_INFO_STREAM("Prolog query [" << queryIdentifier <<
+    "] has been opened from prepared query [" << request.id << "].");
+  
+  response.ok = true;
+  response.id = queryIdentifier;
+  response.queue_position = queuePosition;
+  response.expected_wait = expectedWait;
+  
+  return true;
+}
+
+bool MultiThreadedServer::startQuery(const std::string& identifier, const
+    ThreadedQuery& query, size_t& queuePosition, double& expectedWait,
+    std::string& error) {
+  query.impl_->query_.setLocalStackMonitoring(monitorLocalStack_);
+  
+  if (!workerPool_.submit(query, queuePosition, expectedWait)) {
+    error = "No Prolog engine available, admission queue full.";
+    
+    NODEWRAP_ERROR_STREAM(error);
+    
+    return false;
+  }
+  
+  if (queuePosition)
+    NODEWRAP_INFO_STREAM("Prolog query [" << identifier <<
+      "] is pending at admission queue position " << queuePosition <<
+      ", expected wait is " << expectedWait << " seconds.");
+  
+  queries_.insert(identifier, query);
+  
+  return true;
+}
+
 }}
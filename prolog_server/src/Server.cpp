@@ -78,6 +78,16 @@ ServiceServer Server::advertisePrologService(const std::string& name,
     defaultServiceNamespace.empty() ? std::string("close_query") :
       ros::names::append(defaultServiceNamespace, "close_query"),
     &Server::closeQueryCallback);
+  server.impl_->prepareQueryServer_ = advertiseService(
+    ros::names::append(name, "prepare_query"),
+    defaultServiceNamespace.empty() ? std::string("prepare_query") :
+      ros::names::append(defaultServiceNamespace, "prepare_query"),
+    &Server::prepareQueryCallback);
+  server.impl_->executePreparedServer_ = advertiseService(
+    ros::names::append(name, "execute_prepared"),
+    defaultServiceNamespace.empty() ? std::string("execute_prepared") :
+      ros::names::append(defaultServiceNamespace, "execute_prepared"),
+    &Server::executePreparedCallback);
   
   return server;
 }
@@ -98,8 +108,14 @@ swi::Engine Server::createPrologEngine(const std::string& name, size_t
 }
 
 std::string Server::prologQueryIdentifier() {  
-  std::string uuid = boost::lexical_cast<std::string>(
-    queryIdentifierGenerator_());
+  boost::uuids::uuid identifier;
+  
+  {
+    boost::mutex::scoped_lock lock(queryIdentifierMutex_);
+    identifier = queryIdentifierGenerator_();
+  }
+  
+  std::string uuid = boost::lexical_cast<std::string>(identifier);
   std::replace(uuid.begin(), uuid.end(), '-', '_');
   
   return uuid;
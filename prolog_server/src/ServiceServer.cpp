@@ -57,7 +57,9 @@ bool ServiceServer::Impl::isValid() const {
     getAllSolutionsServer_ &&
     getNextSolutionServer_ &&
     hasSolutionServer_ &&
-    closeQueryServer_;
+    closeQueryServer_ &&
+    prepareQueryServer_ &&
+    executePreparedServer_;
 }
 
 /*****************************************************************************/
@@ -75,6 +77,8 @@ void ServiceServer::Impl::shutdown() {
   getNextSolutionServer_.shutdown();
   hasSolutionServer_.shutdown();
   closeQueryServer_.shutdown();
+  prepareQueryServer_.shutdown();
+  executePreparedServer_.shutdown();
 }
 
 }}
@@ -20,8 +20,6 @@
 
 #include <ros/console.h>
 
-#include <prolog_swi/Frame.h>
-
 #include "prolog_server/ThreadedQuery.h"
 
 namespace prolog { namespace server {
@@ -40,11 +38,18 @@ ThreadedQuery::ThreadedQuery(const ThreadedQuery& src) :
 ThreadedQuery::~ThreadedQuery() {
 }
 
-ThreadedQuery::Impl::Impl(const swi::Query& query, const swi::Engine& engine,
-    Mode mode) :
+ThreadedQuery::Impl::Impl(const swi::Query& query, Mode mode, size_t
+    bufferSize) :
   query_(query),
-  engine_(engine),
-  mode_(mode) {
+  mode_(mode),
+  solutions_(bufferSize),
+  localStackHighWaterMark_(0),
+  started_(false),
+  pending_(false),
+  scheduled_(false),
+  finished_(false),
+  canceled_(false),
+  waiting_(false) {
 }
 
 ThreadedQuery::Impl::~Impl() {
@@ -64,145 +69,261 @@ std::string ThreadedQuery::getError() const {
     return std::string();
 }
 
+size_t ThreadedQuery::getLocalStackHighWaterMark() const {
+  if (impl_.get())
+    return impl_->localStackHighWaterMark_.load(std::memory_order_relaxed);
+  else
+    return 0;
+}
+
+bool ThreadedQuery::isPending() const {
+  if (impl_.get())
+    return impl_->pending_.load();
+  else
+    return false;
+}
+
 bool ThreadedQuery::getNextSolution(Bindings& bindings, std::string& error,
     bool block) const {
-  if (impl_.get()) {
-    boost::mutex::scoped_lock lock(impl_->mutex_);
+  BindingsSnapshot snapshot;
+  
+  if (!getNextSnapshot(snapshot, error, block))
+    return false;
+  
+  try {
+    bindings = snapshot.decode();
+  }
+  catch (const ros::Exception& exception) {
+    error = std::string("Failure to decode solution: ")+exception.what();
     
-    if (impl_->solutions_.empty() && impl_->query_.isOpen() && block)
-      impl_->condition_.wait(impl_->mutex_);
+    return false;
+  }
+  
+  return true;
+}
+
+bool ThreadedQuery::getNextSolution(BindingsWriter& writer, std::string&
+    error, bool block) const {
+  BindingsSnapshot snapshot;
+  
+  if (!getNextSnapshot(snapshot, error, block))
+    return false;
+  
+  try {
+    snapshot.replay(writer);
+  }
+  catch (const ros::Exception& exception) {
+    error = std::string("Failure to decode solution: ")+exception.what();
     
-    if (!impl_->solutions_.empty()) {
-      bindings = impl_->solutions_.front();
+    return false;
+  }
+  
+  return true;
+}
 
-      impl_->solutions_.pop_front();
-      impl_->condition_.notify_all();
-      
+bool ThreadedQuery::hasSolution(std::string& error, bool block) const {
+  if (impl_.get()) {
+    boost::mutex::scoped_lock consumerLock(impl_->consumerMutex_);
+    
+    if (impl_->wait(block))
       return true;
-    }
-    else {
-      error = impl_->error_;
-      
-      return false;
-    }
+    
+    error = getError();
+    
+    return false;
   }
   else
     return false;
 }
 
-bool ThreadedQuery::hasSolution(std::string& error, bool block) const {
+bool ThreadedQuery::getNextSnapshot(BindingsSnapshot& snapshot, std::string&
+    error, bool block) const {
   if (impl_.get()) {
-    boost::mutex::scoped_lock lock(impl_->mutex_);
-    
-    if (impl_->solutions_.empty() && impl_->query_.isOpen() && block)
-      impl_->condition_.wait(impl_->mutex_);
+    boost::mutex::scoped_lock consumerLock(impl_->consumerMutex_);
     
-    if (impl_->solutions_.empty()) {
-      error = impl_->error_;
+    if (impl_->wait(block) && impl_->solutions_.pop(snapshot)) {
+      if (impl_->isReady())
+        impl_->schedule();
       
-      return false;
-    }
-    else
       return true;
+    }
+    
+    error = getError();
+    
+    return false;
   }
   else
     return false;
 }
 
+bool ThreadedQuery::Impl::isReady() const {
+  if (mode_ == BatchMode)
+    return !solutions_.isFull();
+  else
+    return solutions_.isEmpty();
+}
+
 /*****************************************************************************/
 /* Methods                                                                   */
 /*****************************************************************************/
 
-bool ThreadedQuery::Impl::execute(const nodewrap::WorkerEvent& event) {  
-  boost::mutex::scoped_lock lock(mutex_);
+ThreadedQuery::Impl::StepResult ThreadedQuery::Impl::step(size_t
+    maxNumSolutions) {
+  std::string error;
+  
+  if (!started_ && !canceled_) {
+    started_ = true;
     
-  if (!query_.isValid()) {
-    error_ = "ThreadedQuery is invalid.";
-    ROS_ERROR_STREAM(error_);
+    if (!query_.isValid())
+      error = "ThreadedQuery is invalid.";
+    else if (!frame_.open())
+      error = "Failure to open foreign frame.";
+    else {
+      try {
+        query_.open();
+      }
+      catch (ros::Exception& exception) {
+        error = std::string("Failure to open query: ")+exception.what();
+      }
+    }
     
-    return false;
+    if (!error.empty())
+      ROS_ERROR_STREAM(error);
   }
-
-  boost::shared_ptr<swi::Engine::ScopedAcquisition> acquisition;
   
-  try {
-    acquisition.reset(new swi::Engine::ScopedAcquisition(engine_));
+  bool result = started_ && error.empty();
+  size_t numSolutions = 0;
+  
+  while (result && !canceled_ && (numSolutions < maxNumSolutions) &&
+      isReady()) {
+    BindingsSnapshot snapshot;
+    
+    try {
+      result = query_.nextSolution(snapshot);
+      
+      localStackHighWaterMark_.store(query_.getLocalStackHighWaterMark(),
+        std::memory_order_relaxed);
+    }
+    catch (ros::Exception& exception) {
+      error = std::string("Failure to generate solution: ")+
+        exception.what();
+      ROS_ERROR_STREAM(error);
+      
+      result = false;
+    }
+    
+    if (result) {
+      solutions_.push(snapshot);
+      ++numSolutions;
+      
+      notify();
+    }
   }
-  catch (const ros::Exception& exception) {
-    error_ = exception.what();
-    ROS_ERROR_STREAM(error_);
+  
+  if (!result || canceled_) {
+    query_.close();
+    frame_.close();
+    
+    if (query_.isLocalStackMonitored())
+      ROS_DEBUG_STREAM("Local stack high-water mark of query: " <<
+        localStackHighWaterMark_ << " bytes.");
     
+    finish(error);
+    
+    return Finished;
+  }
+  else if (isReady())
+    return Yielded;
+  else
+    return Waiting;
+}
+
+bool ThreadedQuery::Impl::suspend() {
+  scheduled_.store(false);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  
+  if ((canceled_ || isReady()) && !scheduled_.exchange(true))
     return false;
-  }  
   
-  swi::Frame frame;
+  return true;
+}
+
+void ThreadedQuery::Impl::abort(const std::string& error) {
+  finish(error);
+}
+
+void ThreadedQuery::Impl::cancel() {
+  canceled_.store(true);
   
-  if (!frame.open()) {
-    error_ = "Failure to open foreign frame.";
-    ROS_ERROR_STREAM(error_);
-    
-    return false;
-  }
+  boost::function<void()> withdraw;
   
-  try {
-    query_.open();
+  {
+    boost::mutex::scoped_lock lock(mutex_);
+    withdraw = withdraw_;
   }
-  catch (ros::Exception& exception) {
-    error_ = std::string("Failure to open query: ")+
-      exception.what();
-    ROS_ERROR_STREAM(error_);
+  
+  if (withdraw)
+    withdraw();
+  
+  schedule();
+}
+
+bool ThreadedQuery::Impl::wait(bool block) {
+  if (!solutions_.isEmpty())
+    return true;
+  
+  if (block) {
+    boost::mutex::scoped_lock lock(mutex_);
     
-    return false;
+    waiting_.store(true);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    
+    while (solutions_.isEmpty() && !finished_)
+      condition_.wait(mutex_);
+    
+    waiting_.store(false);
   }
   
-  bool result = true;
+  return !solutions_.isEmpty();
+}
+
+void ThreadedQuery::Impl::notify() {
+  std::atomic_thread_fence(std::memory_order_seq_cst);
   
-  while (result && !event.isWorkerCanceled()) {
-    Bindings bindings;
-    
-    try {
-      mutex_.unlock();
-      
-      result = query_.nextSolution(bindings);
-      
-      mutex_.lock();
-    }
-    catch (ros::Exception& exception) {
-      mutex_.lock();
-      
-      error_ = std::string("Failure to generate solution: ")+
-        exception.what();
-      ROS_ERROR_STREAM(error_);
+  if (waiting_.load()) {
+    boost::mutex::scoped_lock lock(mutex_);
+    condition_.notify_all();
+  }
+}
 
-      query_.close();
-      condition_.notify_all();
-      
-      return false;
+void ThreadedQuery::Impl::schedule() {
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  
+  if (!scheduled_.load() && !scheduled_.exchange(true)) {
+    boost::function<void()> resume;
+    
+    {
+      boost::mutex::scoped_lock lock(mutex_);
+      resume = resume_;
     }
     
-    if (result) {
-      solutions_.push_back(bindings);
-      
-      condition_.notify_all();
-
-      if (mode_ == IncrementalMode) {
-        while (!condition_.timed_wait(mutex_, boost::posix_time::
-            milliseconds(25))) {
-          if (event.isWorkerCanceled()) {
-            query_.close();
-            condition_.notify_all();
-            
-            return false;
-          }
-        }
-      }
-    }    
+    if (resume)
+      resume();
   }
+}
+
+void ThreadedQuery::Impl::finish(const std::string& error) {
+  boost::mutex::scoped_lock lock(mutex_);
   
-  query_.close();
-  condition_.notify_all();
+  if (!error.empty())
+    error_ = error;
+  
+  resume_.clear();
+  withdraw_.clear();
+  pending_.store(false);
+  finished_.store(true);
   
-  return false;
+  condition_.notify_all();
 }
 
 }}
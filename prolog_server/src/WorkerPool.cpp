@@ -0,0 +1,400 @@
+/******************************************************************************
+ * Copyright (C) 2016 by Ralf Kaestner                                        *
+ * ralf.kaestner@gmail.com                                                    *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the               *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+#include <cmath>
+
+#include <boost/bind.hpp>
+#include <boost/thread/locks.hpp>
+
+#include <ros/console.h>
+
+#include "prolog_server/WorkerPool.h"
+
+namespace prolog { namespace server {
+
+/*****************************************************************************/
+/* Constructors and Destructor                                               */
+/*****************************************************************************/
+
+WorkerPool::WorkerPool() {
+}
+
+WorkerPool::WorkerPool(const std::vector<swi::Engine>& engines, size_t
+    numThreads, size_t numSolutionsPerStep) :
+  impl_(new Impl(engines, numThreads, numSolutionsPerStep)) {
+}
+
+WorkerPool::WorkerPool(const WorkerPool& src) :
+  impl_(src.impl_) {
+}
+
+WorkerPool::~WorkerPool() {
+}
+
+WorkerPool::Impl::Impl(const std::vector<swi::Engine>& engines, size_t
+    numThreads, size_t numSolutionsPerStep) :
+  engines_(engines.begin(), engines.end()),
+  numEngines_(engines.size()),
+  numThreads_(numThreads),
+  numSolutionsPerStep_(numSolutionsPerStep ? numSolutionsPerStep : 1),
+  maxNumPendingQueries_(0),
+  maxPendingTime_(0.0),
+  meanHoldTime_(0.0),
+  shutdown_(false) {
+  for (size_t index = 0; index < numThreads_; ++index)
+    threads_.create_thread(boost::bind(&WorkerPool::Impl::run, this));
+}
+
+WorkerPool::Impl::~Impl() {
+  shutdown();
+}
+
+/*****************************************************************************/
+/* Accessors                                                                 */
+/*****************************************************************************/
+
+size_t WorkerPool::getNumThreads() const {
+  if (impl_.get())
+    return impl_->numThreads_;
+  else
+    return 0;
+}
+
+size_t WorkerPool::getNumEngines() const {
+  if (impl_.get()) {
+    boost::mutex::scoped_lock lock(impl_->mutex_);
+    
+    return impl_->numEngines_;
+  }
+  else
+    return 0;
+}
+
+size_t WorkerPool::getNumIdleEngines() const {
+  if (impl_.get()) {
+    boost::mutex::scoped_lock lock(impl_->mutex_);
+    
+    return impl_->engines_.size();
+  }
+  else
+    return 0;
+}
+
+size_t WorkerPool::getNumPendingQueries() const {
+  if (impl_.get()) {
+    boost::mutex::scoped_lock lock(impl_->mutex_);
+    
+    return impl_->pending_.size();
+  }
+  else
+    return 0;
+}
+
+void WorkerPool::setMaxNumPendingQueries(size_t maxNumPendingQueries) {
+  if (impl_.get()) {
+    boost::mutex::scoped_lock lock(impl_->mutex_);
+    
+    impl_->maxNumPendingQueries_ = maxNumPendingQueries;
+  }
+}
+
+size_t WorkerPool::getMaxNumPendingQueries() const {
+  if (impl_.get()) {
+    boost::mutex::scoped_lock lock(impl_->mutex_);
+    
+    return impl_->maxNumPendingQueries_;
+  }
+  else
+    return 0;
+}
+
+void WorkerPool::setMaxPendingTime(double maxPendingTime) {
+  if (impl_.get()) {
+    boost::mutex::scoped_lock lock(impl_->mutex_);
+    
+    impl_->maxPendingTime_ = (maxPendingTime > 0.0) ? maxPendingTime : 0.0;
+  }
+}
+
+double WorkerPool::getMaxPendingTime() const {
+  if (impl_.get()) {
+    boost::mutex::scoped_lock lock(impl_->mutex_);
+    
+    return impl_->maxPendingTime_;
+  }
+  else
+    return 0.0;
+}
+
+bool WorkerPool::isValid() const {
+  return impl_.get();
+}
+
+/*****************************************************************************/
+/* Methods                                                                   */
+/*****************************************************************************/
+
+bool WorkerPool::submit(const ThreadedQuery& query) {
+  size_t queuePosition;
+  double expectedWait;
+  
+  return submit(query, queuePosition, expectedWait);
+}
+
+bool WorkerPool::submit(const ThreadedQuery& query, size_t& queuePosition,
+    double& expectedWait) {
+  queuePosition = 0;
+  expectedWait = 0.0;
+  
+  if (impl_.get() && query.impl_.get()) {
+    boost::mutex::scoped_lock lock(impl_->mutex_);
+    
+    if (impl_->shutdown_)
+      return false;
+    
+    if (impl_->engines_.empty() && (impl_->pending_.size() >=
+        impl_->maxNumPendingQueries_))
+      return false;
+    
+    {
+      boost::mutex::scoped_lock queryLock(query.impl_->mutex_);
+      
+      query.impl_->scheduled_.store(true);
+      query.impl_->resume_ = boost::bind(&WorkerPool::Impl::resume,
+        impl_.get(), boost::weak_ptr<ThreadedQuery::Impl>(query.impl_));
+      
+      if (impl_->engines_.empty()) {
+        query.impl_->pending_.store(true);
+        query.impl_->withdraw_ = boost::bind(&WorkerPool::Impl::withdraw,
+          impl_.get(), boost::weak_ptr<ThreadedQuery::Impl>(query.impl_));
+      }
+    }
+    
+    if (impl_->engines_.empty()) {
+      boost::posix_time::ptime deadline;
+      
+      if (impl_->maxPendingTime_ > 0.0)
+        deadline = boost::posix_time::microsec_clock::universal_time()+
+          boost::posix_time::microseconds((int64_t)(impl_->maxPendingTime_*1e6));
+      
+      impl_->pending_.push_back(std::make_pair(query.impl_, deadline));
+      
+      queuePosition = impl_->pending_.size();
+      expectedWait = impl_->meanHoldTime_*std::ceil((double)queuePosition/
+        (impl_->numEngines_ ? impl_->numEngines_ : 1));
+      
+      impl_->condition_.notify_all();
+    }
+    else
+      impl_->admit(query.impl_);
+    
+    return true;
+  }
+  else
+    return false;
+}
+
+void WorkerPool::shutdown() {
+  if (impl_.get())
+    impl_->shutdown();
+}
+
+void WorkerPool::Impl::run() {
+  boost::mutex::scoped_lock lock(mutex_);
+  
+  while (true) {
+    while (queue_.empty() && !(shutdown_ && queries_.empty())) {
+      boost::posix_time::ptime deadline;
+      
+      for (std::list<std::pair<boost::shared_ptr<ThreadedQuery::Impl>,
+          boost::posix_time::ptime> >::const_iterator it = pending_.begin();
+          it != pending_.end(); ++it) {
+        if (!it->second.is_not_a_date_time() &&
+            (deadline.is_not_a_date_time() || (it->second < deadline)))
+          deadline = it->second;
+      }
+      
+      if (deadline.is_not_a_date_time())
+        condition_.wait(lock);
+      else
+        condition_.timed_wait(lock, deadline);
+      
+      expirePending();
+    }
+    
+    if (queue_.empty())
+      break;
+    
+    boost::shared_ptr<ThreadedQuery::Impl> query = queue_.front();
+    ThreadedQuery::Impl::StepResult result;
+    bool acquired = false;
+    
+    queue_.pop_front();
+    lock.unlock();
+    
+    try {
+      swi::Engine::ScopedAcquisition acquisition(query->engine_);
+      
+      acquired = true;
+      result = query->step(numSolutionsPerStep_);
+    }
+    catch (const ros::Exception& exception) {
+      ROS_ERROR_STREAM(exception.what());
+      
+      query->abort(exception.what());
+      result = ThreadedQuery::Impl::Finished;
+    }
+    
+    if ((result == ThreadedQuery::Impl::Waiting) && !query->suspend())
+      result = ThreadedQuery::Impl::Yielded;
+    
+    lock.lock();
+    
+    if (result == ThreadedQuery::Impl::Yielded)
+      queue_.push_back(query);
+    else if (result == ThreadedQuery::Impl::Finished) {
+      if (acquired) {
+        double holdTime = (boost::posix_time::microsec_clock::
+          universal_time()-query->admissionTime_).total_microseconds()*1e-6;
+        
+        meanHoldTime_ = (meanHoldTime_ > 0.0) ?
+          0.9*meanHoldTime_+0.1*holdTime : holdTime;
+        engines_.push_back(query->engine_);
+      }
+      else
+        --numEngines_;
+      
+      queries_.erase(query);
+      admitPending();
+      
+      condition_.notify_all();
+    }
+  }
+}
+
+void WorkerPool::Impl::admit(const boost::shared_ptr<ThreadedQuery::Impl>&
+    query) {
+  {
+    boost::mutex::scoped_lock queryLock(query->mutex_);
+    query->withdraw_.clear();
+  }
+  
+  query->pending_.store(false);
+  
+  query->engine_ = engines_.front();
+  query->admissionTime_ = boost::posix_time::microsec_clock::
+    universal_time();
+  
+  engines_.pop_front();
+  queries_.insert(query);
+  queue_.push_back(query);
+  
+  condition_.notify_one();
+}
+
+void WorkerPool::Impl::admitPending() {
+  expirePending();
+  
+  while (!engines_.empty() && !pending_.empty()) {
+    admit(pending_.front().first);
+    pending_.pop_front();
+  }
+}
+
+void WorkerPool::Impl::expirePending() {
+  boost::posix_time::ptime now = boost::posix_time::microsec_clock::
+    universal_time();
+  
+  std::list<std::pair<boost::shared_ptr<ThreadedQuery::Impl>,
+    boost::posix_time::ptime> >::iterator it = pending_.begin();
+  
+  while (it != pending_.end()) {
+    if (it->first->canceled_) {
+      it->first->abort("Query has been canceled.");
+      it = pending_.erase(it);
+    }
+    else if (!it->second.is_not_a_date_time() && (it->second <= now)) {
+      std::string error = "Failure to admit query: Timeout.";
+      ROS_ERROR_STREAM(error);
+      
+      it->first->abort(error);
+      it = pending_.erase(it);
+    }
+    else
+      ++it;
+  }
+}
+
+void WorkerPool::Impl::resume(const boost::weak_ptr<ThreadedQuery::Impl>&
+    query) {
+  boost::shared_ptr<ThreadedQuery::Impl> resumedQuery = query.lock();
+  
+  if (resumedQuery.get()) {
+    boost::mutex::scoped_lock lock(mutex_);
+    
+    queue_.push_back(resumedQuery);
+    condition_.notify_one();
+  }
+}
+
+void WorkerPool::Impl::withdraw(const boost::weak_ptr<ThreadedQuery::Impl>&
+    query) {
+  boost::shared_ptr<ThreadedQuery::Impl> withdrawnQuery = query.lock();
+  
+  if (withdrawnQuery.get()) {
+    boost::mutex::scoped_lock lock(mutex_);
+    
+    for (std::list<std::pair<boost::shared_ptr<ThreadedQuery::Impl>,
+        boost::posix_time::ptime> >::iterator it = pending_.begin();
+        it != pending_.end(); ++it) {
+      if (it->first == withdrawnQuery) {
+        withdrawnQuery->abort("Query has been canceled.");
+        pending_.erase(it);
+        
+        condition_.notify_all();
+        break;
+      }
+    }
+  }
+}
+
+void WorkerPool::Impl::shutdown() {
+  std::vector<boost::shared_ptr<ThreadedQuery::Impl> > queries;
+  
+  {
+    boost::mutex::scoped_lock lock(mutex_);
+    
+    shutdown_ = true;
+    queries.assign(queries_.begin(), queries_.end());
+    
+    while (!pending_.empty()) {
+      pending_.front().first->abort(
+        "Failure to admit query: Worker pool is shut down.");
+      pending_.pop_front();
+    }
+    
+    condition_.notify_all();
+  }
+  
+  for (size_t index = 0; index < queries.size(); ++index)
+    queries[index]->cancel();
+  
+  threads_.join_all();
+}
+
+}}
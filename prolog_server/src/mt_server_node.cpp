@@ -24,8 +24,13 @@ int main(int argc, char** argv) {
   ros::init(argc, argv, "prolog_server");
   
   nodewrap::Node<prolog::server::MultiThreadedServer> node;
-
-  ros::spin();
+  
+  int numSpinnerThreads = ros::NodeHandle("~").param(
+    "num_spinner_threads", 0);
+  ros::MultiThreadedSpinner spinner(numSpinnerThreads > 0 ?
+    numSpinnerThreads : 0);
+  
+  spinner.spin();
     
   return 0;
 }
@@ -24,11 +24,14 @@
 #define ROS_PROLOG_SWI_BINDINGS_H
 
 #include <string>
+#include <vector>
 
-#include <boost/unordered_map.hpp>
 #include <boost/shared_ptr.hpp>
 
 #include <prolog_common/Bindings.h>
+#include <prolog_common/BindingsSchema.h>
+#include <prolog_common/BindingsSnapshot.h>
+#include <prolog_common/Symbol.h>
 #include <prolog_common/Term.h>
 
 #include <prolog_swi/Term.h>
@@ -36,6 +39,10 @@
 namespace prolog {
   namespace swi {
     /** \brief SWI-Prolog bindings
+      * 
+      * The SWI-Prolog bindings of a query store their terms in slots of
+      * a Prolog bindings schema which is shared with all the Prolog
+      * bindings converted from them.
       */  
     class Bindings {
     public:
@@ -59,6 +66,11 @@ namespace prolog {
         */
       void addTerm(const std::string& name, const Term& term);
       
+      /** \brief Add a term to these SWI-Prolog bindings (overloaded
+        *   version taking an interned symbol)
+        */
+      void addTerm(const Symbol& name, const Term& term);
+      
       /** \brief Clear these SWI-Prolog bindings
         */
       void clear();
@@ -68,9 +80,61 @@ namespace prolog {
         */
       operator prolog::Bindings() const;
       
+      /** \brief Convert these SWI-Prolog bindings to some Prolog
+        *   bindings which are built into a Prolog term arena
+        */
+      prolog::Bindings toBindings(TermArena& arena) const;
+      
+      /** \brief Convert these SWI-Prolog bindings to some Prolog
+        *   bindings which are built through a hash-consing Prolog term
+        *   factory
+        */
+      prolog::Bindings toBindings(TermFactory& factory) const;
+      
+      /** \brief Convert these SWI-Prolog bindings to some lazy Prolog
+        *   bindings
+        * 
+        * The bound terms are recorded in the SWI-Prolog database, which
+        * is cheaper than building Prolog terms, and each of them is only
+        * converted when it is first accessed. Conversion requires the
+        * calling thread to have a SWI-Prolog engine attached.
+        */
+      prolog::Bindings toLazyBindings() const;
+      
+      /** \brief Capture these SWI-Prolog bindings in a Prolog bindings
+        *   snapshot
+        * 
+        * The snapshot is written directly from the SWI-Prolog terms and
+        * may be decoded by a thread which has no engine attached.
+        */
+      BindingsSnapshot toSnapshot() const;
+      
+      /** \brief Write these SWI-Prolog bindings to a Prolog bindings
+        *   writer
+        * 
+        * The SWI-Prolog terms are walked directly, such that the writer
+        * receives the bindings without any Prolog terms being built.
+        */
+      void write(BindingsWriter& writer) const;
+      
     protected:
       friend class Query;
       
+      /** \brief SWI-Prolog bindings snapshot which materializes the
+        *   recorded terms of lazy Prolog bindings
+        */
+      class Snapshot :
+        public prolog::Bindings::Materializer {
+      public:
+        Snapshot(const std::vector<Term>& terms);
+        ~Snapshot();
+        
+        bool isBound(size_t slot) const;
+        prolog::Term materialize(size_t slot) const;
+        
+        std::vector<void*> records_;
+      };
+      
       /** \brief SWI-Prolog bindings (implementation)
         */  
       class Impl {
@@ -80,7 +144,11 @@ namespace prolog {
         
         operator prolog::Bindings() const;
         
-        boost::unordered_map<std::string, Term> terms_;
+        prolog::Bindings convert(TermArena* arena, TermFactory* factory)
+          const;
+        
+        BindingsSchema schema_;
+        std::vector<Term> terms_;
       };
       
       /** \brief The SWI-Prolog bindings' implementation
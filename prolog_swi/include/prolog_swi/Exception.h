@@ -53,6 +53,7 @@ namespace prolog {
       void raise();
       
     private:
+      friend class PreparedQuery;
       friend class Query;
       friend class Term;
       
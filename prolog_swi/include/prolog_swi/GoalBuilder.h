@@ -0,0 +1,120 @@
+/******************************************************************************
+ * Copyright (C) 2016 by Ralf Kaestner                                        *
+ * ralf.kaestner@gmail.com                                                    *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the               *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+/** \file GoalBuilder.h
+  * \brief Header file providing the example GoalBuilder class interface
+  */
+
+#ifndef ROS_PROLOG_SWI_GOAL_BUILDER_H
+#define ROS_PROLOG_SWI_GOAL_BUILDER_H
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/unordered_map.hpp>
+
+#include <prolog_common/Term.h>
+
+#include <prolog_swi/Term.h>
+
+namespace prolog {
+  namespace swi {
+    /** \brief SWI-Prolog goal builder
+      * 
+      * The SWI-Prolog goal builder materializes a Prolog goal expression
+      * directly into SWI-Prolog term references, without building an
+      * intermediate Prolog term. Conjunctions and disjunctions are built
+      * from the control constructs ,/2 and ;/2, and Prolog variables
+      * which are put to the builder by the same name share a single
+      * SWI-Prolog variable.
+      * 
+      * The term references are allocated in the current foreign frame
+      * of the calling thread, which must thus be attached to an engine.
+      * A goal builder may be passed to an SWI-Prolog query which calls
+      * the built goal and binds the variables put to the builder.
+      */
+    class GoalBuilder {
+    public:
+      /** \brief Default constructor
+        */
+      GoalBuilder();
+      
+      /** \brief Copy constructor
+        */
+      GoalBuilder(const GoalBuilder& src);
+      
+      /** \brief Destructor
+        */
+      virtual ~GoalBuilder();
+      
+      /** \brief Retrieve the goal built by this SWI-Prolog goal builder
+        */
+      Term getGoal() const;
+      
+      /** \brief Put a Prolog term to this SWI-Prolog goal builder
+        */
+      void putTerm(const prolog::Term& term);
+      
+      /** \brief Put a Prolog compound to this SWI-Prolog goal builder,
+        *   taking its arguments from the previously put terms
+        * 
+        * A compound with zero arity is built as an atom.
+        */
+      void putCompound(const std::string& functor, size_t arity);
+      
+      /** \brief Put a Prolog conjunction to this SWI-Prolog goal
+        *   builder, taking its conjuncts from the previously put terms
+        */
+      void putConjunction(size_t numConjuncts);
+      
+      /** \brief Put a Prolog disjunction to this SWI-Prolog goal
+        *   builder, taking its disjuncts from the previously put terms
+        */
+      void putDisjunction(size_t numDisjuncts);
+      
+      /** \brief Clear this SWI-Prolog goal builder
+        */
+      void clear();
+      
+    protected:
+      friend class Query;
+      
+      /** \brief SWI-Prolog goal builder (implementation)
+        */
+      class Impl {
+      public:
+        Impl();
+        virtual ~Impl();
+        
+        void putCompound(const std::string& functor, size_t arity);
+        
+        std::vector<unsigned long> handles_;
+        std::vector<std::pair<prolog::Term, unsigned long> > terms_;
+        boost::unordered_map<std::string, unsigned long> variables_;
+      };
+      
+      /** \brief The SWI-Prolog goal builder's implementation
+        */
+      boost::shared_ptr<Impl> impl_;
+    };
+  };
+};
+
+#endif
@@ -0,0 +1,122 @@
+/******************************************************************************
+ * Copyright (C) 2016 by Ralf Kaestner                                        *
+ * ralf.kaestner@gmail.com                                                    *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the               *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+/** \file GoalCache.h
+  * \brief Header file providing the example GoalCache class interface
+  */
+
+#ifndef ROS_PROLOG_SWI_GOAL_CACHE_H
+#define ROS_PROLOG_SWI_GOAL_CACHE_H
+
+#include <string>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/unordered_map.hpp>
+
+#include <prolog_common/Symbol.h>
+#include <prolog_common/Term.h>
+
+namespace prolog {
+  namespace swi {
+    /** \brief SWI-Prolog goal cache
+      * 
+      * The goal cache stores the goals of textual SWI-Prolog queries
+      * after they have been parsed, keyed by module and goal text. Each
+      * cached goal holds a recorded term template, the mapping of its
+      * variables to their names in the goal text, and the resolved
+      * module and predicate handles. Opening a query for a cached goal
+      * therefore neither parses the goal nor resolves the predicate.
+      * 
+      * Since SWI-Prolog records and predicate handles are valid in all
+      * engines, the goal cache is process-wide and thread-safe. The
+      * least recently used goals are evicted once the capacity of the
+      * cache has been reached. Clear the cache after changing operator
+      * definitions which affect the parsing of cached goals.
+      */
+    class GoalCache {
+    public:
+      /** \brief Set the capacity of the SWI-Prolog goal cache
+        */
+      static void setCapacity(size_t capacity);
+      
+      /** \brief Retrieve the capacity of the SWI-Prolog goal cache
+        */
+      static size_t getCapacity();
+      
+      /** \brief Retrieve the number of goals in the SWI-Prolog goal
+        *   cache
+        */
+      static size_t getNumGoals();
+      
+      /** \brief Retrieve the number of lookups which have been served
+        *   by the SWI-Prolog goal cache
+        */
+      static size_t getNumHits();
+      
+      /** \brief Retrieve the number of lookups which have missed the
+        *   SWI-Prolog goal cache
+        */
+      static size_t getNumMisses();
+      
+      /** \brief Clear the SWI-Prolog goal cache and reset its counters
+        */
+      static void clear();
+      
+    protected:
+      friend class Query;
+      
+      /** \brief SWI-Prolog cached goal
+        */
+      class Goal {
+      public:
+        Goal(void* record, const prolog::Term& term, const
+          boost::unordered_map<std::string, Symbol>& mappings, void*
+          moduleHandle, void* predicateHandle);
+        ~Goal();
+        
+        void* record_;
+        prolog::Term term_;
+        boost::unordered_map<std::string, Symbol> mappings_;
+        
+        void* moduleHandle_;
+        void* predicateHandle_;
+      };
+      
+      /** \brief Look up a goal in the SWI-Prolog goal cache
+        */
+      static boost::shared_ptr<const Goal> lookup(const std::string&
+        module, const std::string& goal);
+      
+      /** \brief Insert a goal into the SWI-Prolog goal cache
+        */
+      static void insert(const std::string& module, const std::string&
+        goal, const boost::shared_ptr<const Goal>& cachedGoal);
+      
+    private:
+      /** \brief SWI-Prolog goal cache (implementation)
+        */
+      class Impl;
+      
+      /** \brief Retrieve the process-wide goal cache implementation
+        */
+      static Impl& getImpl();
+    };
+  };
+};
+
+#endif
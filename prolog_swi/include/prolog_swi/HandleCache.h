@@ -0,0 +1,110 @@
+/******************************************************************************
+ * Copyright (C) 2016 by Ralf Kaestner                                        *
+ * ralf.kaestner@gmail.com                                                    *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the               *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+/** \file HandleCache.h
+  * \brief Header file providing the example HandleCache class interface
+  */
+
+#ifndef ROS_PROLOG_SWI_HANDLE_CACHE_H
+#define ROS_PROLOG_SWI_HANDLE_CACHE_H
+
+#include <string>
+
+namespace prolog {
+  namespace swi {
+    /** \brief SWI-Prolog handle cache
+      * 
+      * The handle cache resolves SWI-Prolog atom, functor, module, and
+      * predicate handles once and serves them by the identifiers of
+      * the interned symbols in the Prolog symbol table. Each cached atom
+      * holds a registered reference which is released when the cache
+      * is cleared, so atoms should only be cached for the names of
+      * functors, modules, and predicates. Atoms occurring as data are
+      * put without the cache and remain subject to atom garbage
+      * collection. Functor, module, and predicate handles are permanent
+      * in SWI-Prolog and valid in all engines, such that the handle
+      * cache is process-wide and thread-safe.
+      */
+    class HandleCache {
+    public:
+      /** \brief Retrieve the SWI-Prolog atom handle of an interned atom
+        */
+      static unsigned long getAtom(size_t atom);
+      
+      /** \brief Retrieve the SWI-Prolog atom handle of an atom name
+        *   (overloaded version interning the name)
+        */
+      static unsigned long getAtom(const std::string& name);
+      
+      /** \brief Retrieve the SWI-Prolog functor handle of an interned
+        *   functor
+        */
+      static unsigned long getFunctor(size_t functor);
+      
+      /** \brief Retrieve the SWI-Prolog functor handle of a functor
+        *   name/arity pair (overloaded version interning the functor)
+        */
+      static unsigned long getFunctor(const std::string& name, size_t
+        arity);
+      
+      /** \brief Retrieve the SWI-Prolog module handle of a module name
+        */
+      static void* getModule(const std::string& name);
+      
+      /** \brief Retrieve the SWI-Prolog predicate handle of a predicate
+        *   name/arity pair defined in a module
+        */
+      static void* getPredicate(const std::string& module, const
+        std::string& name, size_t arity);
+      
+      /** \brief Retrieve the number of atoms in the SWI-Prolog handle
+        *   cache
+        */
+      static size_t getNumAtoms();
+      
+      /** \brief Retrieve the number of functors in the SWI-Prolog handle
+        *   cache
+        */
+      static size_t getNumFunctors();
+      
+      /** \brief Retrieve the number of predicates in the SWI-Prolog
+        *   handle cache
+        */
+      static size_t getNumPredicates();
+      
+      /** \brief Clear the SWI-Prolog handle cache and unregister its
+        *   atoms
+        * 
+        * Atom handles retrieved from the cache before must not be used
+        * after clearing unless they are otherwise referenced.
+        */
+      static void clear();
+      
+    private:
+      /** \brief SWI-Prolog handle cache (implementation)
+        */
+      class Impl;
+      
+      /** \brief Retrieve the process-wide handle cache implementation
+        */
+      static Impl& getImpl();
+    };
+  };
+};
+
+#endif
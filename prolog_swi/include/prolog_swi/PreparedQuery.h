@@ -0,0 +1,226 @@
+/******************************************************************************
+ * Copyright (C) 2016 by Ralf Kaestner                                        *
+ * ralf.kaestner@gmail.com                                                    *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the               *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+/** \file PreparedQuery.h
+  * \brief Header file providing the PreparedQuery class interface
+  */
+
+#ifndef ROS_PROLOG_SWI_PREPARED_QUERY_H
+#define ROS_PROLOG_SWI_PREPARED_QUERY_H
+
+#include <string>
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/unordered_map.hpp>
+
+#include <ros/exception.h>
+
+#include <prolog_common/Query.h>
+#include <prolog_common/Symbol.h>
+#include <prolog_common/Term.h>
+
+#include <prolog_swi/Query.h>
+
+namespace prolog {
+  namespace swi {
+    /** \brief SWI-Prolog prepared query
+      * 
+      * A prepared query is compiled once for a goal whose parameters
+      * are placeholder variables among the top-level arguments. The
+      * compiled goal is recorded in the SWI-Prolog database, and the
+      * values bound to the parameters are put directly into the
+      * preallocated argument term references. Re-executing a prepared
+      * query therefore neither parses nor rebuilds its goal.
+      */  
+    class PreparedQuery :
+      public Query {
+    public:
+      /** \brief Exception thrown in case of a failure to prepare a
+        *   SWI-Prolog prepared query
+        */ 
+      class PreparationError :
+        public ros::Exception {
+      public:
+        PreparationError(const std::string& description);
+      };
+      
+      /** \brief Default constructor
+        */
+      PreparedQuery();
+      
+      /** \brief Constructor (overloaded version taking a goal term in
+        *   Prolog syntax and the names of the parameter variables among
+        *   its arguments)
+        * 
+        * The goal is parsed once, when the prepared query is compiled.
+        */
+      PreparedQuery(const std::string& goal, const std::vector<
+        std::string>& parameters);
+      
+      /** \brief Constructor (overloaded version taking a predicate,
+        *   a vector of term arguments, and the names of the parameter
+        *   variables among these arguments)
+        */
+      PreparedQuery(const std::string& predicate, const std::vector<
+        prolog::Term>& arguments, const std::vector<std::string>&
+        parameters);
+      
+      /** \brief Constructor (overloaded version taking a module, a
+        *   predicate, a vector of term arguments, and the names of the
+        *   parameter variables among these arguments)
+        */
+      PreparedQuery(const std::string& module, const std::string&
+        predicate, const std::vector<prolog::Term>& arguments, const
+        std::vector<std::string>& parameters);
+      
+      /** \brief Constructor (overloaded version taking a Prolog query
+        *   and the names of the parameter variables among its arguments)
+        */
+      PreparedQuery(const prolog::Query& query, const std::vector<
+        std::string>& parameters);
+      
+      /** \brief Constructor (overloaded version taking a prepared query
+        *   whose compiled goal is shared and the values to be bound to
+        *   its parameters)
+        * 
+        * The constructed prepared query owns its own argument term
+        * references and may thus be executed on a different SWI-Prolog
+        * engine than the source query.
+        */
+      PreparedQuery(const PreparedQuery& src, const std::vector<
+        prolog::Term>& values);
+      
+      /** \brief Copy constructor
+        */
+      PreparedQuery(const PreparedQuery& src);
+      
+      /** \brief Destructor
+        */
+      virtual ~PreparedQuery();
+    
+      /** \brief Retrieve the number of parameters of this SWI-Prolog
+        *   prepared query
+        */
+      size_t getNumParameters() const;
+      
+      /** \brief Retrieve the names of the parameters of this SWI-Prolog
+        *   prepared query
+        */
+      std::vector<std::string> getParameters() const;
+      
+      /** \brief True, if the argument term references of this SWI-Prolog
+        *   prepared query have been allocated
+        */
+      bool isPrepared() const;
+      
+      /** \brief Prepare this SWI-Prolog prepared query
+        * 
+        * Preparing allocates the argument term references of the query
+        * in the current foreign frame. The goal is compiled and recorded
+        * the first time any query sharing it is prepared.
+        */
+      bool prepare();
+      
+      /** \brief Bind a value to a parameter of this SWI-Prolog prepared
+        *   query
+        */
+      void bind(size_t index, const prolog::Term& value);
+      
+      /** \brief Bind a value to a parameter of this SWI-Prolog prepared
+        *   query (overloaded version taking the parameter's name)
+        */
+      void bind(const std::string& parameter, const prolog::Term& value);
+      
+      /** \brief Bind values to all parameters of this SWI-Prolog prepared
+        *   query
+        */
+      void bind(const std::vector<prolog::Term>& values);
+      
+      /** \brief Execute this SWI-Prolog prepared query with the values
+        *   currently bound to its parameters
+        */
+      bool execute();
+      
+      /** \brief Execute this SWI-Prolog prepared query (overloaded version
+        *   binding the provided values to its parameters first)
+        */
+      bool execute(const std::vector<prolog::Term>& values);
+      
+    protected:
+      /** \brief SWI-Prolog prepared query goal
+        * 
+        * The goal is shared among all prepared queries constructed from
+        * the same source query.
+        */
+      class Goal {
+      public:
+        Goal(const std::string& module, const std::string& text, const
+          std::vector<std::string>& parameters);
+        Goal(const std::string& module, const std::string& predicate,
+          const std::vector<prolog::Term>& arguments, const
+          std::vector<std::string>& parameters);
+        ~Goal();
+        
+        void index(const boost::unordered_map<std::string, std::string>&
+          variables);
+        
+        std::string module_;
+        std::string text_;
+        std::string predicate_;
+        std::vector<prolog::Term> arguments_;
+        std::vector<std::string> parameters_;
+        std::vector<std::vector<size_t> > indices_;
+        boost::unordered_map<std::string, Symbol> mappings_;
+        
+        void* moduleHandle_;
+        void* predicateHandle_;
+        void* record_;
+        
+        boost::mutex mutex_;
+      };
+      
+      /** \brief SWI-Prolog prepared query (implementation)
+        */
+      class Impl :
+        public Query::Impl {
+      public:
+        Impl(const boost::shared_ptr<Goal>& goal);
+        Impl(const Impl& src, const std::vector<prolog::Term>& values);
+        virtual ~Impl();
+        
+        bool prepare();
+        void compile();
+        void parse();
+        void bind(size_t index, const prolog::Term& value);
+        void put(size_t index);
+        bool open();
+        
+        boost::shared_ptr<Goal> goal_;
+        std::vector<prolog::Term> values_;
+      };
+      
+      /** \brief Retrieve the SWI-Prolog prepared query's implementation
+        */
+      Impl* getImpl() const;
+    };
+  };
+};
+
+#endif
@@ -28,12 +28,19 @@
 #include <vector>
 
 #include <boost/shared_ptr.hpp>
+#include <boost/unordered_map.hpp>
 
 #include <prolog_common/Bindings.h>
+#include <prolog_common/BindingsSnapshot.h>
 #include <prolog_common/Query.h>
+#include <prolog_common/Symbol.h>
 #include <prolog_common/Term.h>
+#include <prolog_common/TermArena.h>
+#include <prolog_common/TermFactory.h>
 
 #include <prolog_swi/Bindings.h>
+#include <prolog_swi/Frame.h>
+#include <prolog_swi/GoalBuilder.h>
 
 namespace prolog {
   namespace swi {
@@ -78,6 +85,14 @@ namespace prolog {
         */
       Query(const prolog::Query& query);
       
+      /** \brief Constructor (overloaded version taking an SWI-Prolog
+        *   goal builder which holds the goal to be called)
+        * 
+        * The variables put to the goal builder are bound in the
+        * solutions of the query.
+        */
+      Query(const GoalBuilder& goal);
+      
       /** \brief Copy constructor
         */
       Query(const Query& src);
@@ -98,6 +113,40 @@ namespace prolog {
         */
       bool isValid() const;
       
+      /** \brief Set the lazy bindings mode of this SWI-Prolog query
+        * 
+        * In lazy bindings mode, each solution of the query is recorded
+        * in the SWI-Prolog database, and its bound terms are converted
+        * only when they are first accessed. Lazy bindings must be
+        * accessed by a thread which has a SWI-Prolog engine attached.
+        * The mode applies to solutions which are not built into a term
+        * arena or through a term factory.
+        */
+      void setLazyBindings(bool lazy);
+      
+      /** \brief True, if this SWI-Prolog query is in lazy bindings mode
+        */
+      bool hasLazyBindings() const;
+      
+      /** \brief Set the local stack monitoring mode of this SWI-Prolog
+        *   query
+        * 
+        * When monitored, the local stack usage of the calling engine is
+        * sampled after each solution has been extracted, and before the
+        * solution's term references are discarded.
+        */
+      void setLocalStackMonitoring(bool monitor);
+      
+      /** \brief True, if the local stack usage of this SWI-Prolog query
+        *   is monitored
+        */
+      bool isLocalStackMonitored() const;
+      
+      /** \brief Retrieve the high-water mark of the local stack usage
+        *   in bytes sampled since this SWI-Prolog query was opened
+        */
+      size_t getLocalStackHighWaterMark() const;
+      
       /** \brief Open this SWI-Prolog query
         */
       bool open();
@@ -106,6 +155,36 @@ namespace prolog {
         */
       bool nextSolution(prolog::Bindings& bindings);
       
+      /** \brief Generate the next solution of this SWI-Prolog query
+        *   (overloaded version building the solution into a Prolog term
+        *   arena)
+        */
+      bool nextSolution(prolog::Bindings& bindings, TermArena& arena);
+      
+      /** \brief Generate the next solution of this SWI-Prolog query
+        *   (overloaded version building the solution through a
+        *   hash-consing Prolog term factory)
+        */
+      bool nextSolution(prolog::Bindings& bindings, TermFactory& factory);
+      
+      /** \brief Generate the next solution of this SWI-Prolog query
+        *   (overloaded version capturing the solution in a Prolog
+        *   bindings snapshot)
+        * 
+        * The snapshot may be decoded after the engine has moved on,
+        * without holding any engine.
+        */
+      bool nextSolution(BindingsSnapshot& snapshot);
+      
+      /** \brief Generate the next solution of this SWI-Prolog query
+        *   (overloaded version writing the solution to a Prolog bindings
+        *   writer)
+        * 
+        * The solution is written directly from the SWI-Prolog terms,
+        * without building any Prolog terms.
+        */
+      bool nextSolution(BindingsWriter& writer);
+      
       /** \brief Cut this SWI-Prolog query
         */
       void cut();
@@ -121,15 +200,22 @@ namespace prolog {
       public:
         Impl(const std::string& module, const std::string& predicate,
           const std::vector<prolog::Term>& arguments);
+        Impl(const std::string& module, const GoalBuilder& goal);
         virtual ~Impl();
         
-        bool open();
-        bool nextSolution(prolog::Bindings& bindings);
+        virtual bool open();
+        bool nextSolution(prolog::Bindings& bindings, TermArena* arena,
+          TermFactory* factory);
+        bool nextSolution(BindingsSnapshot& snapshot);
+        bool nextSolution(BindingsWriter& writer);
+        bool next();
+        void beginSolution();
+        void endSolution();
         void cut();
         void close();
         
         void generateBindings(const prolog::Term& argument, unsigned long
-          handle, const boost::unordered_map<std::string, std::string>&
+          handle, const boost::unordered_map<std::string, Symbol>&
           mappings);
 
         std::string module_;
@@ -142,6 +228,11 @@ namespace prolog {
         unsigned long argumentsHandle_;
         
         unsigned long handle_;
+        Frame solutionFrame_;
+        
+        bool lazy_;
+        bool monitorLocalStack_;
+        size_t localStackHighWaterMark_;
       };
       
       /** \brief The SWI-Prolog query's implementation
@@ -23,11 +23,18 @@
 #ifndef ROS_PROLOG_SWI_TERM_H
 #define ROS_PROLOG_SWI_TERM_H
 
+#include <vector>
+
 #include <boost/shared_ptr.hpp>
+#include <boost/unordered_map.hpp>
 
 #include <ros/exception.h>
 
+#include <prolog_common/BindingsWriter.h>
 #include <prolog_common/Term.h>
+#include <prolog_common/TermArena.h>
+#include <prolog_common/TermFactory.h>
+#include <prolog_common/TermVisitor.h>
 
 namespace prolog {
   namespace swi {
@@ -69,8 +76,20 @@ namespace prolog {
         */
       operator prolog::Term() const;
       
+      /** \brief Convert this SWI-Prolog term to a Prolog term which is
+        *   built into a Prolog term arena
+        */
+      prolog::Term toTerm(TermArena& arena) const;
+      
+      /** \brief Convert this SWI-Prolog term to a Prolog term which is
+        *   built through a hash-consing Prolog term factory
+        */
+      prolog::Term toTerm(TermFactory& factory) const;
+      
     protected:
       friend class Bindings;
+      friend class GoalBuilder;
+      friend class PreparedQuery;
       friend class Query;
       
       /** \brief SWI-Prolog term (implementation)
@@ -84,7 +103,57 @@ namespace prolog {
         
         operator prolog::Term() const;
         
+        prolog::Term convert(TermArena* arena, TermFactory* factory) const;
+        static prolog::Term convertAtomic(unsigned long handle, TermArena*
+          arena);
+        void write(BindingsWriter& writer) const;
+        static void writeAtomic(unsigned long handle, BindingsWriter&
+          writer);
+        
         unsigned long handle_;
+        
+        /** \brief Compound term or list being converted or written
+          * 
+          * The term references are reused by all frames at the same
+          * depth and hold the remaining list or the compound, the
+          * current element or argument, and the tail of a partial list.
+          */
+        struct Frame {
+          unsigned long refs_;
+          bool list_;
+          bool partial_;
+          unsigned long functor_;
+          size_t arity_;
+          size_t index_;
+          size_t offset_;
+        };
+      };
+      
+      /** \brief Prolog term visitor converting the terms visited by a
+        *   Prolog term walker to SWI-Prolog terms
+        */
+      class Converter :
+        public TermVisitor {
+      public:
+        Converter();
+        
+        void visitAtom(const Atom& atom);
+        void visitCompound(const Compound& compound);
+        void visitFloat(const Float& number);
+        void visitInteger(const Integer& number);
+        void visitList(const List& list);
+        void visitString(const String& string);
+        void visitVariable(const Variable& variable);
+        void leaveCompound(const Compound& compound);
+        void leaveList(const List& list);
+        
+        unsigned long push();
+        unsigned long getFunctor(size_t functor);
+        
+        std::vector<unsigned long> handles_;
+        std::vector<size_t> offsets_;
+        
+        boost::unordered_map<size_t, unsigned long> functors_;
       };
       
       /** \brief Constructor (overloaded version taking a handle)
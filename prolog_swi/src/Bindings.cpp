@@ -18,6 +18,8 @@
 
 #include <SWI-Prolog.h>
 
+#include <prolog_swi/Context.h>
+
 #include "prolog_swi/Bindings.h"
 
 namespace prolog { namespace swi {
@@ -40,6 +42,25 @@ Bindings::~Bindings() {
 Bindings::Impl::Impl() {
 }
 
+Bindings::Snapshot::Snapshot(const std::vector<Term>& terms) :
+  records_(terms.size(), 0) {
+  for (size_t slot = 0; slot < terms.size(); ++slot) {
+    if (terms[slot].isValid()) {
+      records_[slot] = PL_record(terms[slot].impl_->handle_);
+      
+      if (!records_[slot])
+        throw Context::ResourceError();
+    }
+  }
+}
+
+Bindings::Snapshot::~Snapshot() {
+  for (std::vector<void*>::const_iterator it = records_.begin();
+      it != records_.end(); ++it)
+    if (*it)
+      PL_erase(*it);
+}
+
 Bindings::Impl::~Impl() {
 }
 
@@ -48,7 +69,16 @@ Bindings::Impl::~Impl() {
 /*****************************************************************************/
 
 bool Bindings::areEmpty() const {
-  return impl_->terms_.empty();
+  for (std::vector<Term>::const_iterator it = impl_->terms_.begin();
+      it != impl_->terms_.end(); ++it)
+    if (it->isValid())
+      return false;
+    
+  return true;
+}
+
+bool Bindings::Snapshot::isBound(size_t slot) const {
+  return (slot < records_.size()) && records_[slot];
 }
 
 /*****************************************************************************/
@@ -56,11 +86,93 @@ bool Bindings::areEmpty() const {
 /*****************************************************************************/
 
 void Bindings::addTerm(const std::string& name, const Term& term) {
-  impl_->terms_.insert(std::make_pair(name, term));
+  addTerm(Symbol(name), term);
+}
+
+void Bindings::addTerm(const Symbol& name, const Term& term) {
+  size_t slot = impl_->schema_.addSymbol(name);
+  
+  if (slot >= impl_->terms_.size())
+    impl_->terms_.resize(impl_->schema_.getNumSlots());
+  
+  if (!impl_->terms_[slot].isValid())
+    impl_->terms_[slot] = term;
 }
 
 void Bindings::clear() {
-  impl_->terms_.clear();
+  impl_->terms_.assign(impl_->terms_.size(), Term());
+}
+
+prolog::Bindings Bindings::toBindings(TermArena& arena) const {
+  return impl_->convert(&arena, 0);
+}
+
+prolog::Bindings Bindings::toBindings(TermFactory& factory) const {
+  return impl_->convert(0, &factory);
+}
+
+prolog::Bindings Bindings::toLazyBindings() const {
+  return prolog::Bindings(impl_->schema_, boost::shared_ptr<const
+    prolog::Bindings::Materializer>(new Snapshot(impl_->terms_)));
+}
+
+BindingsSnapshot Bindings::toSnapshot() const {
+  BindingsSnapshot snapshot;
+  
+  write(snapshot);
+  
+  return snapshot;
+}
+
+void Bindings::write(BindingsWriter& writer) const {
+  writer.beginBindings(impl_->schema_);
+  
+  for (size_t slot = 0; slot < impl_->schema_.getNumSlots(); ++slot) {
+    if ((slot < impl_->terms_.size()) && impl_->terms_[slot].isValid())
+      impl_->terms_[slot].impl_->write(writer);
+    else
+      writer.putUnbound();
+  }
+  
+  writer.endBindings();
+}
+
+prolog::Term Bindings::Snapshot::materialize(size_t slot) const {
+  BOOST_ASSERT(isBound(slot));
+  
+  fid_t frame = PL_open_foreign_frame();
+  
+  if (!frame)
+    throw Context::ResourceError();
+  
+  term_t handle = PL_new_term_ref();
+  prolog::Term term;
+  
+  if (PL_recorded(records_[slot], handle))
+    term = Term(handle);
+  
+  PL_discard_foreign_frame(frame);
+  
+  if (!term.isValid())
+    throw Context::ResourceError();
+  
+  return term;
+}
+
+prolog::Bindings Bindings::Impl::convert(TermArena* arena, TermFactory*
+    factory) const {
+  prolog::Bindings bindings = arena ? prolog::Bindings(schema_, *arena) :
+    prolog::Bindings(schema_);
+  
+  for (size_t slot = 0; slot < terms_.size(); ++slot) {
+    const Term& term = terms_[slot];
+    
+    if (term.isValid())
+      bindings.setTerm(slot, arena ? term.toTerm(*arena) : factory ?
+        term.toTerm(*factory) : prolog::Term(term));
+  }
+  
+  return bindings;
 }
 
 /*****************************************************************************/
@@ -72,13 +184,7 @@ Bindings::operator prolog::Bindings() const {
 }
 
 Bindings::Impl::operator prolog::Bindings() const {
-  prolog::Bindings bindings;
-  
-  for (boost::unordered_map<std::string, Term>::const_iterator
-      it = terms_.begin(); it != terms_.end(); ++it)
-    bindings.addTerm(it->first, Term(it->second));
-  
-  return bindings;
+  return convert(0, 0);
 }
 
 }}
@@ -18,6 +18,8 @@
 
 #include <SWI-Prolog.h>
 
+#include <prolog_swi/HandleCache.h>
+
 #include "prolog_swi/Exception.h"
 
 namespace prolog { namespace swi {
@@ -61,15 +63,9 @@ std::string Exception::messageToString(unsigned long handle) {
       term_t args = PL_new_term_refs(2);
       PL_put_term(args+0, handle); 
       
-      atom_t moduleAtom = PL_new_atom("$messages");
-      atom_t predicateAtom = PL_new_atom("message_to_string");
-      
-      module_t module = PL_new_module(moduleAtom);
-      predicate_t predicate = PL_pred(PL_new_functor(predicateAtom, 2),
-        module);
-
-      PL_unregister_atom(moduleAtom);
-      PL_unregister_atom(predicateAtom);
+      module_t module = HandleCache::getModule("$messages");
+      predicate_t predicate = HandleCache::getPredicate("$messages",
+        "message_to_string", 2);
 
       qid_t query = PL_open_query(module, PL_Q_CATCH_EXCEPTION,
         predicate, args);
@@ -0,0 +1,152 @@
+/******************************************************************************
+ * Copyright (C) 2016 by Ralf Kaestner                                        *
+ * ralf.kaestner@gmail.com                                                    *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the               *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+#include <SWI-Prolog.h>
+
+#include <boost/assert.hpp>
+
+#include <prolog_common/Variable.h>
+
+#include <prolog_swi/Context.h>
+#include <prolog_swi/HandleCache.h>
+
+#include "prolog_swi/GoalBuilder.h"
+
+namespace prolog { namespace swi {
+
+/*****************************************************************************/
+/* Constructors and Destructor                                               */
+/*****************************************************************************/
+
+GoalBuilder::GoalBuilder() :
+  impl_(new Impl()) {
+}
+
+GoalBuilder::GoalBuilder(const GoalBuilder& src) :
+  impl_(src.impl_) {
+}
+
+GoalBuilder::~GoalBuilder() {
+}
+
+GoalBuilder::Impl::Impl() {
+}
+
+GoalBuilder::Impl::~Impl() {
+}
+
+/*****************************************************************************/
+/* Accessors                                                                 */
+/*****************************************************************************/
+
+Term GoalBuilder::getGoal() const {
+  if (!impl_->handles_.empty())
+    return Term(impl_->handles_.back());
+  else
+    return Term();
+}
+
+/*****************************************************************************/
+/* Methods                                                                   */
+/*****************************************************************************/
+
+void GoalBuilder::putTerm(const prolog::Term& term) {
+  if (term.isVariable()) {
+    const std::string& name = Variable(term).getName();
+    
+    if (name != "_") {
+      boost::unordered_map<std::string, unsigned long>::const_iterator
+        it = impl_->variables_.find(name);
+        
+      if (it != impl_->variables_.end()) {
+        impl_->handles_.push_back(it->second);
+        return;
+      }
+    }
+  }
+  
+  Term::Impl argument(term);
+  
+  if (term.isVariable())
+    impl_->variables_.insert(std::make_pair(Variable(term).getName(),
+      argument.handle_));
+  
+  impl_->handles_.push_back(argument.handle_);
+  impl_->terms_.push_back(std::make_pair(term, argument.handle_));
+}
+
+void GoalBuilder::putCompound(const std::string& functor, size_t arity) {
+  impl_->putCompound(functor, arity);
+}
+
+void GoalBuilder::putConjunction(size_t numConjuncts) {
+  BOOST_ASSERT(numConjuncts);
+  
+  for ( ; numConjuncts > 1; --numConjuncts)
+    impl_->putCompound(",", 2);
+}
+
+void GoalBuilder::putDisjunction(size_t numDisjuncts) {
+  BOOST_ASSERT(numDisjuncts);
+  
+  for ( ; numDisjuncts > 1; --numDisjuncts)
+    impl_->putCompound(";", 2);
+}
+
+void GoalBuilder::clear() {
+  impl_->handles_.clear();
+  impl_->terms_.clear();
+  impl_->variables_.clear();
+}
+
+void GoalBuilder::Impl::putCompound(const std::string& functor, size_t
+    arity) {
+  BOOST_ASSERT(handles_.size() >= arity);
+  
+  term_t handle = PL_new_term_ref();
+  
+  if (!handle)
+    throw Context::ResourceError();
+  
+  if (arity) {
+    functor_t functorHandle = HandleCache::getFunctor(functor, arity);
+    
+    term_t arguments = PL_new_term_refs(arity);
+    
+    if (!arguments)
+      throw Context::ResourceError();
+    
+    std::vector<unsigned long>::iterator begin = handles_.end()-arity;
+    
+    size_t index = 0;
+    for (std::vector<unsigned long>::const_iterator it = begin;
+        it != handles_.end(); ++it, ++index)
+      PL_put_term(arguments+index, *it);
+    
+    if (!PL_cons_functor_v(handle, functorHandle, arguments))
+      throw Context::ResourceError();
+    
+    handles_.erase(begin, handles_.end());
+  }
+  else if (!PL_put_atom(handle, HandleCache::getAtom(functor)))
+    throw Context::ResourceError();
+  
+  handles_.push_back(handle);
+}
+
+}}
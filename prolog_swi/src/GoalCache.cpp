@@ -0,0 +1,203 @@
+/******************************************************************************
+ * Copyright (C) 2016 by Ralf Kaestner                                        *
+ * ralf.kaestner@gmail.com                                                    *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the               *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+#include <list>
+#include <utility>
+
+#include <SWI-Prolog.h>
+
+#include <boost/thread/mutex.hpp>
+
+#include "prolog_swi/GoalCache.h"
+
+namespace prolog { namespace swi {
+
+/*****************************************************************************/
+/* Implementation                                                            */
+/*****************************************************************************/
+
+class GoalCache::Impl {
+public:
+  typedef std::pair<std::string, std::string> Key;
+  
+  struct Entry {
+    boost::shared_ptr<const Goal> goal_;
+    std::list<Key>::iterator usage_;
+  };
+  
+  Impl();
+  ~Impl();
+  
+  void evict();
+  
+  boost::mutex mutex_;
+  
+  boost::unordered_map<Key, Entry> entries_;
+  std::list<Key> usage_;
+  
+  size_t capacity_;
+  size_t numHits_;
+  size_t numMisses_;
+};
+
+/*****************************************************************************/
+/* Constructors and Destructor                                               */
+/*****************************************************************************/
+
+GoalCache::Impl::Impl() :
+  capacity_(1024),
+  numHits_(0),
+  numMisses_(0) {
+}
+
+GoalCache::Impl::~Impl() {
+}
+
+GoalCache::Goal::Goal(void* record, const prolog::Term& term, const
+    boost::unordered_map<std::string, Symbol>& mappings, void* moduleHandle,
+    void* predicateHandle) :
+  record_(record),
+  term_(term),
+  mappings_(mappings),
+  moduleHandle_(moduleHandle),
+  predicateHandle_(predicateHandle) {
+}
+
+GoalCache::Goal::~Goal() {
+  if (record_)
+    PL_erase(record_);
+}
+
+/*****************************************************************************/
+/* Accessors                                                                 */
+/*****************************************************************************/
+
+void GoalCache::setCapacity(size_t capacity) {
+  Impl& impl = getImpl();
+  boost::mutex::scoped_lock lock(impl.mutex_);
+  
+  impl.capacity_ = capacity;
+  impl.evict();
+}
+
+size_t GoalCache::getCapacity() {
+  Impl& impl = getImpl();
+  boost::mutex::scoped_lock lock(impl.mutex_);
+  
+  return impl.capacity_;
+}
+
+size_t GoalCache::getNumGoals() {
+  Impl& impl = getImpl();
+  boost::mutex::scoped_lock lock(impl.mutex_);
+  
+  return impl.entries_.size();
+}
+
+size_t GoalCache::getNumHits() {
+  Impl& impl = getImpl();
+  boost::mutex::scoped_lock lock(impl.mutex_);
+  
+  return impl.numHits_;
+}
+
+size_t GoalCache::getNumMisses() {
+  Impl& impl = getImpl();
+  boost::mutex::scoped_lock lock(impl.mutex_);
+  
+  return impl.numMisses_;
+}
+
+GoalCache::Impl& GoalCache::getImpl() {
+  static Impl* impl = new Impl();
+  
+  return *impl;
+}
+
+/*****************************************************************************/
+/* Methods                                                                   */
+/*****************************************************************************/
+
+void GoalCache::clear() {
+  Impl& impl = getImpl();
+  boost::mutex::scoped_lock lock(impl.mutex_);
+  
+  impl.entries_.clear();
+  impl.usage_.clear();
+  
+  impl.numHits_ = 0;
+  impl.numMisses_ = 0;
+}
+
+boost::shared_ptr<const GoalCache::Goal> GoalCache::lookup(const
+    std::string& module, const std::string& goal) {
+  Impl& impl = getImpl();
+  boost::mutex::scoped_lock lock(impl.mutex_);
+  
+  boost::unordered_map<Impl::Key, Impl::Entry>::iterator it =
+    impl.entries_.find(Impl::Key(module, goal));
+  
+  if (it != impl.entries_.end()) {
+    impl.usage_.splice(impl.usage_.begin(), impl.usage_, it->second.usage_);
+    ++impl.numHits_;
+    
+    return it->second.goal_;
+  }
+  
+  ++impl.numMisses_;
+  
+  return boost::shared_ptr<const Goal>();
+}
+
+void GoalCache::insert(const std::string& module, const std::string& goal,
+    const boost::shared_ptr<const Goal>& cachedGoal) {
+  Impl& impl = getImpl();
+  boost::mutex::scoped_lock lock(impl.mutex_);
+  
+  Impl::Key key(module, goal);
+  boost::unordered_map<Impl::Key, Impl::Entry>::iterator it =
+    impl.entries_.find(key);
+  
+  if (it == impl.entries_.end()) {
+    if (!impl.capacity_)
+      return;
+    
+    impl.usage_.push_front(key);
+    
+    Impl::Entry entry;
+    
+    entry.goal_ = cachedGoal;
+    entry.usage_ = impl.usage_.begin();
+    
+    impl.entries_.insert(std::make_pair(key, entry));
+    impl.evict();
+  }
+  else {
+    impl.usage_.splice(impl.usage_.begin(), impl.usage_, it->second.usage_);
+    it->second.goal_ = cachedGoal;
+  }
+}
+
+void GoalCache::Impl::evict() {
+  while (entries_.size() > capacity_) {
+    entries_.erase(usage_.back());
+    usage_.pop_back();
+  }
+}
+
+}}
@@ -0,0 +1,262 @@
+/******************************************************************************
+ * Copyright (C) 2016 by Ralf Kaestner                                        *
+ * ralf.kaestner@gmail.com                                                    *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the               *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+#include <utility>
+#include <vector>
+
+#include <SWI-Prolog.h>
+
+#include <boost/thread/locks.hpp>
+#include <boost/thread/shared_mutex.hpp>
+#include <boost/unordered_map.hpp>
+
+#include <prolog_common/SymbolTable.h>
+
+#include <prolog_swi/Context.h>
+
+#include "prolog_swi/HandleCache.h"
+
+namespace prolog { namespace swi {
+
+/*****************************************************************************/
+/* Implementation                                                            */
+/*****************************************************************************/
+
+class HandleCache::Impl {
+public:
+  typedef std::pair<size_t, size_t> PredicateKey;
+  
+  Impl();
+  ~Impl();
+  
+  boost::shared_mutex mutex_;
+  
+  std::vector<atom_t> atoms_;
+  std::vector<functor_t> functors_;
+  boost::unordered_map<size_t, module_t> modules_;
+  boost::unordered_map<PredicateKey, predicate_t> predicates_;
+  
+  size_t numAtoms_;
+  size_t numFunctors_;
+};
+
+/*****************************************************************************/
+/* Constructors and Destructor                                               */
+/*****************************************************************************/
+
+HandleCache::Impl::Impl() :
+  numAtoms_(0),
+  numFunctors_(0) {
+}
+
+HandleCache::Impl::~Impl() {
+}
+
+/*****************************************************************************/
+/* Accessors                                                                 */
+/*****************************************************************************/
+
+unsigned long HandleCache::getAtom(size_t atom) {
+  Impl& impl = getImpl();
+  
+  {
+    boost::shared_lock<boost::shared_mutex> lock(impl.mutex_);
+    
+    if ((atom < impl.atoms_.size()) && impl.atoms_[atom])
+      return impl.atoms_[atom];
+  }
+  
+  const std::string& name = SymbolTable::getAtomName(atom);
+  
+  boost::unique_lock<boost::shared_mutex> lock(impl.mutex_);
+  
+  if (atom >= impl.atoms_.size())
+    impl.atoms_.resize(atom+1, 0);
+  
+  if (!impl.atoms_[atom]) {
+    atom_t handle = PL_new_atom_nchars(name.length(), name.c_str());
+    
+    if (!handle)
+      throw Context::ResourceError();
+    
+    impl.atoms_[atom] = handle;
+    ++impl.numAtoms_;
+  }
+  
+  return impl.atoms_[atom];
+}
+
+unsigned long HandleCache::getAtom(const std::string& name) {
+  return getAtom(SymbolTable::internAtom(name));
+}
+
+unsigned long HandleCache::getFunctor(size_t functor) {
+  Impl& impl = getImpl();
+  
+  {
+    boost::shared_lock<boost::shared_mutex> lock(impl.mutex_);
+    
+    if ((functor < impl.functors_.size()) && impl.functors_[functor])
+      return impl.functors_[functor];
+  }
+  
+  atom_t name = getAtom(SymbolTable::getFunctorAtom(functor));
+  
+  boost::unique_lock<boost::shared_mutex> lock(impl.mutex_);
+  
+  if (functor >= impl.functors_.size())
+    impl.functors_.resize(functor+1, 0);
+  
+  if (!impl.functors_[functor]) {
+    functor_t handle = PL_new_functor(name,
+      SymbolTable::getFunctorArity(functor));
+    
+    if (!handle)
+      throw Context::ResourceError();
+    
+    impl.functors_[functor] = handle;
+    ++impl.numFunctors_;
+  }
+  
+  return impl.functors_[functor];
+}
+
+unsigned long HandleCache::getFunctor(const std::string& name, size_t
+    arity) {
+  return getFunctor(SymbolTable::internFunctor(name, arity));
+}
+
+void* HandleCache::getModule(const std::string& name) {
+  Impl& impl = getImpl();
+  size_t atom = SymbolTable::internAtom(!name.empty() ? name : "user");
+  
+  {
+    boost::shared_lock<boost::shared_mutex> lock(impl.mutex_);
+    
+    boost::unordered_map<size_t, module_t>::const_iterator it =
+      impl.modules_.find(atom);
+      
+    if (it != impl.modules_.end())
+      return it->second;
+  }
+  
+  atom_t handle = getAtom(atom);
+  
+  boost::unique_lock<boost::shared_mutex> lock(impl.mutex_);
+  
+  boost::unordered_map<size_t, module_t>::iterator it =
+    impl.modules_.find(atom);
+    
+  if (it == impl.modules_.end()) {
+    module_t module = PL_new_module(handle);
+    
+    if (!module)
+      throw Context::ResourceError();
+    
+    it = impl.modules_.insert(std::make_pair(atom, module)).first;
+  }
+  
+  return it->second;
+}
+
+void* HandleCache::getPredicate(const std::string& module, const
+    std::string& name, size_t arity) {
+  Impl& impl = getImpl();
+  Impl::PredicateKey key(SymbolTable::internAtom(!module.empty() ? module :
+    "user"), SymbolTable::internFunctor(name, arity));
+  
+  {
+    boost::shared_lock<boost::shared_mutex> lock(impl.mutex_);
+    
+    boost::unordered_map<Impl::PredicateKey, predicate_t>::const_iterator
+      it = impl.predicates_.find(key);
+      
+    if (it != impl.predicates_.end())
+      return it->second;
+  }
+  
+  module_t moduleHandle = getModule(module);
+  functor_t functorHandle = getFunctor(key.second);
+  
+  boost::unique_lock<boost::shared_mutex> lock(impl.mutex_);
+  
+  boost::unordered_map<Impl::PredicateKey, predicate_t>::iterator
+    it = impl.predicates_.find(key);
+    
+  if (it == impl.predicates_.end()) {
+    predicate_t predicate = PL_pred(functorHandle, moduleHandle);
+    
+    if (!predicate)
+      throw Context::ResourceError();
+    
+    it = impl.predicates_.insert(std::make_pair(key, predicate)).first;
+  }
+  
+  return it->second;
+}
+
+size_t HandleCache::getNumAtoms() {
+  Impl& impl = getImpl();
+  boost::shared_lock<boost::shared_mutex> lock(impl.mutex_);
+  
+  return impl.numAtoms_;
+}
+
+size_t HandleCache::getNumFunctors() {
+  Impl& impl = getImpl();
+  boost::shared_lock<boost::shared_mutex> lock(impl.mutex_);
+  
+  return impl.numFunctors_;
+}
+
+size_t HandleCache::getNumPredicates() {
+  Impl& impl = getImpl();
+  boost::shared_lock<boost::shared_mutex> lock(impl.mutex_);
+  
+  return impl.predicates_.size();
+}
+
+HandleCache::Impl& HandleCache::getImpl() {
+  static Impl* impl = new Impl();
+  
+  return *impl;
+}
+
+/*****************************************************************************/
+/* Methods                                                                   */
+/*****************************************************************************/
+
+void HandleCache::clear() {
+  Impl& impl = getImpl();
+  boost::unique_lock<boost::shared_mutex> lock(impl.mutex_);
+  
+  for (std::vector<atom_t>::const_iterator it = impl.atoms_.begin();
+      it != impl.atoms_.end(); ++it)
+    if (*it)
+      PL_unregister_atom(*it);
+  
+  impl.atoms_.clear();
+  impl.functors_.clear();
+  impl.modules_.clear();
+  impl.predicates_.clear();
+  
+  impl.numAtoms_ = 0;
+  impl.numFunctors_ = 0;
+}
+
+}}
@@ -0,0 +1,477 @@
+/******************************************************************************
+ * Copyright (C) 2016 by Ralf Kaestner                                        *
+ * ralf.kaestner@gmail.com                                                    *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the               *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+#include <SWI-Prolog.h>
+
+#include <algorithm>
+
+#include <boost/lexical_cast.hpp>
+
+#include <prolog_common/Atom.h>
+#include <prolog_common/Compound.h>
+#include <prolog_common/Float.h>
+#include <prolog_common/Integer.h>
+#include <prolog_common/List.h>
+#include <prolog_common/String.h>
+#include <prolog_common/SymbolTable.h>
+#include <prolog_common/Variable.h>
+
+#include <prolog_swi/Context.h>
+#include <prolog_swi/Exception.h>
+#include <prolog_swi/HandleCache.h>
+#include <prolog_swi/Term.h>
+
+#include "prolog_swi/PreparedQuery.h"
+
+namespace prolog { namespace swi {
+
+/*****************************************************************************/
+/* Constructors and Destructor                                               */
+/*****************************************************************************/
+
+PreparedQuery::PreparationError::PreparationError(const std::string&
+    description) :
+  ros::Exception("Failure to prepare query: "+description) {
+}
+
+PreparedQuery::PreparedQuery() {
+}
+
+PreparedQuery::PreparedQuery(const std::string& goal, const
+    std::vector<std::string>& parameters) {
+  impl_.reset(new Impl(boost::shared_ptr<Goal>(new Goal("user", goal,
+    parameters))));
+}
+
+PreparedQuery::PreparedQuery(const std::string& predicate, const
+    std::vector<prolog::Term>& arguments, const std::vector<std::string>&
+    parameters) {
+  impl_.reset(new Impl(boost::shared_ptr<Goal>(new Goal("user", predicate,
+    arguments, parameters))));
+}
+
+PreparedQuery::PreparedQuery(const std::string& module, const std::string&
+    predicate, const std::vector<prolog::Term>& arguments, const
+    std::vector<std::string>& parameters) {
+  impl_.reset(new Impl(boost::shared_ptr<Goal>(new Goal(module, predicate,
+    arguments, parameters))));
+}
+
+PreparedQuery::PreparedQuery(const prolog::Query& query, const
+    std::vector<std::string>& parameters) {
+  if (query.isValid())
+    impl_.reset(new Impl(boost::shared_ptr<Goal>(new Goal(
+      query.getModule(), query.getPredicate(), query.getArguments(),
+      parameters))));
+}
+
+PreparedQuery::PreparedQuery(const PreparedQuery& src, const std::vector<
+    prolog::Term>& values) {
+  if (src.impl_.get())
+    impl_.reset(new Impl(*src.getImpl(), values));
+}
+
+PreparedQuery::PreparedQuery(const PreparedQuery& src) :
+  Query(src) {
+}
+
+PreparedQuery::~PreparedQuery() {
+}
+
+PreparedQuery::Goal::Goal(const std::string& module, const std::string&
+    text, const std::vector<std::string>& parameters) :
+  module_(module),
+  text_(text),
+  parameters_(parameters),
+  moduleHandle_(0),
+  predicateHandle_(0),
+  record_(0) {
+  BOOST_ASSERT(!text.empty());
+}
+
+PreparedQuery::Goal::Goal(const std::string& module, const std::string&
+    predicate, const std::vector<prolog::Term>& arguments, const
+    std::vector<std::string>& parameters) :
+  module_(module),
+  predicate_(predicate),
+  arguments_(arguments),
+  parameters_(parameters),
+  moduleHandle_(0),
+  predicateHandle_(0),
+  record_(0) {
+  BOOST_ASSERT(!predicate.empty());
+  
+  boost::unordered_map<std::string, std::string> variables;
+  
+  for (std::vector<std::string>::const_iterator it = parameters.begin();
+      it != parameters.end(); ++it)
+    variables.insert(std::make_pair(*it, *it));
+  
+  index(variables);
+}
+
+PreparedQuery::Goal::~Goal() {
+  if (record_)
+    PL_erase(record_);
+}
+
+PreparedQuery::Impl::Impl(const boost::shared_ptr<Goal>& goal) :
+  Query::Impl(goal->module_, goal->text_.empty() ? goal->predicate_ :
+    std::string("call"), goal->arguments_),
+  goal_(goal),
+  values_(goal->parameters_.size()) {
+}
+
+PreparedQuery::Impl::Impl(const Impl& src, const std::vector<prolog::Term>&
+    values) :
+  Query::Impl(src.module_, src.predicate_, src.arguments_),
+  goal_(src.goal_),
+  values_(src.values_) {
+  if (values.size() > values_.size())
+    throw PreparationError("Too many parameter values.");
+  
+  std::copy(values.begin(), values.end(), values_.begin());
+}
+
+PreparedQuery::Impl::~Impl() {
+}
+
+/*****************************************************************************/
+/* Accessors                                                                 */
+/*****************************************************************************/
+
+size_t PreparedQuery::getNumParameters() const {
+  if (impl_.get())
+    return getImpl()->values_.size();
+  else
+    return 0;
+}
+
+std::vector<std::string> PreparedQuery::getParameters() const {
+  if (impl_.get())
+    return getImpl()->goal_->parameters_;
+  else
+    return std::vector<std::string>();
+}
+
+bool PreparedQuery::isPrepared() const {
+  if (impl_.get())
+    return impl_->argumentsHandle_;
+  else
+    return false;
+}
+
+PreparedQuery::Impl* PreparedQuery::getImpl() const {
+  return static_cast<Impl*>(impl_.get());
+}
+
+/*****************************************************************************/
+/* Methods                                                                   */
+/*****************************************************************************/
+
+bool PreparedQuery::prepare() {
+  if (impl_.get())
+    return getImpl()->prepare();
+  else
+    return false;
+}
+
+void PreparedQuery::bind(size_t index, const prolog::Term& value) {
+  if (impl_.get())
+    getImpl()->bind(index, value);
+}
+
+void PreparedQuery::bind(const std::string& parameter, const prolog::Term&
+    value) {
+  if (impl_.get()) {
+    const std::vector<std::string>& parameters = getImpl()->goal_->
+      parameters_;
+    std::vector<std::string>::const_iterator it = std::find(
+      parameters.begin(), parameters.end(), parameter);
+    
+    if (it == parameters.end())
+      throw PreparationError("Parameter ["+parameter+"] is undefined.");
+    
+    getImpl()->bind(it-parameters.begin(), value);
+  }
+}
+
+void PreparedQuery::bind(const std::vector<prolog::Term>& values) {
+  if (impl_.get()) {
+    if (values.size() != getImpl()->values_.size())
+      throw PreparationError("Number of parameter values does not match.");
+    
+    for (size_t index = 0; index < values.size(); ++index)
+      getImpl()->bind(index, values[index]);
+  }
+}
+
+bool PreparedQuery::execute() {
+  return open();
+}
+
+bool PreparedQuery::execute(const std::vector<prolog::Term>& values) {
+  bind(values);
+  
+  return open();
+}
+
+void PreparedQuery::Goal::index(const boost::unordered_map<std::string,
+    std::string>& variables) {
+  indices_.clear();
+  
+  for (std::vector<std::string>::const_iterator it = parameters_.begin();
+      it != parameters_.end(); ++it) {
+    boost::unordered_map<std::string, std::string>::const_iterator
+      jt = variables.find(*it);
+    std::vector<size_t> indices;
+    
+    if (jt != variables.end()) {
+      for (size_t index = 0; index < arguments_.size(); ++index)
+        if (arguments_[index].isVariable() &&
+            (Variable(arguments_[index]).getName() == jt->second))
+          indices.push_back(index);
+    }
+      
+    if (indices.empty())
+      throw PreparationError("Parameter ["+*it+
+        "] is not an argument variable.");
+    
+    indices_.push_back(indices);
+  }
+}
+
+bool PreparedQuery::Impl::prepare() {
+  if (handle_)
+    return false;
+  
+  boost::mutex::scoped_lock lock(goal_->mutex_);
+  
+  if (goal_->record_) {
+    argumentsHandle_ = PL_new_term_refs(goal_->arguments_.size());
+    
+    if (!argumentsHandle_)
+      throw Context::ResourceError();
+    
+    term_t goal = PL_new_term_ref();
+    
+    if (!PL_recorded(goal_->record_, goal))
+      throw Context::ResourceError();
+    
+    for (size_t index = 0; index < goal_->arguments_.size(); ++index)
+      if (!PL_get_arg(index+1, goal, argumentsHandle_+index))
+        throw Context::ResourceError();
+  }
+  else
+    compile();
+  
+  predicate_ = goal_->predicate_;
+  arguments_ = goal_->arguments_;
+  moduleHandle_ = goal_->moduleHandle_;
+  predicateHandle_ = goal_->predicateHandle_;
+  
+  lock.unlock();
+  
+  for (size_t index = 0; index < values_.size(); ++index)
+    put(index);
+  
+  return true;
+}
+
+void PreparedQuery::Impl::compile() {
+  if (!goal_->text_.empty())
+    parse();
+  
+  functor_t predicateFunctor = HandleCache::getFunctor(goal_->predicate_,
+    goal_->arguments_.size());
+  
+  goal_->moduleHandle_ = HandleCache::getModule(goal_->module_);
+  goal_->predicateHandle_ = HandleCache::getPredicate(goal_->module_,
+    goal_->predicate_, goal_->arguments_.size());
+  
+  argumentsHandle_ = PL_new_term_refs(goal_->arguments_.size());
+  
+  if (!argumentsHandle_)
+    throw Context::ResourceError();
+  
+  for (size_t index = 0; index < goal_->arguments_.size(); ++index) {
+    Term argument;
+  
+    argument.impl_.reset(new Term::Impl(goal_->arguments_[index]));
+    
+    PL_put_term(argumentsHandle_+index, argument.impl_->handle_);
+  }
+  
+  term_t goal = PL_new_term_ref();
+  
+  if (!PL_cons_functor_v(goal, predicateFunctor, argumentsHandle_))
+    throw Context::ResourceError();
+  
+  goal_->record_ = PL_record(goal);
+  
+  if (!goal_->record_)
+    throw Context::ResourceError();
+}
+
+void PreparedQuery::Impl::parse() {
+  predicate_t predicate = HandleCache::getPredicate("user", "atom_to_term",
+    3);
+
+  term_t arguments = PL_new_term_refs(3);
+
+  if (!arguments)
+    throw Context::ResourceError();
+  
+  if (!PL_put_string_nchars(arguments, goal_->text_.length(),
+      goal_->text_.c_str()))
+    throw Context::ResourceError();
+  
+  qid_t query = PL_open_query(NULL, PL_Q_CATCH_EXCEPTION, predicate,
+    arguments);
+  
+  if (!query)
+    throw Context::ResourceError();
+  
+  if (!PL_next_solution(query)) {
+    Exception exception(PL_exception(query));
+    
+    PL_close_query(query);
+    
+    if (!exception.isEmpty())
+      throw exception;
+    else
+      throw PreparationError("Goal cannot be parsed.");
+  }
+  
+  BOOST_ASSERT(PL_is_list(arguments+2));
+  
+  prolog::Term goal = Term(arguments+1);
+  List bindings = (prolog::Term)Term(arguments+2);
+  boost::unordered_map<std::string, std::string> variables;
+
+  for (List::ConstIterator it = bindings.begin();
+      it != bindings.end(); ++it) {
+    BOOST_ASSERT(it->isCompound());
+
+    Compound mapping(*it);
+    
+    BOOST_ASSERT(mapping.getFunctorIdentifier() ==
+      SymbolTable::internFunctor("=", 2));
+  
+    Atom name = mapping.getArgument(0);
+    Variable variable = mapping.getArgument(1);
+    
+    goal_->mappings_.insert(std::make_pair(variable.getName(),
+      name.getSymbol()));
+    variables.insert(std::make_pair(name.getName(), variable.getName()));
+  }
+  
+  PL_close_query(query);
+  
+  if (goal.isAtom())
+    goal_->predicate_ = Atom(goal).getName();
+  else if (goal.isCompound()) {
+    Compound compound(goal);
+    
+    goal_->predicate_ = compound.getFunctor();
+    goal_->arguments_.assign(compound.begin(), compound.end());
+  }
+  else
+    throw PreparationError("Goal is not callable.");
+  
+  goal_->index(variables);
+}
+
+void PreparedQuery::Impl::bind(size_t index, const prolog::Term& value) {
+  if (index >= values_.size())
+    throw PreparationError("Parameter index ["+boost::lexical_cast<
+      std::string>(index)+"] is out of range.");
+  
+  if (handle_)
+    throw PreparationError("Parameters of an open query are immutable.");
+  
+  values_[index] = value;
+  
+  if (argumentsHandle_)
+    put(index);
+}
+
+void PreparedQuery::Impl::put(size_t index) {
+  const std::vector<size_t>& indices = goal_->indices_[index];
+  term_t handle = argumentsHandle_+indices.front();
+  const prolog::Term& value = values_[index];
+  bool result;
+  
+  if (!value.isValid() || value.isVariable())
+    result = PL_put_variable(handle);
+  else if (value.isAtom()) {
+    const std::string& name = Atom(value).getName();
+    
+    result = PL_put_atom_nchars(handle, name.length(), name.c_str());
+  }
+  else if (value.getType() == prolog::Term::IntegerType)
+    result = PL_put_int64(handle, Integer(value).getValue());
+  else if (value.getType() == prolog::Term::FloatType)
+    result = PL_put_float(handle, Float(value).getValue());
+  else if (value.isString()) {
+    const std::string& string = String(value).getValue();
+    
+    result = PL_put_string_nchars(handle, string.length(), string.c_str());
+  }
+  else {
+    Term term;
+    
+    term.impl_.reset(new Term::Impl(value));
+    
+    result = PL_put_term(handle, term.impl_->handle_);
+  }
+  
+  if (!result)
+    throw Context::ResourceError();
+  
+  for (size_t slot = 1; slot < indices.size(); ++slot)
+    PL_put_term(argumentsHandle_+indices[slot], handle);
+}
+
+bool PreparedQuery::Impl::open() {
+  if (!handle_) {
+    if (!argumentsHandle_)
+      prepare();
+    
+    std::vector<bool> bound(arguments_.size(), false);
+    
+    for (size_t parameter = 0; parameter < goal_->indices_.size();
+        ++parameter)
+      for (size_t slot = 0; slot < goal_->indices_[parameter].size();
+          ++slot)
+        bound[goal_->indices_[parameter][slot]] = true;
+    
+    for (size_t index = 0; index < arguments_.size(); ++index)
+      if (!bound[index])
+        generateBindings(arguments_[index], argumentsHandle_+index,
+          goal_->mappings_);
+    
+    handle_ = PL_open_query(NULL, PL_Q_CATCH_EXCEPTION, predicateHandle_,
+      argumentsHandle_);
+    localStackHighWaterMark_ = 0;
+  }
+  
+  return handle_;
+}
+
+}}
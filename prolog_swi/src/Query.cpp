@@ -16,15 +16,21 @@
  * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
  ******************************************************************************/
 
+#include <algorithm>
+
 #include <SWI-Prolog.h>
 
 #include <prolog_common/Atom.h>
 #include <prolog_common/Compound.h>
 #include <prolog_common/List.h>
+#include <prolog_common/String.h>
+#include <prolog_common/SymbolTable.h>
 #include <prolog_common/Variable.h>
 
 #include <prolog_swi/Context.h>
 #include <prolog_swi/Exception.h>
+#include <prolog_swi/GoalCache.h>
+#include <prolog_swi/HandleCache.h>
 #include <prolog_swi/Term.h>
 
 #include "prolog_swi/Query.h"
@@ -39,7 +45,7 @@ Query::Query() {
 }
 
 Query::Query(const std::string& goal) :
-  impl_(new Impl("user", "call", {Atom(goal)})) {
+  impl_(new Impl("user", "call", {String(goal)})) {
 }
 
 Query::Query(const std::string& predicate, const std::vector<prolog::Term>&
@@ -68,6 +74,10 @@ Query::Query(const prolog::Query& query) {
       query.getArguments()));
 }
 
+Query::Query(const GoalBuilder& goal) :
+  impl_(new Impl("user", goal)) {
+}
+
 Query::Query(const Query& src) :
   impl_(src.impl_) {
 }
@@ -83,10 +93,42 @@ Query::Impl::Impl(const std::string& module, const std::string& predicate,
   moduleHandle_(0),
   predicateHandle_(0),
   argumentsHandle_(0),
-  handle_(0) {
+  handle_(0),
+  lazy_(false),
+  monitorLocalStack_(false),
+  localStackHighWaterMark_(0) {
   BOOST_ASSERT(!predicate.empty());  
 }
 
+Query::Impl::Impl(const std::string& module, const GoalBuilder& goal) :
+  module_(module),
+  predicate_("call"),
+  arguments_(1),
+  moduleHandle_(0),
+  predicateHandle_(0),
+  argumentsHandle_(0),
+  handle_(0),
+  lazy_(false),
+  monitorLocalStack_(false),
+  localStackHighWaterMark_(0) {
+  Term goalTerm = goal.getGoal();
+  
+  BOOST_ASSERT(!goalTerm.isEmpty());
+  
+  argumentsHandle_ = PL_new_term_refs(1);
+  
+  if (!argumentsHandle_)
+    throw Context::ResourceError();
+  
+  PL_put_term(argumentsHandle_, goalTerm.impl_->handle_);
+  
+  boost::unordered_map<std::string, Symbol> mappings;
+  
+  for (std::vector<std::pair<prolog::Term, unsigned long> >::const_iterator
+      it = goal.impl_->terms_.begin(); it != goal.impl_->terms_.end(); ++it)
+    generateBindings(it->first, it->second, mappings);
+}
+
 Query::Impl::~Impl() {
   close();
 }
@@ -113,6 +155,37 @@ bool Query::isValid() const {
   return impl_.get();
 }
 
+void Query::setLazyBindings(bool lazy) {
+  if (impl_.get())
+    impl_->lazy_ = lazy;
+}
+
+bool Query::hasLazyBindings() const {
+  if (impl_.get())
+    return impl_->lazy_;
+  else
+    return false;
+}
+
+void Query::setLocalStackMonitoring(bool monitor) {
+  if (impl_.get())
+    impl_->monitorLocalStack_ = monitor;
+}
+
+bool Query::isLocalStackMonitored() const {
+  if (impl_.get())
+    return impl_->monitorLocalStack_;
+  else
+    return false;
+}
+
+size_t Query::getLocalStackHighWaterMark() const {
+  if (impl_.get())
+    return impl_->localStackHighWaterMark_;
+  else
+    return 0;
+}
+
 /*****************************************************************************/
 /* Methods                                                                   */
 /*****************************************************************************/
@@ -128,7 +201,42 @@ bool Query::nextSolution(prolog::Bindings& bindings) {
   bindings.clear();
   
   if (impl_.get())
-    return impl_->nextSolution(bindings);
+    return impl_->nextSolution(bindings, 0, 0);
+  else
+    return false;
+}
+
+bool Query::nextSolution(prolog::Bindings& bindings, TermArena& arena) {
+  bindings.clear();
+  
+  if (impl_.get())
+    return impl_->nextSolution(bindings, &arena, 0);
+  else
+    return false;
+}
+
+bool Query::nextSolution(prolog::Bindings& bindings, TermFactory& factory) {
+  bindings.clear();
+  
+  if (impl_.get())
+    return impl_->nextSolution(bindings, 0, &factory);
+  else
+    return false;
+}
+
+bool Query::nextSolution(BindingsSnapshot& snapshot) {
+  if (impl_.get())
+    return impl_->nextSolution(snapshot);
+  else {
+    snapshot = BindingsSnapshot();
+    
+    return false;
+  }
+}
+
+bool Query::nextSolution(BindingsWriter& writer) {
+  if (impl_.get())
+    return impl_->nextSolution(writer);
   else
     return false;
 }
@@ -145,51 +253,60 @@ void Query::close() {
 
 bool Query::Impl::open() {
   if (!handle_) {
-    if (!moduleHandle_) {
-      atom_t moduleAtom;
+    bool parse = !argumentsHandle_ && (predicate_ == "call") &&
+      (arguments_.size() == 1) && (arguments_.front().isAtom() ||
+      arguments_.front().isString());
+    std::string goal;
+    
+    if (parse) {
+      goal = arguments_.front().isAtom() ?
+        Atom(arguments_.front()).getName() :
+        String(arguments_.front()).getValue();
       
-      if (!module_.empty())
-        moduleAtom = PL_new_atom(module_.c_str());
-      else
-        moduleAtom = PL_new_atom("user");
-        
-      moduleHandle_ = PL_new_module(moduleAtom);
-      PL_unregister_atom(moduleAtom);
+      boost::shared_ptr<const GoalCache::Goal> cachedGoal =
+        GoalCache::lookup(module_, goal);
       
-      if (!moduleHandle_)
-        throw Context::ResourceError();
+      if (cachedGoal) {
+        moduleHandle_ = cachedGoal->moduleHandle_;
+        predicateHandle_ = cachedGoal->predicateHandle_;
+        arguments_ = {cachedGoal->term_};
+        
+        argumentsHandle_ = PL_new_term_refs(1);
+        
+        if (!argumentsHandle_)
+          throw Context::ResourceError();
+        
+        if (!PL_recorded(cachedGoal->record_, argumentsHandle_))
+          throw Context::ResourceError();
+        
+        generateBindings(cachedGoal->term_, argumentsHandle_,
+          cachedGoal->mappings_);
+        
+        parse = false;
+      }
     }
+    
+    if (!moduleHandle_)
+      moduleHandle_ = HandleCache::getModule(module_);
       
-    if (!predicateHandle_) {
-      atom_t predicateAtom = PL_new_atom(predicate_.c_str());
-      functor_t predicateFunctor = PL_new_functor(predicateAtom,
+    if (!predicateHandle_)
+      predicateHandle_ = HandleCache::getPredicate(module_, predicate_,
         arguments_.size());
-      
-      predicateHandle_ = PL_pred(predicateFunctor, moduleHandle_);
-      PL_unregister_atom(predicateAtom);
-      
-      if (!predicateHandle_)
-        throw Context::ResourceError();
-    }
     
     if (!argumentsHandle_) {
-      boost::unordered_map<std::string, std::string> mappings;
-      
-      if ((predicate_ == "call") && (arguments_.size() == 1) &&
-          arguments_.front().isAtom()) {
-        Atom atom = arguments_.front();
+      boost::unordered_map<std::string, Symbol> mappings;
       
-        predicate_t predicate = PL_predicate("atom_to_term", 3, "user");
-      
-        if (!predicate)
-          throw Context::ResourceError();
+      if (parse) {
+        predicate_t predicate = HandleCache::getPredicate("user",
+          "atom_to_term", 3);
       
         term_t arguments = PL_new_term_refs(3);
       
         if (!arguments)
           throw Context::ResourceError();
         
-        PL_put_atom(arguments, PL_new_atom(atom.getName().c_str()));
+        if (!PL_put_string_nchars(arguments, goal.length(), goal.c_str()))
+          throw Context::ResourceError();
         
         qid_t query = PL_open_query(NULL, PL_Q_CATCH_EXCEPTION,
           predicate, arguments);
@@ -203,23 +320,23 @@ bool Query::Impl::open() {
           arguments_ = {Term(arguments+1)};
           List bindings = (prolog::Term)Term(arguments+2);
 
-          for (std::list<prolog::Term>::const_iterator it = bindings.begin();
+          for (List::ConstIterator it = bindings.begin();
               it != bindings.end(); ++it) {
             BOOST_ASSERT(it->isCompound());
 
             Compound mapping(*it);
             
-            BOOST_ASSERT(mapping.getFunctor() == "=");
-            BOOST_ASSERT(mapping.getArity() == 2);
+            BOOST_ASSERT(mapping.getFunctorIdentifier() ==
+              SymbolTable::internFunctor("=", 2));
           
-            prolog::Term name = *mapping.begin();
-            prolog::Term variable = *(++mapping.begin());
+            prolog::Term name = mapping.getArgument(0);
+            prolog::Term variable = mapping.getArgument(1);
           
             BOOST_ASSERT(name.isAtom());
             BOOST_ASSERT(variable.isVariable());
             
             mappings.insert(std::make_pair(Variable(variable).getName(),
-              Atom(name).getName()));
+              Atom(name).getSymbol()));
           }
           
           PL_close_query(query);
@@ -231,6 +348,8 @@ bool Query::Impl::open() {
           
           if (!exception.isEmpty())
             throw exception;
+          
+          parse = false;
         }
       }
       
@@ -251,24 +370,84 @@ bool Query::Impl::open() {
         
         generateBindings(*it, argumentsHandle_+index, mappings);
       }
+      
+      if (parse) {
+        record_t record = PL_record(argumentsHandle_);
+        
+        if (!record)
+          throw Context::ResourceError();
+        
+        GoalCache::insert(module_, goal, boost::shared_ptr<const
+          GoalCache::Goal>(new GoalCache::Goal(record, arguments_.front(),
+          mappings, moduleHandle_, predicateHandle_)));
+      }
     }
   
     handle_ = PL_open_query(NULL, PL_Q_CATCH_EXCEPTION, predicateHandle_,
       argumentsHandle_);
+    localStackHighWaterMark_ = 0;
   }
   
   return handle_;
 }
 
-bool Query::Impl::nextSolution(prolog::Bindings& bindings) {
+bool Query::Impl::nextSolution(prolog::Bindings& bindings, TermArena*
+    arena, TermFactory* factory) {
   bindings.clear();
   
-  if (handle_) {
-    if (PL_next_solution(handle_)) {
+  if (next()) {
+    beginSolution();
+    
+    if (arena)
+      bindings = bindings_.toBindings(*arena);
+    else if (factory)
+      bindings = bindings_.toBindings(*factory);
+    else if (lazy_)
+      bindings = bindings_.toLazyBindings();
+    else
       bindings = bindings_;
     
+    endSolution();
+  
+    return true;
+  }
+  
+  return false;
+}
+
+bool Query::Impl::nextSolution(BindingsSnapshot& snapshot) {
+  if (next()) {
+    beginSolution();
+    snapshot = bindings_.toSnapshot();
+    endSolution();
+    
+    return true;
+  }
+  else {
+    snapshot = BindingsSnapshot();
+    
+    return false;
+  }
+}
+
+bool Query::Impl::nextSolution(BindingsWriter& writer) {
+  if (next()) {
+    beginSolution();
+    bindings_.write(writer);
+    endSolution();
+    
+    return true;
+  }
+  else
+    return false;
+}
+
+bool Query::Impl::next() {
+  solutionFrame_.close();
+  
+  if (handle_) {
+    if (PL_next_solution(handle_))
       return true;
-    }
     else {
       Exception exception(PL_exception(handle_));
       
@@ -280,8 +459,34 @@ bool Query::Impl::nextSolution(prolog::Bindings& bindings) {
   return false;
 }
 
+void Query::Impl::beginSolution() {
+  if (!solutionFrame_.open())
+    throw Context::ResourceError();
+}
+
+void Query::Impl::endSolution() {
+  if (monitorLocalStack_) {
+    predicate_t predicate = HandleCache::getPredicate("system",
+      "statistics", 2);
+    term_t arguments = PL_new_term_refs(2);
+    int64_t used;
+    
+    if (arguments &&
+        PL_put_atom(arguments, HandleCache::getAtom("localused")) &&
+        PL_call_predicate(NULL, PL_Q_NODEBUG, predicate, arguments) &&
+        PL_get_int64(arguments+1, &used))
+      localStackHighWaterMark_ = std::max(localStackHighWaterMark_,
+        (size_t)used);
+  }
+  
+  solutionFrame_.rewind();
+  solutionFrame_.close();
+}
+
 void Query::Impl::cut() {
   if (handle_) {
+    solutionFrame_.close();
+    
     PL_cut_query(handle_);
     
     bindings_.clear();
@@ -292,6 +497,8 @@ void Query::Impl::cut() {
 
 void Query::Impl::close() {
   if (handle_) {
+    solutionFrame_.close();
+    
     PL_close_query(handle_);
     
     bindings_.clear();
@@ -301,7 +508,7 @@ void Query::Impl::close() {
 }
 
 void Query::Impl::generateBindings(const prolog::Term& argument, unsigned long
-    handle, const boost::unordered_map<std::string, std::string>& mappings) {
+    handle, const boost::unordered_map<std::string, Symbol>& mappings) {
   if (argument.isValid() && handle) {
     if (argument.isList()) {
       BOOST_ASSERT(PL_is_list(handle));
@@ -310,7 +517,7 @@ void Query::Impl::generateBindings(const prolog::Term& argument, unsigned long
       
       term_t listHandle = PL_copy_term_ref(handle);
 
-      for (std::list<prolog::Term>::const_iterator it = list.begin();
+      for (List::ConstIterator it = list.begin();
           it != list.end(); ++it) {
         term_t head = PL_new_term_ref();
       
@@ -318,6 +525,9 @@ void Query::Impl::generateBindings(const prolog::Term& argument, unsigned long
         
         generateBindings(*it, head, mappings);
       }
+      
+      if (list.isPartial())
+        generateBindings(list.getTail(), listHandle, mappings);
     }
     else if (argument.isCompound()) {
       BOOST_ASSERT(PL_is_compound(handle));
@@ -333,7 +543,7 @@ void Query::Impl::generateBindings(const prolog::Term& argument, unsigned long
       
       size_t index = 0;
       
-      for (std::vector<prolog::Term>::const_iterator it = compound.begin();
+      for (Compound::ConstIterator it = compound.begin();
           it != compound.end(); ++it, ++index) {
         term_t argument = PL_new_term_ref();
       
@@ -345,7 +555,7 @@ void Query::Impl::generateBindings(const prolog::Term& argument, unsigned long
     else if (argument.isVariable()) {
       Variable variable(argument);
       
-      boost::unordered_map<std::string, std::string>::const_iterator
+      boost::unordered_map<std::string, Symbol>::const_iterator
         it = mappings.find(variable.getName());
       
       if (it != mappings.end())
@@ -16,17 +16,26 @@
  * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
  ******************************************************************************/
 
+#include <cstring>
+#include <iterator>
+#include <vector>
+
 #include <SWI-Prolog.h>
 
+#include <boost/assert.hpp>
+
 #include <prolog_common/Atom.h>
 #include <prolog_common/Compound.h>
 #include <prolog_common/Float.h>
 #include <prolog_common/Integer.h>
 #include <prolog_common/List.h>
+#include <prolog_common/String.h>
+#include <prolog_common/TermWalker.h>
 #include <prolog_common/Variable.h>
 
 #include <prolog_swi/Context.h>
 #include <prolog_swi/Exception.h>
+#include <prolog_swi/HandleCache.h>
 
 #include "prolog_swi/Term.h"
 
@@ -70,79 +79,13 @@ Term::Impl::Impl(const std::string& goal) :
 Term::Impl::Impl(const prolog::Term& term) :
   handle_(0) {
   if (term.isValid()) {
-    handle_ = PL_new_term_ref();
+    Converter converter;
+    TermWalker walker;
     
-    if (!handle_)
-      throw Context::ResourceError();
+    walker.walk(term, converter);
     
-    if (term.isAtom()) {
-      Atom atom(term);
-      
-      if (!PL_put_atom_chars(handle_, atom.getName().c_str()))
-        throw Context::ResourceError();
-    }
-    else if (term.isCompound()) {
-      Compound compound(term);
-      std::vector<prolog::Term> arguments = compound.getArguments();
-      
-      atom_t atom = PL_new_atom(compound.getFunctor().c_str());
-      
-      if (!atom)
-        throw Context::ResourceError();
-      
-      functor_t functor = PL_new_functor(atom, compound.getArity());
-      
-      if (!functor)
-        throw Context::ResourceError();
-
-      term_t args = PL_new_term_refs(compound.getArity());
-      
-      if (!args)
-        throw Context::ResourceError();
-      
-      size_t index = 0;
-      for (std::vector<prolog::Term>::const_iterator it = arguments.begin();
-          it != arguments.end(); ++it, ++index) {
-        Term argument;
-      
-        argument.impl_.reset(new Term::Impl(*it));
-
-        PL_put_term(args+index, argument.impl_->handle_);
-      }
-      
-      if (!PL_cons_functor_v(handle_, functor, args))
-        throw Context::ResourceError();
-    }
-    else if (term.isNumber()) {
-      Number number(term);
-      
-      if (number.isFloat()) {
-        if (!PL_put_float(handle_, Float(number).getValue()))
-          throw Context::ResourceError();
-      }
-      else if (number.isInteger()) {
-        if (!PL_put_int64(handle_, Integer(number).getValue()))
-          throw Context::ResourceError();
-      }
-    }
-    else if (term.isList()) {
-      List list(term);
-      std::list<prolog::Term> elements = list.getElements();
-      
-      PL_put_nil(handle_);
-
-      for (std::list<prolog::Term>::const_reverse_iterator it = elements.
-          rbegin(); it != elements.rend(); ++it) {
-        Term element;
-      
-        element.impl_.reset(new Term::Impl(*it));
-        
-        if (!PL_cons_list(handle_, element.impl_->handle_, handle_))
-          throw Context::ResourceError();
-      }
-    }
-    else if (term.isVariable())
-      PL_put_variable(handle_);
+    BOOST_ASSERT(converter.handles_.size() == 1);
+    handle_ = converter.handles_.back();
   }
 }
 
@@ -153,6 +96,9 @@ Term::Impl::Impl(unsigned long handle) :
 Term::Impl::~Impl() {
 }
 
+Term::Converter::Converter() {
+}
+
 /*****************************************************************************/
 /* Accessors                                                                 */
 /*****************************************************************************/
@@ -169,83 +115,422 @@ bool Term::isValid() const {
 }
 
 /*****************************************************************************/
-/* Operators                                                                 */
+/* Methods                                                                   */
 /*****************************************************************************/
 
-Term::operator prolog::Term() const {
+prolog::Term Term::toTerm(TermArena& arena) const {
   if (impl_.get())
-    return impl_->operator prolog::Term();
+    return impl_->convert(&arena, 0);
   else
     return prolog::Term();
 }
 
-Term::Impl::operator prolog::Term() const {
-  if (handle_) {
-    if (PL_is_list(handle_)) {
-      term_t list = PL_copy_term_ref(handle_);
-      term_t head = PL_new_term_ref();
+prolog::Term Term::toTerm(TermFactory& factory) const {
+  if (impl_.get())
+    return impl_->convert(0, &factory);
+  else
+    return prolog::Term();
+}
+
+prolog::Term Term::Impl::convert(TermArena* arena, TermFactory* factory)
+    const {
+  if (!handle_)
+    return prolog::Term();
+  
+  std::vector<Frame> frames;
+  std::vector<term_t> refs;
+  std::vector<prolog::Term> terms;
+  term_t current = handle_;
+  
+  while (true) {
+    if (PL_is_list(current) || PL_is_compound(current)) {
+      if (frames.size() == refs.size())
+        refs.push_back(PL_new_term_refs(3));
       
-      std::list<prolog::Term> elements;
+      Frame frame;
       
-      while (PL_get_list(list, head, list))
-        elements.push_back(Term(head));
+      frame.refs_ = refs[frames.size()];
+      frame.list_ = PL_is_list(current);
+      frame.offset_ = terms.size();
       
-      return List(elements);
-    }
-    else if (PL_is_compound(handle_)) {
-      atom_t functor;
-      term_t argument = PL_new_term_ref();
-      int arity;
-
-      if (!PL_get_name_arity(handle_, &functor, &arity))
+      if (!PL_put_term(frame.refs_, current))
         throw ConversionError();
       
-      std::vector<prolog::Term> arguments;
-      
-      for (size_t index = 0; index < arity; ++index) {
-        if (!PL_get_arg(index+1, handle_, argument))
+      if (frame.list_) {
+        size_t length = 0;
+        
+        frame.partial_ = (PL_skip_list(frame.refs_, frame.refs_+2,
+          &length) == PL_PARTIAL_LIST);
+      }
+      else {
+        atom_t functor;
+        int arity;
+        
+        if (!PL_get_name_arity(current, &functor, &arity))
           throw ConversionError();
         
-        arguments.push_back(Term(argument));
+        frame.functor_ = functor;
+        frame.arity_ = arity;
+        frame.index_ = 0;
       }
       
-      return Compound(PL_atom_chars(functor), arguments);
+      frames.push_back(frame);
     }
-    else if (PL_is_float(handle_)) {
-      double number;
+    else
+      terms.push_back(convertAtomic(current, arena));
+    
+    while (true) {
+      if (frames.empty())
+        return terms.back();
       
-      if (!PL_get_float(handle_, &number))
-        throw ConversionError();
+      Frame& frame = frames.back();
+      term_t next = frame.refs_+1;
       
-      return Float(number);
-    }
-    else if (PL_is_integer(handle_)) {
-      long number;
+      if (frame.list_ ? PL_get_list(frame.refs_, next, frame.refs_) :
+          (frame.index_ < frame.arity_)) {
+        if (!frame.list_ && !PL_get_arg(++frame.index_, frame.refs_, next))
+          throw ConversionError();
+        
+        current = next;
+        break;
+      }
       
-      if (!PL_get_long(handle_, &number))
-        throw ConversionError();
+      std::vector<prolog::Term> subterms(
+        std::make_move_iterator(terms.begin()+frame.offset_),
+        std::make_move_iterator(terms.end()));
+      prolog::Term term;
+      
+      if (frame.list_) {
+        prolog::Term tail = frame.partial_ ?
+          convertAtomic(frame.refs_+2, arena) : prolog::Term();
+        
+        if (arena)
+          term = arena->createList(subterms, tail);
+        else if (factory)
+          term = factory->createList(std::move(subterms), tail);
+        else if (frame.partial_)
+          term = List(subterms, tail);
+        else
+          term = List(std::move(subterms));
+      }
+      else {
+        const char* functor = PL_atom_chars(frame.functor_);
+        
+        if (arena)
+          term = arena->createCompound(functor, subterms);
+        else if (factory)
+          term = factory->createCompound(functor, std::move(subterms));
+        else
+          term = Compound(functor, std::move(subterms));
+      }
       
-      return Integer(number);
+      terms.resize(frame.offset_);
+      terms.push_back(std::move(term));
+      frames.pop_back();
     }
-    else if (PL_is_variable(handle_)) {
-      char* name;
+  }
+}
+
+prolog::Term Term::Impl::convertAtomic(unsigned long handle, TermArena*
+    arena) {
+  if (PL_is_float(handle)) {
+    double number;
+    
+    if (!PL_get_float(handle, &number))
+      throw ConversionError();
+    
+    return Float(number);
+  }
+  else if (PL_is_integer(handle)) {
+    long number;
+    
+    if (!PL_get_long(handle, &number))
+      throw ConversionError();
+    
+    return Integer(number);
+  }
+  else if (PL_is_variable(handle)) {
+    char* name;
+    
+    if (!PL_get_chars(handle, &name, CVT_VARIABLE | BUF_RING))
+      throw ConversionError();
+    
+    if (arena)
+      return arena->createVariable(name);
+    else
+      return Variable(name);
+  }
+  else if (PL_is_string(handle)) {
+    size_t length;
+    char* chars;
+    
+    if (!PL_get_nchars(handle, &length, &chars, CVT_STRING |
+        BUF_DISCARDABLE | REP_UTF8))
+      throw ConversionError();
+    
+    return String(std::string(chars, length));
+  }
+  else if (PL_is_atom(handle)) {
+    atom_t atom;
+    
+    if (!PL_get_atom(handle, &atom))
+      throw ConversionError();
+    
+    return Atom(PL_atom_chars(atom));
+  }
+  
+  return prolog::Term();
+}
+
+void Term::Impl::write(BindingsWriter& writer) const {
+  std::vector<Frame> frames;
+  std::vector<term_t> refs;
+  term_t current = handle_;
+  
+  while (true) {
+    if (PL_is_list(current) || PL_is_compound(current)) {
+      if (frames.size() == refs.size())
+        refs.push_back(PL_new_term_refs(3));
       
-      if (!PL_get_chars(handle_, &name, CVT_VARIABLE | BUF_RING))
+      Frame frame;
+      
+      frame.refs_ = refs[frames.size()];
+      frame.list_ = PL_is_list(current);
+      
+      if (!PL_put_term(frame.refs_, current))
         throw ConversionError();
       
-      return Variable(name);
+      if (frame.list_) {
+        size_t length = 0;
+        
+        frame.partial_ = (PL_skip_list(frame.refs_, frame.refs_+2,
+          &length) == PL_PARTIAL_LIST);
+        writer.putList(length, frame.partial_);
+      }
+      else {
+        atom_t functor;
+        int arity;
+        size_t length;
+        
+        if (!PL_get_name_arity(current, &functor, &arity))
+          throw ConversionError();
+        
+        const char* name = PL_atom_nchars(functor, &length);
+        
+        writer.putCompound(name, length, arity);
+        frame.arity_ = arity;
+        frame.index_ = 0;
+      }
+      
+      frames.push_back(frame);
     }
-    else if (PL_is_atom(handle_)) {
-      atom_t atom;
+    else
+      writeAtomic(current, writer);
+    
+    while (true) {
+      if (frames.empty())
+        return;
       
-      if (!PL_get_atom(handle_, &atom))
-        throw ConversionError();
+      Frame& frame = frames.back();
+      term_t next = frame.refs_+1;
+      
+      if (frame.list_) {
+        if (PL_get_list(frame.refs_, next, frame.refs_)) {
+          current = next;
+          break;
+        }
+        else if (frame.partial_) {
+          frame.partial_ = false;
+          current = frame.refs_+2;
+          break;
+        }
+      }
+      else if (frame.index_ < frame.arity_) {
+        if (!PL_get_arg(++frame.index_, frame.refs_, next))
+          throw ConversionError();
+        
+        current = next;
+        break;
+      }
       
-      return Atom(PL_atom_chars(atom));
+      frames.pop_back();
     }
   }
+}
 
-  return prolog::Term();
+void Term::Impl::writeAtomic(unsigned long handle, BindingsWriter& writer) {
+  if (PL_is_float(handle)) {
+    double number;
+    
+    if (!PL_get_float(handle, &number))
+      throw ConversionError();
+    
+    writer.putFloat(number);
+  }
+  else if (PL_is_integer(handle)) {
+    int64_t number;
+    
+    if (!PL_get_int64(handle, &number))
+      throw ConversionError();
+    
+    writer.putInteger(number);
+  }
+  else if (PL_is_variable(handle)) {
+    char* name;
+    
+    if (!PL_get_chars(handle, &name, CVT_VARIABLE | BUF_RING))
+      throw ConversionError();
+    
+    writer.putVariable(name, std::strlen(name));
+  }
+  else if (PL_is_string(handle)) {
+    size_t length;
+    char* chars;
+    
+    if (!PL_get_nchars(handle, &length, &chars, CVT_STRING |
+        BUF_DISCARDABLE | REP_UTF8))
+      throw ConversionError();
+    
+    writer.putString(chars, length);
+  }
+  else if (PL_is_atom(handle)) {
+    atom_t atom;
+    size_t length;
+    
+    if (!PL_get_atom(handle, &atom))
+      throw ConversionError();
+    
+    const char* name = PL_atom_nchars(atom, &length);
+    
+    writer.putAtom(name, length);
+  }
+  else
+    throw ConversionError();
+}
+
+/*****************************************************************************/
+/* Operators                                                                 */
+/*****************************************************************************/
+
+Term::operator prolog::Term() const {
+  if (impl_.get())
+    return impl_->operator prolog::Term();
+  else
+    return prolog::Term();
+}
+
+Term::Impl::operator prolog::Term() const {
+  return convert(0, 0);
+}
+
+void Term::Converter::visitAtom(const Atom& atom) {
+  const std::string& name = atom.getName();
+  
+  if (!PL_put_atom_nchars(push(), name.length(), name.c_str()))
+    throw Context::ResourceError();
+}
+
+void Term::Converter::visitCompound(const Compound& compound) {
+  offsets_.push_back(handles_.size());
+}
+
+void Term::Converter::visitFloat(const Float& number) {
+  if (!PL_put_float(push(), number.getValue()))
+    throw Context::ResourceError();
+}
+
+void Term::Converter::visitInteger(const Integer& number) {
+  if (!PL_put_int64(push(), number.getValue()))
+    throw Context::ResourceError();
+}
+
+void Term::Converter::visitList(const List& list) {
+  offsets_.push_back(handles_.size());
+}
+
+void Term::Converter::visitString(const String& string) {
+  const std::string& value = string.getValue();
+  
+  if (!PL_put_string_nchars(push(), value.length(), value.c_str()))
+    throw Context::ResourceError();
+}
+
+void Term::Converter::visitVariable(const Variable& variable) {
+  PL_put_variable(push());
+}
+
+void Term::Converter::leaveCompound(const Compound& compound) {
+  std::vector<unsigned long>::iterator begin = handles_.begin()+
+    offsets_.back();
+  offsets_.pop_back();
+  
+  functor_t functor = getFunctor(compound.getFunctorIdentifier());
+
+  term_t args = PL_new_term_refs(compound.getArity());
+  
+  if (!args)
+    throw Context::ResourceError();
+  
+  size_t index = 0;
+  for (std::vector<unsigned long>::const_iterator it = begin;
+      it != handles_.end(); ++it, ++index)
+    PL_put_term(args+index, *it);
+  
+  handles_.erase(begin, handles_.end());
+  
+  if (!PL_cons_functor_v(push(), functor, args))
+    throw Context::ResourceError();
+}
+
+void Term::Converter::leaveList(const List& list) {
+  std::vector<unsigned long>::iterator begin = handles_.begin()+
+    offsets_.back();
+  std::vector<unsigned long>::iterator end = handles_.end();
+  offsets_.pop_back();
+  
+  term_t handle = PL_new_term_ref();
+  
+  if (!handle)
+    throw Context::ResourceError();
+  
+  if (list.isPartial()) {
+    --end;
+    PL_put_term(handle, *end);
+  }
+  else
+    PL_put_nil(handle);
+
+  for (std::vector<unsigned long>::iterator it = end; it != begin; ) {
+    --it;
+    
+    if (!PL_cons_list(handle, *it, handle))
+      throw Context::ResourceError();
+  }
+  
+  handles_.erase(begin, handles_.end());
+  handles_.push_back(handle);
+}
+
+unsigned long Term::Converter::push() {
+  term_t handle = PL_new_term_ref();
+  
+  if (!handle)
+    throw Context::ResourceError();
+  
+  handles_.push_back(handle);
+  
+  return handle;
+}
+
+unsigned long Term::Converter::getFunctor(size_t functor) {
+  boost::unordered_map<size_t, unsigned long>::const_iterator it =
+    functors_.find(functor);
+  
+  if (it == functors_.end())
+    it = functors_.insert(std::make_pair(functor, HandleCache::getFunctor(
+      functor))).first;
+  
+  return it->second;
 }
 
 }}
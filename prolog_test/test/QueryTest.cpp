@@ -18,14 +18,43 @@
 
 #include <gtest/gtest.h>
 
+#include <prolog_common/Atom.h>
+#include <prolog_common/List.h>
+#include <prolog_common/String.h>
+#include <prolog_common/TypedQuery.h>
+#include <prolog_common/Variable.h>
+
 #include <prolog_swi/Context.h>
+#include <prolog_swi/GoalCache.h>
+#include <prolog_swi/HandleCache.h>
+#include <prolog_swi/PreparedQuery.h>
 #include <prolog_swi/Query.h>
 
+#include <prolog_serialization/JSONBindingsWriter.h>
+
 #include <prolog_test/CurrentAtomQuery.h>
 #include <prolog_test/FileSearchPathQuery.h>
 
 using namespace prolog;
 
+struct AtomLength {
+  static const char* getName() {
+    return "atom_length";
+  }
+};
+
+struct Length {
+  int64_t length;
+};
+
+namespace prolog {
+  template <> struct FieldSchema<Length> {
+    static std::tuple<int64_t Length::*> getFields() {
+      return std::make_tuple(&Length::length);
+    }
+  };
+};
+
 TEST(Prolog, Query) {
   swi::Context context;
   swi::Query query;
@@ -119,3 +148,201 @@ TEST(Prolog, Query) {
   EXPECT_TRUE(bindings.contain("List"));
   EXPECT_TRUE(bindings["List"].isList());
 }
+
+TEST(Prolog, TypedQuery) {
+  swi::Context context;
+  Bindings bindings;
+  
+  EXPECT_TRUE(context.init());
+  
+  TypedQuery<AtomLength, std::string, Output<int64_t> > typedQuery("atom",
+    {});
+  swi::Query query = typedQuery;
+  
+  EXPECT_EQ(2, typedQuery.getArity());
+  EXPECT_TRUE(query.open());
+  EXPECT_TRUE(query.nextSolution(bindings));
+  EXPECT_EQ(4, std::get<0>(typedQuery.getResult(Solution(bindings))));
+  
+  Length length;
+  
+  typedQuery.getResult(Solution(bindings), length);
+  EXPECT_EQ(4, length.length);
+}
+
+TEST(Prolog, GoalCache) {
+  swi::Context context;
+  Bindings bindings;
+  
+  EXPECT_TRUE(context.init());
+  
+  swi::GoalCache::clear();
+  
+  for (size_t index = 0; index < 3; ++index) {
+    swi::Query query("atom_length(abc, Length)");
+    
+    EXPECT_TRUE(query.open());
+    EXPECT_TRUE(query.nextSolution(bindings));
+    EXPECT_EQ(Term(3), bindings["Length"]);
+  }
+  
+  EXPECT_EQ(1, swi::GoalCache::getNumGoals());
+  EXPECT_EQ(1, swi::GoalCache::getNumMisses());
+  EXPECT_EQ(2, swi::GoalCache::getNumHits());
+  
+  swi::GoalCache::setCapacity(0);
+  EXPECT_EQ(0, swi::GoalCache::getNumGoals());
+  swi::GoalCache::setCapacity(1024);
+}
+
+TEST(Prolog, PreparedQuery) {
+  swi::Context context;
+  Bindings bindings;
+  
+  EXPECT_TRUE(context.init());
+  
+  swi::PreparedQuery query("atom_length", {Variable("Atom"),
+    Variable("Length")}, {"Atom"});
+  
+  EXPECT_EQ(1, query.getNumParameters());
+  EXPECT_THROW(swi::PreparedQuery("atom_length", {Variable("Atom"),
+    Variable("Length")}, {"Name"}), swi::PreparedQuery::PreparationError);
+  
+  EXPECT_TRUE(query.prepare());
+  EXPECT_TRUE(query.isPrepared());
+  
+  const char* atoms[] = {"a", "ab", "abc"};
+  
+  for (size_t index = 0; index < 3; ++index) {
+    EXPECT_TRUE(query.execute({Atom(atoms[index])}));
+    EXPECT_TRUE(query.nextSolution(bindings));
+    EXPECT_EQ(Term((int64_t)index+1), bindings["Length"]);
+    EXPECT_THROW(query.bind("Atom", Atom("abcd")),
+      swi::PreparedQuery::PreparationError);
+    query.close();
+  }
+  
+  swi::PreparedQuery instance(query, {String("abcd")});
+  
+  EXPECT_FALSE(instance.isPrepared());
+  EXPECT_TRUE(instance.execute());
+  EXPECT_TRUE(instance.nextSolution(bindings));
+  EXPECT_EQ(Term(4), bindings["Length"]);
+  instance.close();
+  
+  swi::PreparedQuery parsedQuery("atom_length(Atom, Length)", {"Atom"});
+  
+  EXPECT_TRUE(parsedQuery.execute({Atom("abcde")}));
+  EXPECT_TRUE(parsedQuery.nextSolution(bindings));
+  EXPECT_EQ(Term(5), bindings["Length"]);
+  parsedQuery.close();
+  
+  swi::PreparedQuery repeatedQuery("==", {Variable("Obj"), Variable("Obj")},
+    {"Obj"});
+  
+  EXPECT_TRUE(repeatedQuery.execute({Atom("a")}));
+  EXPECT_TRUE(repeatedQuery.nextSolution(bindings));
+}
+
+TEST(Prolog, HandleCache) {
+  swi::Context context;
+  Bindings bindings;
+  
+  EXPECT_TRUE(context.init());
+  
+  EXPECT_EQ(swi::HandleCache::getAtom("abc"),
+    swi::HandleCache::getAtom(Atom("abc").getSymbol().getIdentifier()));
+  EXPECT_EQ(swi::HandleCache::getFunctor("f", 2),
+    swi::HandleCache::getFunctor("f", 2));
+  EXPECT_NE(swi::HandleCache::getFunctor("f", 2),
+    swi::HandleCache::getFunctor("f", 3));
+  
+  swi::Query("sort", {{"b", "a"}, "List"}).open();
+  size_t numPredicates = swi::HandleCache::getNumPredicates();
+  
+  swi::Query query("sort", {{"b", "a"}, "List"});
+  
+  EXPECT_TRUE(query.open());
+  EXPECT_TRUE(query.nextSolution(bindings));
+  EXPECT_EQ(numPredicates, swi::HandleCache::getNumPredicates());
+}
+
+TEST(Prolog, LazyBindingsQuery) {
+  swi::Context context;
+  Bindings bindings;
+  
+  EXPECT_TRUE(context.init());
+  
+  swi::Query query("msort", {{"c", "b", "a"}, "List"});
+  
+  query.setLazyBindings(true);
+  EXPECT_TRUE(query.hasLazyBindings());
+  
+  EXPECT_TRUE(query.open());
+  EXPECT_TRUE(query.nextSolution(bindings));
+  EXPECT_TRUE(bindings.areLazy());
+  EXPECT_TRUE(bindings.contain("List"));
+  EXPECT_TRUE(bindings["List"].isList());
+  EXPECT_FALSE(bindings.areLazy());
+  EXPECT_EQ(3, List(bindings["List"]).getNumElements());
+}
+
+TEST(Prolog, BindingsSnapshotQuery) {
+  swi::Context context;
+  BindingsSnapshot snapshot;
+  
+  EXPECT_TRUE(context.init());
+  
+  swi::Query query("msort", {{"c", 2, "a"}, "List"});
+  
+  EXPECT_TRUE(query.open());
+  EXPECT_TRUE(query.nextSolution(snapshot));
+  query.close();
+  
+  Bindings bindings = snapshot.decode();
+  
+  EXPECT_TRUE(bindings.contain("List"));
+  EXPECT_EQ(Term(List({2, "a", "c"})), bindings["List"]);
+}
+
+TEST(Prolog, JSONBindingsWriterQuery) {
+  swi::Context context;
+  serialization::JSONBindingsWriter writer;
+  
+  EXPECT_TRUE(context.init());
+  
+  swi::Query query("msort", {{"c", 2, "a"}, "List"});
+  
+  EXPECT_TRUE(query.open());
+  EXPECT_TRUE(query.nextSolution(writer));
+  query.close();
+  
+  EXPECT_EQ("{\"List\":[2,\"a\",\"c\"]}", writer.getOutput());
+}
+
+TEST(Prolog, LocalStackHighWaterMark) {
+  swi::Context context;
+  
+  EXPECT_TRUE(context.init());
+  
+  swi::Query query("between", {1, 10000, "X"});
+  BindingsSnapshot snapshot;
+  size_t numSolutions = 0;
+  size_t highWaterMark = 0;
+  
+  query.setLocalStackMonitoring(true);
+  EXPECT_TRUE(query.isLocalStackMonitored());
+  
+  EXPECT_TRUE(query.open());
+  
+  while (query.nextSolution(snapshot)) {
+    if (++numSolutions == 10)
+      highWaterMark = query.getLocalStackHighWaterMark();
+  }
+  
+  query.close();
+  
+  EXPECT_EQ(10000, numSolutions);
+  EXPECT_LT(0, highWaterMark);
+  EXPECT_GE(highWaterMark+1024, query.getLocalStackHighWaterMark());
+}
@@ -0,0 +1,86 @@
+/******************************************************************************
+ * Copyright (C) 2016 by Ralf Kaestner                                        *
+ * ralf.kaestner@gmail.com                                                    *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the               *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+#include <string>
+
+#include <boost/lexical_cast.hpp>
+#include <boost/thread/thread.hpp>
+
+#include <gtest/gtest.h>
+
+#include <prolog_server/Registry.h>
+
+using namespace prolog::server;
+
+TEST(Prolog, Registry) {
+  Registry<int> registry(4);
+  int value = 0;
+  
+  EXPECT_EQ(4, registry.getNumShards());
+  EXPECT_TRUE(registry.insert("a", 1));
+  EXPECT_TRUE(registry.insert("b", 2));
+  EXPECT_FALSE(registry.insert("a", 3));
+  EXPECT_EQ(2, registry.getNumEntries());
+  
+  EXPECT_TRUE(registry.find("a", value));
+  EXPECT_EQ(1, value);
+  EXPECT_FALSE(registry.find("c", value));
+  EXPECT_EQ(1, value);
+  
+  Registry<int> shared(registry);
+  
+  EXPECT_TRUE(shared.erase("a", value));
+  EXPECT_EQ(1, value);
+  EXPECT_FALSE(registry.find("a", value));
+  EXPECT_FALSE(registry.erase("a"));
+  EXPECT_TRUE(registry.erase("b"));
+  EXPECT_EQ(0, shared.getNumEntries());
+  
+  registry.insert("c", 3);
+  shared.clear();
+  EXPECT_EQ(0, registry.getNumEntries());
+  EXPECT_EQ(1, Registry<int>(0).getNumShards());
+}
+
+TEST(Prolog, ConcurrentRegistry) {
+  Registry<size_t> registry;
+  boost::thread_group threads;
+  const size_t numThreads = 8;
+  const size_t numEntries = 1000;
+  
+  for (size_t thread = 0; thread < numThreads; ++thread) {
+    threads.create_thread([&registry, thread, numEntries]() {
+      for (size_t index = 0; index < numEntries; ++index) {
+        std::string identifier = boost::lexical_cast<std::string>(thread)+
+          "/"+boost::lexical_cast<std::string>(index);
+        size_t value = 0;
+        
+        registry.insert(identifier, index);
+        
+        if (!registry.find(identifier, value) || (value != index))
+          ADD_FAILURE() << "Entry [" << identifier << "] not found.";
+        
+        if ((index % 2) && !registry.erase(identifier))
+          ADD_FAILURE() << "Entry [" << identifier << "] not erased.";
+      }
+    });
+  }
+  
+  threads.join_all();
+  EXPECT_EQ(numThreads*numEntries/2, registry.getNumEntries());
+}
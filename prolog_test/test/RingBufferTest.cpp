@@ -0,0 +1,111 @@
+/******************************************************************************
+ * Copyright (C) 2016 by Ralf Kaestner                                        *
+ * ralf.kaestner@gmail.com                                                    *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the               *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+#include <boost/make_shared.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/weak_ptr.hpp>
+
+#include <gtest/gtest.h>
+
+#include <prolog_server/RingBuffer.h>
+
+using namespace prolog::server;
+
+TEST(Prolog, RingBuffer) {
+  EXPECT_EQ(1, RingBuffer<int>(0).getCapacity());
+  EXPECT_EQ(1, RingBuffer<int>(1).getCapacity());
+  EXPECT_EQ(8, RingBuffer<int>(5).getCapacity());
+  EXPECT_EQ(64, RingBuffer<int>(64).getCapacity());
+  
+  RingBuffer<int> buffer(4);
+  int value = 0;
+  
+  EXPECT_TRUE(buffer.isEmpty());
+  EXPECT_FALSE(buffer.pop(value));
+  
+  for (int index = 0; index < 4; ++index)
+    EXPECT_TRUE(buffer.push(index));
+  
+  EXPECT_TRUE(buffer.isFull());
+  EXPECT_EQ(4, buffer.getSize());
+  EXPECT_FALSE(buffer.push(4));
+  
+  for (int index = 0; index < 10; ++index) {
+    EXPECT_TRUE(buffer.pop(value));
+    EXPECT_EQ(index, value);
+    EXPECT_TRUE(buffer.push(index+4));
+    EXPECT_EQ(4, buffer.getSize());
+  }
+  
+  for (int index = 10; index < 14; ++index) {
+    EXPECT_TRUE(buffer.pop(value));
+    EXPECT_EQ(index, value);
+  }
+  
+  EXPECT_TRUE(buffer.isEmpty());
+  EXPECT_FALSE(buffer.pop(value));
+  EXPECT_EQ(13, value);
+}
+
+TEST(Prolog, RingBufferSlotReset) {
+  RingBuffer<boost::shared_ptr<int> > buffer(2);
+  boost::shared_ptr<int> value = boost::make_shared<int>(42);
+  boost::weak_ptr<int> observer = value;
+  
+  EXPECT_TRUE(buffer.push(value));
+  value.reset();
+  EXPECT_FALSE(observer.expired());
+  
+  EXPECT_TRUE(buffer.pop(value));
+  EXPECT_EQ(42, *value);
+  value.reset();
+  EXPECT_TRUE(observer.expired());
+}
+
+TEST(Prolog, ConcurrentRingBuffer) {
+  RingBuffer<size_t> buffer(16);
+  const size_t numValues = 100000;
+  size_t numErrors = 0;
+  
+  boost::thread producer([&buffer, numValues]() {
+    for (size_t index = 0; index < numValues; ) {
+      if (buffer.push(index))
+        ++index;
+      else
+        boost::this_thread::yield();
+    }
+  });
+  
+  for (size_t index = 0; index < numValues; ) {
+    size_t value;
+    
+    if (buffer.pop(value)) {
+      if (value != index)
+        ++numErrors;
+      ++index;
+    }
+    else
+      boost::this_thread::yield();
+  }
+  
+  producer.join();
+  
+  EXPECT_EQ(0, numErrors);
+  EXPECT_TRUE(buffer.isEmpty());
+}
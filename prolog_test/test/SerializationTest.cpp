@@ -21,11 +21,19 @@
 #include <gtest/gtest.h>
 
 #include <prolog_common/Bindings.h>
+#include <prolog_common/BindingsSnapshot.h>
+#include <prolog_common/Compound.h>
+#include <prolog_common/List.h>
 #include <prolog_common/Query.h>
+#include <prolog_common/String.h>
 #include <prolog_common/Term.h>
+#include <prolog_common/TermArena.h>
+#include <prolog_common/TermFactory.h>
 
+#include <prolog_serialization/JSONBindingsWriter.h>
 #include <prolog_serialization/JSONDeserializer.h>
 #include <prolog_serialization/JSONSerializer.h>
+#include <prolog_serialization/PrologSerializer.h>
 
 using namespace prolog;
 
@@ -45,6 +53,10 @@ TEST(Prolog, Serialization) {
   istream.clear();
   EXPECT_TRUE(deserializer.deserializeTerm(istream).isVariable());
   
+  serializer.serializeTerm(ostream, String("Some \"text\""));
+  istream.clear();
+  EXPECT_EQ(String("Some \"text\""), deserializer.deserializeTerm(istream));
+  
   serializer.serializeTerm(ostream, 42);
   istream.clear();
   EXPECT_TRUE(deserializer.deserializeTerm(istream).isNumber());
@@ -57,6 +69,10 @@ TEST(Prolog, Serialization) {
   istream.clear();
   EXPECT_TRUE(deserializer.deserializeTerm(istream).isList());
   
+  serializer.serializeTerm(ostream, List(std::vector<Term>(1, "a"), "T"));
+  istream.clear();
+  EXPECT_TRUE(List(deserializer.deserializeTerm(istream)).isPartial());
+  
   serializer.serializeTerm(ostream, Term("f", {"a", "b"}));
   istream.clear();
   EXPECT_TRUE(deserializer.deserializeTerm(istream).isCompound());
@@ -76,4 +92,74 @@ TEST(Prolog, Serialization) {
   serializer.serializeBindings(ostream, bindings);
   istream.clear();
   EXPECT_FALSE(deserializer.deserializeBindings(istream).areEmpty());
+  
+  TermArena arena;
+  
+  serializer.serializeBindings(ostream, bindings);
+  istream.clear();
+  bindings = deserializer.deserializeBindings(istream, arena);
+  EXPECT_TRUE(bindings.isArenaBacked());
+  EXPECT_TRUE(bindings["List"].isList());
+  EXPECT_EQ(2, List(bindings["List"]).getNumElements());
+  EXPECT_EQ("f", Compound(bindings["Compound"]).getFunctor());
+  EXPECT_LT(0, arena.getNumBytes());
+  
+  TermFactory factory;
+  
+  bindings = Bindings();
+  bindings.addTerm("X", Term("f", {"a", {"b"}}));
+  bindings.addTerm("Y", Term("f", {"a", {"b"}}));
+  serializer.serializeBindings(ostream, bindings);
+  istream.clear();
+  bindings = deserializer.deserializeBindings(istream, factory);
+  EXPECT_EQ(bindings["X"], bindings["Y"]);
+  EXPECT_EQ(&Compound(bindings["X"]).getArgument(0),
+    &Compound(bindings["Y"]).getArgument(0));
+  EXPECT_EQ(2, factory.getNumTerms());
+  
+  std::ostringstream stream;
+  serialization::PrologSerializer prologSerializer;
+  
+  prologSerializer.serializeTerm(stream, Term("f", {String("a \"b\""),
+    List(std::vector<Term>{1, "X"}, "T")}));
+  EXPECT_EQ("f(\"a \\\"b\\\"\", [1, X|T])", stream.str());
+}
+
+TEST(Prolog, JSONBindingsWriter) {
+  BindingsSchema schema({Symbol("X"), Symbol("Y"), Symbol("Z")});
+  BindingsSnapshot snapshot(schema);
+  
+  snapshot.putCompound("f", 1, 3);
+  snapshot.putAtom("a \"b\"", 5);
+  snapshot.putList(2, true);
+  snapshot.putInteger(-42);
+  snapshot.putFloat(42.0);
+  snapshot.putVariable("T", 1);
+  snapshot.putString("s\n", 2);
+  snapshot.putUnbound();
+  snapshot.putList(0);
+  
+  serialization::JSONBindingsWriter writer;
+  serialization::JSONDeserializer deserializer;
+  
+  snapshot.replay(writer);
+  EXPECT_EQ("{\"X\":{\"functor\":\"f\",\"arguments\":[\"a \\\"b\\\"\","
+    "{\"functor\":\"[|]\",\"arguments\":[-42,{\"functor\":\"[|]\","
+    "\"arguments\":[42.0,\"T\"]}]},{\"string\":\"s\\n\"}]},\"Z\":[]}",
+    writer.getOutput());
+  
+  std::stringstream stream;
+  serialization::JSONSerializer serializer;
+  
+  serializer.serializeBindings(stream, snapshot.decode());
+  Bindings bindings = deserializer.deserializeBindings(stream);
+  
+  stream.clear();
+  stream.str(writer.getOutput());
+  EXPECT_EQ(bindings, deserializer.deserializeBindings(stream));
+  EXPECT_FALSE(bindings.contain("Y"));
+  
+  writer.clear();
+  BindingsSnapshot().replay(writer);
+  EXPECT_TRUE(writer.getOutput().empty());
 }
@@ -19,6 +19,8 @@
 #include <gtest/gtest.h>
 
 #include <prolog_common/Solution.h>
+#include <prolog_common/SolutionAccessor.h>
+#include <prolog_common/String.h>
 
 using namespace prolog;
 
@@ -26,6 +28,7 @@ TEST(Prolog, Solution) {
   Bindings bindings;
   
   bindings.addTerm("Atom", "atom");
+  bindings.addTerm("String", String("string"));
   bindings.addTerm("Integer", 42);
   bindings.addTerm("Float", 42.0);
   bindings.addTerm("List", {0, 1, 2});
@@ -35,6 +38,9 @@ TEST(Prolog, Solution) {
   EXPECT_EQ("atom", solution.getValue<std::string>("Atom"));
   EXPECT_ANY_THROW(solution.getValue<int>("Atom"));
   
+  EXPECT_EQ("string", solution.getValue<std::string>("String"));
+  EXPECT_ANY_THROW(solution.getValue<int>("String"));
+  
   EXPECT_EQ(42, solution.getValue<int>("Integer"));
   EXPECT_EQ(42, solution.getValue<int64_t>("Integer"));
   EXPECT_EQ(42, solution.getValue<unsigned int>("Integer"));
@@ -58,3 +64,39 @@ TEST(Prolog, Solution) {
   EXPECT_ANY_THROW(solution.getValue<double>("List"));  
   EXPECT_ANY_THROW(solution.getValue<std::string>("List"));  
 }
+
+TEST(Prolog, SolutionAccessor) {
+  BindingsSchema schema({Symbol("X"), Symbol("Y")});
+  std::vector<Solution> solutions;
+  
+  for (int index = 0; index < 10; ++index) {
+    Bindings bindings(schema);
+    
+    bindings.setTerm(0, index);
+    bindings.setTerm(1, 0.5*index);
+    solutions.push_back(Solution(bindings));
+  }
+  
+  SolutionAccessor<int64_t> x("X");
+  SolutionAccessor<double> y(schema, 1);
+  
+  EXPECT_EQ(3, x(solutions[3]));
+  EXPECT_EQ(1.5, y.getValue(solutions[3]));
+  EXPECT_EQ(Symbol("Y"), y.getName());
+  
+  std::vector<int64_t> xs = x.getValues(solutions);
+  std::vector<double> ys;
+  
+  y.getValues(solutions.begin(), solutions.end(), ys);
+  ASSERT_EQ(10, xs.size());
+  ASSERT_EQ(10, ys.size());
+  EXPECT_EQ(9, xs.back());
+  EXPECT_EQ(4.5, ys.back());
+  
+  Bindings bindings;
+  
+  bindings.addTerm("Y", 42);
+  EXPECT_EQ(42, SolutionAccessor<int>("Y")(Solution(bindings)));
+  EXPECT_ANY_THROW(x(Solution(bindings)));
+  EXPECT_ANY_THROW(SolutionAccessor<std::string>("X")(solutions[0]));
+}
@@ -0,0 +1,564 @@
+/******************************************************************************
+ * Copyright (C) 2014 by Ralf Kaestner                                        *
+ * ralf.kaestner@gmail.com                                                    *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the               *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+#include <cmath>
+#include <limits>
+#include <unordered_map>
+
+#include <boost/range/distance.hpp>
+
+#include <gtest/gtest.h>
+
+#include <prolog_common/Atom.h>
+#include <prolog_common/Bindings.h>
+#include <prolog_common/BindingsSchema.h>
+#include <prolog_common/BindingsSnapshot.h>
+#include <prolog_common/Compound.h>
+#include <prolog_common/Float.h>
+#include <prolog_common/GoalExpression.h>
+#include <prolog_common/Integer.h>
+#include <prolog_common/List.h>
+#include <prolog_common/Query.h>
+#include <prolog_common/String.h>
+#include <prolog_common/SymbolTable.h>
+#include <prolog_common/TermArena.h>
+#include <prolog_common/TermFactory.h>
+#include <prolog_common/TermVisitor.h>
+#include <prolog_common/TermWalker.h>
+#include <prolog_common/Variable.h>
+
+using namespace prolog;
+
+TEST(Prolog, Term) {
+  EXPECT_FALSE(Term().isValid());
+  EXPECT_EQ(Term::InvalidType, Term().getType());
+  
+  EXPECT_EQ(Term::AtomType, Term("atom").getType());
+  EXPECT_EQ(Term::VariableType, Term("Var").getType());
+  EXPECT_EQ(Term::IntegerType, Term(42).getType());
+  EXPECT_EQ(Term::FloatType, Term(42.0).getType());
+  EXPECT_EQ(Term::ListType, Term({"a", "b"}).getType());
+  EXPECT_EQ(Term::CompoundType, Term("f", {"a", "b"}).getType());
+  
+  EXPECT_TRUE(Term(42).isNumber());
+  EXPECT_TRUE(Term(42.0).isNumber());
+  EXPECT_TRUE(Number(Term(42)).isInteger());
+  EXPECT_TRUE(Number(Term(42.0)).isFloat());
+  
+  EXPECT_EQ("atom", Atom(Term("atom")).getName());
+  EXPECT_EQ("Var", Variable(Term("Var")).getName());
+  EXPECT_EQ(42, Integer(Term(42)).getValue());
+  EXPECT_EQ(42.0, Float(Term(42.0)).getValue());
+  EXPECT_EQ(2, List(Term({"a", "b"})).getNumElements());
+  EXPECT_EQ("f", Compound(Term("f", {"a", "b"})).getFunctor());
+  EXPECT_EQ(2, Compound(Term("f", {"a", "b"})).getArity());
+  
+  Term term = Integer(-1);
+  
+  term = Float(0.5);
+  EXPECT_TRUE(term.isNumber());
+  EXPECT_EQ(0.5, Float(term).getValue());
+  
+  Compound compound("f", std::vector<Term>{"a", {"b", "c"}});
+  
+  EXPECT_EQ(&compound.getArguments(), &compound.getArguments());
+  EXPECT_EQ(&*compound.begin(), &compound.getArgument(0));
+  EXPECT_EQ(2, boost::distance(List(compound.getArgument(1)).
+    getElements()));
+  
+  Term moved(std::move(term));
+  
+  EXPECT_TRUE(moved.isNumber());
+  EXPECT_FALSE(term.isValid());
+  
+  term = std::move(compound);
+  EXPECT_TRUE(term.isCompound());
+}
+
+TEST(Prolog, List) {
+  List list({"a", "b", "c"});
+  List shared = List("x", list);
+  
+  EXPECT_EQ(3, list.getNumElements());
+  EXPECT_EQ(4, shared.getNumElements());
+  EXPECT_EQ("x", Atom(*shared.begin()).getName());
+  
+  List concatenated = list+shared;
+  
+  concatenated.append("d");
+  EXPECT_EQ(8, concatenated.getNumElements());
+  EXPECT_EQ(3, list.getNumElements());
+  EXPECT_EQ(4, shared.getNumElements());
+  EXPECT_FALSE(list.isPartial());
+  
+  List partial(std::vector<Term>(1, "a"), "T");
+  
+  EXPECT_TRUE(partial.isPartial());
+  EXPECT_EQ(1, partial.getNumElements());
+  EXPECT_EQ("T", Variable(partial.getTail()).getName());
+  EXPECT_TRUE(List("x", partial).isPartial());
+  
+  List emptyPartial(std::vector<Term>(), "T");
+  
+  EXPECT_TRUE(emptyPartial.isPartial());
+  EXPECT_NE(List(), emptyPartial);
+  EXPECT_NE(0, emptyPartial.compare(List()));
+  EXPECT_NE(0, List().compare(emptyPartial));
+  EXPECT_EQ(0, emptyPartial.compare(List(std::vector<Term>(), "T")));
+  
+  partial.setTail(Term());
+  EXPECT_FALSE(partial.isPartial());
+  
+  List prepended;
+  
+  for (size_t index = 0; index < 1000000; ++index)
+    prepended = List("a", prepended);
+  EXPECT_EQ(1000000, prepended.getNumElements());
+  prepended = List();
+}
+
+TEST(Prolog, TermComparison) {
+  EXPECT_EQ(Term("f", {"a", 1, {"b"}}), Term("f", {"a", 1, {"b"}}));
+  EXPECT_NE(Term("f", {"a", 1}), Term("f", {"a", 1.0}));
+  EXPECT_NE(Term("f", {"a"}), Term("g", {"a"}));
+  EXPECT_EQ(Term({"a", "b"}), List({"a"})+List({"b"}));
+  EXPECT_EQ(Term("f", {"a", 1}).getHash(), Term("f", {"a", 1}).getHash());
+  
+  EXPECT_LT(Term("X"), Term(1.0));
+  EXPECT_LT(Term(1.0), Term(1));
+  EXPECT_LT(Term(1), Term(2.5));
+  EXPECT_LT(Term(2.5), Term("a"));
+  EXPECT_LT(Term("a"), Term("b"));
+  EXPECT_LT(Term("b"), Term("f", {"a"}));
+  EXPECT_LT(Term("g", {"a"}), Term("f", {"a", "b"}));
+  EXPECT_LT(Term("f", {"a", "b"}), Term("f", {"a", "c"}));
+  EXPECT_LT(Term({"a"}), Term({"a", "b"}));
+  EXPECT_EQ(0, Term({"a", 1}).compare(Term({"a", 1})));
+  
+  double nan = std::numeric_limits<double>::quiet_NaN();
+  
+  EXPECT_NE(Term(-0.0), Term(0.0));
+  EXPECT_LT(Term(-0.0), Term(0.0));
+  EXPECT_EQ(Term(nan), Term(nan));
+  EXPECT_EQ(0, Term(nan).compare(Term(nan)));
+  EXPECT_LT(Term(nan), Term(0.0));
+  EXPECT_EQ(Term("f", {nan}).getHash(), Term("f", {nan}).getHash());
+  
+  Term outer("f", {Term("g", {"a"})});
+  Compound inner(Compound(outer).getArgument(0));
+  
+  EXPECT_NE(0, outer.getHash());
+  *inner.begin() = "b";
+  EXPECT_EQ(Term("f", {Term("g", {"a"})}), outer);
+  EXPECT_EQ(Term("g", {"b"}), inner);
+  EXPECT_EQ(Term("g", {"b"}).getHash(), inner.getHash());
+  
+  std::unordered_map<Term, int> terms;
+  
+  terms[Term("f", {"a", "X"})] = 1;
+  terms[Term({"a", "b"})] = 2;
+  EXPECT_EQ(1, terms[Term("f", {"a", "X"})]);
+  EXPECT_EQ(2, terms[Term({"a", "b"})]);
+  EXPECT_EQ(2, terms.size());
+  
+  Bindings bindings;
+  Bindings otherBindings;
+  
+  bindings.addTerm("X", "a");
+  bindings.addTerm("Y", Term("f", {1}));
+  otherBindings.addTerm("Y", Term("f", {1}));
+  otherBindings.addTerm("X", "a");
+  EXPECT_EQ(bindings, otherBindings);
+  EXPECT_EQ(bindings.getHash(), otherBindings.getHash());
+  
+  EXPECT_EQ(Query("p", {"a", "X"}), Query("p", {"a", "X"}));
+  EXPECT_NE(Query("p", {"a", "X"}), Query("q", {"a", "X"}));
+  EXPECT_EQ(Query("p", {"a"}).getHash(), Query("p", {"a"}).getHash());
+}
+
+TEST(Prolog, String) {
+  String string("some text");
+  
+  EXPECT_TRUE(string.isString());
+  EXPECT_EQ(Term::StringType, string.getType());
+  EXPECT_EQ("some text", string.getValue());
+  
+  EXPECT_EQ(String("a"), String(std::string("a")));
+  EXPECT_EQ(String("a").getHash(), String(std::string("a")).getHash());
+  EXPECT_NE(Term("a"), String("a"));
+  EXPECT_LT(String("a"), String("b"));
+  EXPECT_LT(Term("z"), String("a"));
+  EXPECT_LT(String("z"), Term("f", {"a"}));
+}
+
+TEST(Prolog, Symbol) {
+  EXPECT_FALSE(Symbol().isValid());
+  EXPECT_TRUE(Symbol("atom").isValid());
+  
+  EXPECT_EQ(Symbol("atom"), Symbol("atom"));
+  EXPECT_NE(Symbol("atom"), Symbol("other"));
+  EXPECT_EQ("atom", Symbol("atom").getName());
+  EXPECT_EQ(Symbol("atom"), Atom("atom").getSymbol());
+  
+  size_t atom;
+  
+  EXPECT_TRUE(SymbolTable::lookupAtom("atom", atom));
+  EXPECT_EQ(Symbol("atom").getIdentifier(), atom);
+  EXPECT_FALSE(SymbolTable::lookupAtom("never_interned_atom", atom));
+  
+  size_t numAtoms = SymbolTable::getNumAtoms();
+  
+  EXPECT_LT(numAtoms, SymbolTable::getCapacity());
+  EXPECT_EQ("never interned text", String("never interned text").getValue());
+  EXPECT_EQ(numAtoms, SymbolTable::getNumAtoms());
+  
+  size_t functor = SymbolTable::internFunctor("f", 2);
+  
+  EXPECT_EQ(functor, Compound(Term("f", {"a", "b"})).getFunctorIdentifier());
+  EXPECT_NE(functor, SymbolTable::internFunctor("f", 3));
+  EXPECT_EQ(2, SymbolTable::getFunctorArity(functor));
+  EXPECT_EQ(Symbol("f").getIdentifier(), SymbolTable::getFunctorAtom(
+    functor));
+  
+  Bindings bindings;
+  
+  bindings.addTerm("X", "atom");
+  EXPECT_TRUE(bindings.contain("X"));
+  EXPECT_TRUE(bindings.contain(Symbol("X")));
+  EXPECT_FALSE(bindings.contain("Y"));
+  EXPECT_EQ("atom", Atom(bindings.getTerm("X")).getName());
+}
+
+TEST(Prolog, BindingsSchema) {
+  BindingsSchema schema({Symbol("X"), Symbol("Y")});
+  size_t slot;
+  
+  EXPECT_EQ(2, schema.getNumSlots());
+  EXPECT_TRUE(schema.lookupSlot(Symbol("Y"), slot));
+  EXPECT_EQ(1, slot);
+  EXPECT_FALSE(schema.lookupSlot(Symbol("Z"), slot));
+  
+  Bindings bindings(schema);
+  Bindings otherBindings(schema);
+  
+  EXPECT_TRUE(bindings.areEmpty());
+  bindings.setTerm(1, "b");
+  bindings.setTerm(0, "a");
+  otherBindings.setTerm(1, 42);
+  
+  EXPECT_EQ(2, bindings.getNumTerms());
+  EXPECT_EQ("a", Atom(bindings["X"]).getName());
+  EXPECT_TRUE(otherBindings.contain("Y"));
+  EXPECT_FALSE(otherBindings.contain("X"));
+  EXPECT_EQ(Symbol("Y"), otherBindings.begin()->first);
+  
+  bindings.addTerm("Z", "c");
+  EXPECT_EQ(3, bindings.getSchema().getNumSlots());
+  EXPECT_EQ(2, schema.getNumSlots());
+  
+  size_t numTerms = 0;
+  for (Bindings::ConstIterator it = bindings.begin(); it != bindings.end();
+      ++it, ++numTerms)
+    EXPECT_TRUE(it->second.isAtom());
+  EXPECT_EQ(3, numTerms);
+}
+
+class CountingMaterializer :
+  public Bindings::Materializer {
+public:
+  CountingMaterializer() :
+    numMaterialized_(0) {
+  }
+  
+  bool isBound(size_t slot) const {
+    return slot != 1;
+  }
+  
+  Term materialize(size_t slot) const {
+    ++numMaterialized_;
+    
+    return Integer(slot);
+  }
+  
+  mutable size_t numMaterialized_;
+};
+
+TEST(Prolog, LazyBindings) {
+  BindingsSchema schema({Symbol("X"), Symbol("Y"), Symbol("Z")});
+  boost::shared_ptr<CountingMaterializer> materializer(
+    new CountingMaterializer());
+  Bindings bindings(schema, materializer);
+  
+  EXPECT_TRUE(bindings.areLazy());
+  EXPECT_EQ(2, bindings.getNumTerms());
+  EXPECT_TRUE(bindings.contain("Z"));
+  EXPECT_FALSE(bindings.contain("Y"));
+  EXPECT_EQ(0, materializer->numMaterialized_);
+  
+  EXPECT_EQ(Term(2), bindings["Z"]);
+  EXPECT_EQ(Term(2), bindings["Z"]);
+  EXPECT_EQ(1, materializer->numMaterialized_);
+  
+  bindings.setTerm(0, "a");
+  EXPECT_FALSE(bindings.areLazy());
+  EXPECT_EQ(1, materializer->numMaterialized_);
+  EXPECT_EQ(2, bindings.getNumTerms());
+}
+
+TEST(Prolog, BindingsSnapshot) {
+  BindingsSchema schema({Symbol("X"), Symbol("Y"), Symbol("Z")});
+  BindingsSnapshot snapshot(schema);
+  
+  snapshot.putCompound("f", 1, 3);
+  snapshot.putAtom("a", 1);
+  snapshot.putList(2, true);
+  snapshot.putInteger(42);
+  snapshot.putFloat(0.5);
+  snapshot.putVariable("T", 1);
+  snapshot.putString("s", 1);
+  snapshot.putUnbound();
+  snapshot.putList(0);
+  
+  Bindings bindings = snapshot.decode();
+  
+  EXPECT_EQ(2, bindings.getNumTerms());
+  EXPECT_FALSE(bindings.contain("Y"));
+  EXPECT_EQ(Term(Compound("f", std::vector<Term>{Atom("a"),
+    List(std::vector<Term>{42, 0.5}, Variable("T")), String("s")})),
+    bindings["X"]);
+  EXPECT_EQ(Term(List()), bindings["Z"]);
+  
+  BindingsSnapshot truncatedSnapshot(schema);
+  
+  truncatedSnapshot.putCompound("f", 1, 2);
+  truncatedSnapshot.putAtom("a", 1);
+  
+  EXPECT_THROW(truncatedSnapshot.decode(), BindingsSnapshot::DecodingError);
+  
+  BindingsSnapshot deepSnapshot(BindingsSchema({Symbol("X")}));
+  BindingsSnapshot replayedSnapshot;
+  
+  for (size_t depth = 0; depth < 1000000; ++depth)
+    deepSnapshot.putCompound("s", 1, 1);
+  deepSnapshot.putAtom("z", 1);
+  
+  deepSnapshot.replay(replayedSnapshot);
+  EXPECT_EQ(deepSnapshot.getSize(), replayedSnapshot.getSize());
+  
+  BindingsSnapshot nestedSnapshot(BindingsSchema({Symbol("X")}));
+  
+  for (size_t depth = 0; depth < 1000; ++depth)
+    nestedSnapshot.putCompound("s", 1, 1);
+  nestedSnapshot.putList(0);
+  
+  Term nested = nestedSnapshot.decode()["X"];
+  
+  for (size_t depth = 0; depth < 1000; ++depth)
+    nested = Compound(nested).getArgument(0);
+  EXPECT_EQ(Term(List()), nested);
+}
+
+TEST(Prolog, GoalExpression) {
+  Term expected("';'", {
+    Term("','", {Term("p", {"X"}), Term("','", {Term("q", {1, 2.0}), "r"})}),
+    Term("s", {Term("t", {"a"})})
+  });
+  
+  auto expression = (goal("p", "X") & goal("q", 1, 2.0) & goal("r")) |
+    goal("s", goal("t", "a"));
+  
+  EXPECT_EQ(expected, expression.toTerm());
+  EXPECT_EQ(Term("a") & Term("b"), (Term("a") & goal("b")).toTerm());
+  EXPECT_EQ(Term("a") | Term("b"), (goal("a") | Term("b")).toTerm());
+  
+  TermArena arena;
+  Term term = expression.toTerm(arena);
+  
+  EXPECT_EQ(expected, term);
+  EXPECT_LT(0, arena.getNumBytes());
+}
+
+struct TraceVisitor :
+  public TermVisitor {
+  void visitAtom(const Atom& atom) {
+    trace += atom.getName()+" ";
+  }
+  
+  void visitCompound(const Compound& compound) {
+    trace += compound.getFunctor()+"( ";
+  }
+  
+  void visitInteger(const Integer& number) {
+    trace += std::to_string(number.getValue())+" ";
+  }
+  
+  void visitList(const List& list) {
+    trace += "[ ";
+  }
+  
+  void visitVariable(const Variable& variable) {
+    trace += variable.getName()+" ";
+  }
+  
+  void leaveCompound(const Compound& compound) {
+    trace += ") ";
+  }
+  
+  void leaveList(const List& list) {
+    trace += "] ";
+  }
+  
+  std::string trace;
+};
+
+TEST(Prolog, TermWalker) {
+  TraceVisitor visitor;
+  TermWalker walker;
+  
+  Term("a").accept(visitor);
+  Term("f", {"b"}).accept(visitor);
+  EXPECT_EQ("a f( ", visitor.trace);
+  
+  visitor.trace.clear();
+  walker.walk(Term("f", {"a", List(std::vector<Term>{1, "X"}, "T"), Term("g", {"b"})}),
+    visitor);
+  EXPECT_EQ("f( a [ 1 X T ] g( b ) ) ", visitor.trace);
+  
+  Term term = "a";
+  for (size_t index = 0; index < 10000; ++index)
+    term = Term("','", {"b", term});
+  
+  visitor.trace.clear();
+  walker.walk(term, visitor);
+  EXPECT_EQ(10000*9+2, visitor.trace.size());
+}
+
+TEST(Prolog, TermArena) {
+  Term term, argument, element;
+  
+  {
+    TermArena arena(256);
+    std::vector<Term> elements;
+    
+    for (int index = 0; index < 100; ++index)
+      elements.push_back(index);
+    
+    List list = arena.createList(elements, arena.createVariable("T"));
+    Compound compound = arena.createCompound("f", {"a", list,
+      arena.createVariable("X")});
+    
+    EXPECT_EQ("f", compound.getFunctor());
+    EXPECT_EQ(3, compound.getArity());
+    EXPECT_EQ(100, List(compound.getArguments()[1]).getNumElements());
+    EXPECT_TRUE(List(compound.getArguments()[1]).isPartial());
+    EXPECT_TRUE(compound.getArguments()[2].isVariable());
+    EXPECT_LT(256, arena.getNumBytes());
+    
+    term = compound;
+    argument = Compound(term).getArgument(1);
+    element = *++List(argument).begin();
+  }
+  
+  EXPECT_TRUE(term.isCompound());
+  EXPECT_EQ(100, List(Compound(term).getArguments()[1]).getNumElements());
+  
+  term = Term();
+  
+  EXPECT_EQ(100, List(argument).getNumElements());
+  EXPECT_EQ("T", Variable(List(argument).getTail()).getName());
+  EXPECT_EQ(Term(1), element);
+  
+  List copy(argument);
+  copy.setTail(Term());
+  copy.append(100);
+  
+  argument = Term();
+  
+  EXPECT_EQ(101, copy.getNumElements());
+  EXPECT_EQ(Term(50), *std::next(copy.begin(), 50));
+  
+  Bindings bindings;
+  
+  {
+    TermArena arena;
+    bindings = Bindings(arena);
+    bindings.addTerm("X", arena.createCompound("g", {arena.createCompound(
+      "h", {"b"})}));
+  }
+  
+  for (Bindings::ConstIterator it = bindings.begin(); it != bindings.end();
+      ++it)
+    term = Compound((*it).second).getArgument(0);
+  
+  bindings = Bindings();
+  
+  EXPECT_EQ(Term("h", {"b"}), term);
+}
+
+TEST(Prolog, TermFactory) {
+  TermFactory factory;
+  
+  Compound compound = factory.createCompound("f", {"a", 1});
+  Compound otherCompound = factory.canonicalize(Term("f", {"a", 1}));
+  
+  EXPECT_EQ(compound, otherCompound);
+  EXPECT_EQ(&compound.getArgument(0), &otherCompound.getArgument(0));
+  EXPECT_EQ(1, factory.getNumTerms());
+  
+  List list = factory.createList({compound, "b"});
+  Term term = factory.canonicalize(Term({Term("f", {"a", 1}), "b"}));
+  
+  EXPECT_EQ(list, term);
+  EXPECT_EQ(&*list.begin(), &*List(term).begin());
+  EXPECT_EQ(2, factory.getNumTerms());
+  
+  Compound nonGround = factory.createCompound("g", {"X"});
+  
+  EXPECT_EQ(Term("g", {"X"}), nonGround);
+  EXPECT_EQ(2, factory.getNumTerms());
+  
+  *otherCompound.begin() = "c";
+  EXPECT_EQ(Term("f", {"c", 1}), otherCompound);
+  EXPECT_EQ(Term("f", {"a", 1}), compound);
+  EXPECT_EQ(compound, factory.createCompound("f", {"a", 1}));
+  
+  list = List();
+  term = Term();
+  factory.collect();
+  EXPECT_EQ(1, factory.getNumTerms());
+  
+  for (size_t i = 0; i < 4096; ++i)
+    factory.createCompound("h", {(int64_t)i});
+  EXPECT_GT(4096, factory.getNumTerms());
+  
+  Compound negativeZero = factory.createCompound("f", {-0.0});
+  Compound positiveZero = factory.createCompound("f", {0.0});
+  
+  EXPECT_TRUE(std::signbit(Float(negativeZero.getArgument(0)).getValue()));
+  EXPECT_NE(negativeZero, positiveZero);
+  
+  Compound nan = factory.createCompound("f", {
+    std::numeric_limits<double>::quiet_NaN()});
+  size_t numTerms = factory.getNumTerms();
+  
+  EXPECT_EQ(nan, factory.createCompound("f", {
+    std::numeric_limits<double>::quiet_NaN()}));
+  EXPECT_EQ(numTerms, factory.getNumTerms());
+  
+  factory.clear();
+  EXPECT_EQ(0, factory.getNumTerms());
+}